@@ -0,0 +1,92 @@
+// fleet.h - fleet aggregator: polls many controllers on one epoll loop and
+// serves their plants as one API
+//
+// Everything runs on a single thread. Each controller gets a fresh
+// connection per poll, a conditional GET /api/plants.bin with the last
+// ETag, and a deadline covering connect, send and receive. Memory is fixed
+// by the controller count: a response is capped at maxBodyBytes and only
+// the decoded plants are kept.
+#pragma once
+#include <netinet/in.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "plant_cbor.h"
+
+struct FleetConfig {
+    uint16_t listenPort = 8080;
+    uint32_t pollIntervalMs = 10000;
+    uint32_t timeoutMs = 3000;          // per poll, connect to last byte
+    size_t maxBodyBytes = 64 * 1024;    // a 512-plant controller sends ~50 kB
+    size_t maxInFlight = 256;           // polls open at once
+    size_t maxClients = 64;             // API connections open at once
+};
+
+enum PollState : uint8_t {
+    POLL_IDLE,          // waiting for the next poll
+    POLL_CONNECTING,
+    POLL_SENDING,
+    POLL_RECEIVING
+};
+
+struct Controller {
+    std::string name;                   // "host:port" as given
+    std::string host;
+    sockaddr_in address = {};
+
+    // Poll in progress
+    int fd = -1;
+    PollState state = POLL_IDLE;
+    uint64_t deadlineMs = 0;            // next poll while idle, else timeout
+    std::string request;
+    size_t sent = 0;
+    std::vector<uint8_t> response;      // headers and body, up to the cap
+
+    // Last good answer
+    bool hasData = false;
+    std::string etag;
+    plant_cbor::Plants plants;
+    int64_t lastSeen = 0;               // UTC seconds
+
+    // Last attempt
+    bool failing = false;
+    std::string error;
+
+    uint32_t polls = 0;
+    uint32_t changed = 0;               // 200s
+    uint32_t notModified = 0;           // 304s
+    uint32_t failures = 0;
+};
+
+// epoll_event.data.u64 is the kind in the high half and an index below
+enum WatchKind : uint32_t {
+    WATCH_LISTENER = 1,
+    WATCH_CONTROLLER = 2,
+    WATCH_CLIENT = 3
+};
+
+inline uint64_t watchTag(WatchKind kind, uint32_t index) {
+    return (uint64_t)kind << 32 | index;
+}
+
+uint64_t monotonicMs();
+
+// Poller: parses "host:port" into controllers and runs their polls
+bool addController(std::vector<Controller>& controllers, const std::string& spec, std::string& error);
+// Controllers can't be added once polling has begun
+void pollerBegin(std::vector<Controller>& controllers, const FleetConfig& config);
+void pollerEvent(Controller& controller, uint32_t events);
+// Starts due polls and times out late ones; returns ms until it next needs
+// to run
+uint64_t pollerTick(std::vector<Controller>& controllers);
+// Bumped whenever the merged view changes
+uint64_t fleetVersion();
+size_t pollsInFlight();
+
+// API server: GET /api/fleet (merged plants) and /api/fleet/status
+bool serverBegin(const FleetConfig& config, const std::vector<Controller>& controllers, std::string& error);
+void serverListenerEvent();
+void serverClientEvent(uint32_t index, uint32_t events);
+
+extern int epollFd;
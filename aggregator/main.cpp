@@ -0,0 +1,146 @@
+// main.cpp - wmp_aggregator: one API over a fleet of controllers
+//
+// Usage: wmp_aggregator [--listen PORT] [--interval MS] [--timeout MS]
+//                       [--max-body BYTES] [--max-in-flight N]
+//                       [--hosts FILE] [--quiet] [HOST[:PORT] ...]
+//
+// Controllers come from the command line and/or FILE, one per line ('#'
+// starts a comment). Every --interval (default 10 s) each one is asked for
+// GET /api/plants.bin with its last ETag; the merged view is served at
+// http://localhost:PORT/api/fleet (default port 8080). Unless --quiet, a
+// line of poll totals and peak memory goes to stderr every 10 s.
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <fstream>
+#include "fleet.h"
+
+int epollFd = -1;
+
+namespace {
+
+const int MAX_EVENTS = 256;
+const uint64_t REPORT_INTERVAL_MS = 10000;
+
+bool readHostsFile(const char* path, std::vector<std::string>& specs) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos) continue;
+        size_t end = line.find_last_not_of(" \t\r");
+        specs.push_back(line.substr(start, end - start + 1));
+    }
+    return true;
+}
+
+void report(const std::vector<Controller>& controllers) {
+    unsigned long polls = 0, changed = 0, notModified = 0, failures = 0, ok = 0;
+    for (const Controller& controller : controllers) {
+        polls += controller.polls;
+        changed += controller.changed;
+        notModified += controller.notModified;
+        failures += controller.failures;
+        if (controller.hasData && !controller.failing) ok++;
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(stderr, "%lu/%zu controllers ok: %lu polls, %lu changed, %lu not modified, %lu failed; "
+            "%.1f s CPU, %ld KiB peak RSS\n",
+            ok, controllers.size(), polls, changed, notModified, failures,
+            usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6,
+            usage.ru_maxrss);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    FleetConfig config;
+    std::vector<std::string> specs;
+    bool quiet = false;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--listen") && hasValue) {
+            config.listenPort = (uint16_t)atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--interval") && hasValue) {
+            config.pollIntervalMs = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--timeout") && hasValue) {
+            config.timeoutMs = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--max-body") && hasValue) {
+            config.maxBodyBytes = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--max-in-flight") && hasValue) {
+            config.maxInFlight = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--hosts") && hasValue) {
+            if (!readHostsFile(argv[++i], specs)) {
+                fprintf(stderr, "can't read %s\n", argv[i]);
+                return 2;
+            }
+        } else if (!strcmp(argv[i], "--quiet")) {
+            quiet = true;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        } else {
+            specs.push_back(argv[i]);
+        }
+    }
+    if (specs.empty() || config.pollIntervalMs == 0 || config.timeoutMs == 0 || config.maxInFlight == 0) {
+        fprintf(stderr, "usage: %s [--listen PORT] [--interval MS] [--timeout MS] [--max-body BYTES]\n"
+                        "       [--max-in-flight N] [--hosts FILE] [--quiet] HOST[:PORT] ...\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Controller> controllers;
+    controllers.reserve(specs.size());
+    for (const std::string& spec : specs) {
+        std::string error;
+        if (!addController(controllers, spec, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    std::string error;
+    if (!serverBegin(config, controllers, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    pollerBegin(controllers, config);
+    if (!quiet) {
+        fprintf(stderr, "polling %zu controllers every %u ms, serving http://localhost:%u/api/fleet\n",
+                controllers.size(), (unsigned)config.pollIntervalMs, (unsigned)config.listenPort);
+    }
+
+    uint64_t nextReport = monotonicMs() + REPORT_INTERVAL_MS;
+    epoll_event events[MAX_EVENTS];
+    for (;;) {
+        uint64_t wait = pollerTick(controllers);
+        if (!quiet) {
+            uint64_t now = monotonicMs();
+            if (now >= nextReport) {
+                report(controllers);
+                nextReport = now + REPORT_INTERVAL_MS;
+            }
+            if (nextReport - now < wait) wait = nextReport - now;
+        }
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, (int)(wait < 1000 ? wait : 1000));
+        for (int i = 0; i < n; i++) {
+            uint32_t kind = events[i].data.u64 >> 32;
+            uint32_t index = (uint32_t)events[i].data.u64;
+            if (kind == WATCH_LISTENER) {
+                serverListenerEvent();
+            } else if (kind == WATCH_CONTROLLER) {
+                pollerEvent(controllers[index], events[i].events);
+            } else if (kind == WATCH_CLIENT) {
+                serverClientEvent(index, events[i].events);
+            }
+        }
+    }
+}
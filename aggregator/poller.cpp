@@ -0,0 +1,325 @@
+// poller.cpp - polls each controller's GET /api/plants.bin on the shared
+// epoll loop
+#include <errno.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "fleet.h"
+
+namespace {
+
+const FleetConfig* config = nullptr;
+const Controller* controllerBase = nullptr;     // for epoll tags
+uint64_t version = 1;
+size_t inFlight = 0;
+
+// Room for the status line and headers on top of maxBodyBytes
+const size_t HEADER_ALLOWANCE = 4096;
+// How long a poll waits for a free slot once maxInFlight are open
+const uint64_t IN_FLIGHT_RETRY_MS = 50;
+
+// Drops the connection and schedules the next poll. The receive buffer is
+// given back, so only polls in flight hold one.
+void closePoll(Controller& controller) {
+    if (controller.fd >= 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, controller.fd, nullptr);
+        close(controller.fd);
+        controller.fd = -1;
+        inFlight--;
+    }
+    controller.state = POLL_IDLE;
+    controller.sent = 0;
+    std::vector<uint8_t>().swap(controller.response);
+    controller.deadlineMs = monotonicMs() + config->pollIntervalMs;
+}
+
+// Keeps the last good plants, which the API then reports as stale
+void fail(Controller& controller, const std::string& why) {
+    controller.failures++;
+    if (!controller.failing || controller.error != why) version++;
+    controller.failing = true;
+    controller.error = why;
+    closePoll(controller);
+}
+
+void succeed(Controller& controller) {
+    if (controller.failing) version++;
+    controller.failing = false;
+    controller.error.clear();
+    controller.lastSeen = time(nullptr);
+    closePoll(controller);
+}
+
+void startPoll(Controller& controller, uint64_t now) {
+    controller.polls++;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        fail(controller, std::string("socket: ") + strerror(errno));
+        return;
+    }
+    controller.fd = fd;
+    inFlight++;
+    controller.deadlineMs = now + config->timeoutMs;
+    controller.request = "GET /api/plants.bin HTTP/1.1\r\nHost: " + controller.host +
+                         "\r\nAccept: application/cbor\r\nConnection: close\r\n";
+    if (!controller.etag.empty()) controller.request += "If-None-Match: " + controller.etag + "\r\n";
+    controller.request += "\r\n";
+
+    if (connect(fd, (const sockaddr*)&controller.address, sizeof(controller.address)) == 0) {
+        controller.state = POLL_SENDING;
+    } else if (errno == EINPROGRESS) {
+        controller.state = POLL_CONNECTING;
+    } else {
+        fail(controller, std::string("connect: ") + strerror(errno));
+        return;
+    }
+    epoll_event event = {};
+    event.events = EPOLLOUT;
+    event.data.u64 = watchTag(WATCH_CONTROLLER, &controller - controllerBase);
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+}
+
+// Value of header name in the head of a response, or nullptr
+const char* findHeader(const std::string& head, const char* name, size_t& length) {
+    size_t nameLen = strlen(name);
+    for (size_t line = head.find("\r\n"); line != std::string::npos; line = head.find("\r\n", line + 2)) {
+        size_t start = line + 2;
+        if (strncasecmp(head.c_str() + start, name, nameLen) != 0) continue;
+        if (head.size() <= start + nameLen || head[start + nameLen] != ':') continue;
+        size_t value = start + nameLen + 1;
+        while (value < head.size() && head[value] == ' ') value++;
+        size_t end = head.find("\r\n", value);
+        length = (end == std::string::npos ? head.size() : end) - value;
+        return head.c_str() + value;
+    }
+    return nullptr;
+}
+
+// Undoes chunked transfer coding into out; false if it is malformed
+bool dechunk(const uint8_t* data, size_t len, std::vector<uint8_t>& out) {
+    size_t at = 0;
+    for (;;) {
+        char* end;
+        std::string line;
+        while (at < len && data[at] != '\r') line += (char)data[at++];
+        if (at + 1 >= len || data[at + 1] != '\n') return false;
+        at += 2;
+        unsigned long size = strtoul(line.c_str(), &end, 16);
+        if (end == line.c_str()) return false;
+        if (size == 0) return true;
+        if (size > len - at || len - at - size < 2) return false;
+        out.insert(out.end(), data + at, data + at + size);
+        at += size + 2;
+    }
+}
+
+// The whole response has arrived, or the server closed the connection
+void finishPoll(Controller& controller) {
+    const std::vector<uint8_t>& response = controller.response;
+    const uint8_t* headEnd = (const uint8_t*)memmem(response.data(), response.size(), "\r\n\r\n", 4);
+    if (!headEnd) {
+        fail(controller, response.empty() ? "connection closed" : "truncated response");
+        return;
+    }
+    std::string head(response.begin(), response.begin() + (headEnd - response.data()));
+    int status = 0;
+    if (sscanf(head.c_str(), "HTTP/1.%*d %d", &status) != 1) {
+        fail(controller, "not an HTTP response");
+        return;
+    }
+    if (status == 304) {
+        controller.notModified++;
+        succeed(controller);
+        return;
+    }
+    if (status != 200) {
+        fail(controller, "HTTP " + std::to_string(status));
+        return;
+    }
+
+    const uint8_t* body = headEnd + 4;
+    size_t bodyLen = response.data() + response.size() - body;
+    size_t length;
+    std::vector<uint8_t> dechunked;
+    const char* coding = findHeader(head, "Transfer-Encoding", length);
+    if (coding && strncasecmp(coding, "chunked", 7) == 0) {
+        if (!dechunk(body, bodyLen, dechunked)) {
+            fail(controller, "bad chunked body");
+            return;
+        }
+        body = dechunked.data();
+        bodyLen = dechunked.size();
+    } else if (const char* contentLength = findHeader(head, "Content-Length", length)) {
+        size_t expected = strtoull(contentLength, nullptr, 10);
+        if (bodyLen < expected) {
+            fail(controller, "truncated body");
+            return;
+        }
+        bodyLen = expected;
+    }
+
+    plant_cbor::Plants plants;
+    std::string error;
+    if (!plant_cbor::decodePlants(body, bodyLen, plants, &error)) {
+        fail(controller, "bad body: " + error);
+        return;
+    }
+    const char* etag = findHeader(head, "ETag", length);
+    controller.etag = etag ? std::string(etag, length) : std::string();
+    controller.plants = std::move(plants);
+    controller.hasData = true;
+    controller.changed++;
+    version++;
+    succeed(controller);
+}
+
+// Whether the bytes so far already hold the whole response, so the poll
+// needn't wait for the server to close
+bool responseComplete(const std::vector<uint8_t>& response) {
+    const uint8_t* headEnd = (const uint8_t*)memmem(response.data(), response.size(), "\r\n\r\n", 4);
+    if (!headEnd) return false;
+    std::string head(response.begin(), response.begin() + (headEnd - response.data()));
+    size_t bodyLen = response.data() + response.size() - (headEnd + 4);
+    size_t length;
+    const char* coding = findHeader(head, "Transfer-Encoding", length);
+    if (coding && strncasecmp(coding, "chunked", 7) == 0) {
+        return bodyLen >= 5 && memcmp(response.data() + response.size() - 5, "0\r\n\r\n", 5) == 0;
+    }
+    if (const char* contentLength = findHeader(head, "Content-Length", length)) {
+        return bodyLen >= strtoull(contentLength, nullptr, 10);
+    }
+    return head.size() >= 12 && head.compare(9, 3, "304") == 0;
+}
+
+void receive(Controller& controller) {
+    uint8_t buffer[16384];
+    for (;;) {
+        ssize_t n = recv(controller.fd, buffer, sizeof(buffer), 0);
+        if (n == 0) {
+            finishPoll(controller);
+            return;
+        }
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            fail(controller, std::string("recv: ") + strerror(errno));
+            return;
+        }
+        if (controller.response.size() + n > config->maxBodyBytes + HEADER_ALLOWANCE) {
+            fail(controller, "response too large");
+            return;
+        }
+        controller.response.insert(controller.response.end(), buffer, buffer + n);
+    }
+    if (responseComplete(controller.response)) finishPoll(controller);
+}
+
+}  // namespace
+
+uint64_t monotonicMs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+uint64_t fleetVersion() {
+    return version;
+}
+
+size_t pollsInFlight() {
+    return inFlight;
+}
+
+bool addController(std::vector<Controller>& controllers, const std::string& spec, std::string& error) {
+    Controller controller;
+    controller.name = spec;
+    size_t colon = spec.rfind(':');
+    controller.host = spec.substr(0, colon);
+    long port = colon == std::string::npos ? 80 : strtol(spec.c_str() + colon + 1, nullptr, 10);
+    if (controller.host.empty() || port <= 0 || port > 65535) {
+        error = spec + ": expected host or host:port";
+        return false;
+    }
+
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    int result = getaddrinfo(controller.host.c_str(), nullptr, &hints, &found);
+    if (result != 0) {
+        error = spec + ": " + gai_strerror(result);
+        return false;
+    }
+    controller.address = *(const sockaddr_in*)found->ai_addr;
+    controller.address.sin_port = htons((uint16_t)port);
+    freeaddrinfo(found);
+    controllers.push_back(std::move(controller));
+    return true;
+}
+
+// First polls are spread over one interval so they don't all land at once
+void pollerBegin(std::vector<Controller>& controllers, const FleetConfig& fleetConfig) {
+    config = &fleetConfig;
+    controllerBase = controllers.data();
+    uint64_t now = monotonicMs();
+    for (size_t i = 0; i < controllers.size(); i++) {
+        controllers[i].deadlineMs = now + i * fleetConfig.pollIntervalMs / controllers.size();
+    }
+}
+
+void pollerEvent(Controller& controller, uint32_t events) {
+    if (controller.state == POLL_CONNECTING) {
+        int error = 0;
+        socklen_t len = sizeof(error);
+        getsockopt(controller.fd, SOL_SOCKET, SO_ERROR, &error, &len);
+        if (error) {
+            fail(controller, std::string("connect: ") + strerror(error));
+            return;
+        }
+        controller.state = POLL_SENDING;
+    }
+    if (controller.state == POLL_SENDING) {
+        while (controller.sent < controller.request.size()) {
+            ssize_t n = send(controller.fd, controller.request.data() + controller.sent,
+                             controller.request.size() - controller.sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+                fail(controller, std::string("send: ") + strerror(errno));
+                return;
+            }
+            controller.sent += n;
+        }
+        controller.state = POLL_RECEIVING;
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = watchTag(WATCH_CONTROLLER, &controller - controllerBase);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, controller.fd, &event);
+        return;
+    }
+    if (controller.state == POLL_RECEIVING && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+        receive(controller);
+    }
+}
+
+uint64_t pollerTick(std::vector<Controller>& controllers) {
+    uint64_t now = monotonicMs();
+    uint64_t next = UINT64_MAX;
+    for (Controller& controller : controllers) {
+        if (controller.state != POLL_IDLE && now >= controller.deadlineMs) {
+            fail(controller, "timed out");
+        } else if (controller.state == POLL_IDLE && now >= controller.deadlineMs) {
+            if (inFlight < config->maxInFlight) {
+                startPoll(controller, now);
+            } else {
+                controller.deadlineMs = now + IN_FLIGHT_RETRY_MS;
+            }
+        }
+        if (controller.deadlineMs < next) next = controller.deadlineMs;
+    }
+    return next > now ? next - now : 0;
+}
@@ -0,0 +1,337 @@
+// server.cpp - the aggregator's own API, on the same epoll loop
+//
+// GET /api/fleet         every controller's plants, merged; ETag is the
+//                        fleet version, so unchanged polls cost a 304
+// GET /api/fleet/status  poll counters and last errors per controller
+//
+// One request per connection. The merged response is rendered once per
+// fleet version and shared by every client sending it, so memory doesn't
+// grow with the number of readers.
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <memory>
+#include "fleet.h"
+
+namespace {
+
+// Requests are a line and a few headers; anything longer is refused
+const size_t MAX_REQUEST_BYTES = 8192;
+
+typedef std::shared_ptr<const std::string> Response;
+
+struct Client {
+    int fd = -1;
+    std::string in;
+    Response out;
+    size_t sent = 0;
+};
+
+const std::vector<Controller>* controllers = nullptr;
+int listenFd = -1;
+std::vector<Client> clients;
+
+Response fleetResponse;
+uint64_t fleetResponseVersion = 0;
+
+void appendString(std::string& out, const std::string& s) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c < 0x20) {
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xF];
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(std::string& out, long long value) {
+    out += std::to_string(value);
+}
+
+// Two decimals, like the controllers' own JSON
+void appendOz(std::string& out, float value) {
+    if (isnan(value) || isinf(value)) {
+        out += "null";
+        return;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.2f", value);
+    out += buf;
+}
+
+const char* controllerStatus(const Controller& controller) {
+    if (controller.hasData) return controller.failing ? "stale" : "ok";
+    return controller.failing ? "down" : "pending";
+}
+
+void appendPlant(std::string& out, const plant_cbor::Plant& plant, size_t index) {
+    static const char* const pumpStates[] = {"idle", "waiting", "running"};
+    static const char* const windows[] = {"24h", "7d", "30d", "lifetime"};
+    out += "{\"index\":";
+    appendNumber(out, index);
+    out += ",\"name\":";
+    appendString(out, plant.name);
+    out += ",\"ozPerWatering\":";
+    appendOz(out, plant.ozPerWatering);
+    out += ",\"intervalMinutes\":";
+    appendNumber(out, plant.intervalMinutes);
+    out += plant.needsWatering ? ",\"needsWatering\":true" : ",\"needsWatering\":false";
+    out += ",\"pumpState\":\"";
+    out += plant.pumpState <= plant_cbor::PUMP_RUNNING ? pumpStates[plant.pumpState] : "unknown";
+    out += "\",\"lastWatered\":";
+    int64_t lastWatered = plant.history.empty() ? 0 : plant.history[0].timestamp;
+    if (lastWatered) {
+        appendNumber(out, lastWatered);
+    } else {
+        out += "null";
+    }
+    out += ",\"usage\":{";
+    for (int w = 0; w < plant_cbor::USAGE_WINDOWS; w++) {
+        if (w) out += ',';
+        out += '"';
+        out += windows[w];
+        out += "\":{\"waterings\":";
+        appendNumber(out, plant.usage[w].waterings);
+        out += ",\"oz\":";
+        appendOz(out, plant.usage[w].oz);
+        out += '}';
+    }
+    out += "}}";
+}
+
+// {"version":7,"controllers":[{"name":"10.0.0.5:80","status":"ok",
+// "error":null,"plants":[...]}, ...]}
+std::string renderFleet() {
+    std::string out = "{\"version\":";
+    appendNumber(out, fleetVersion());
+    out += ",\"controllers\":[";
+    for (size_t c = 0; c < controllers->size(); c++) {
+        const Controller& controller = (*controllers)[c];
+        if (c) out += ',';
+        out += "{\"name\":";
+        appendString(out, controller.name);
+        out += ",\"status\":\"";
+        out += controllerStatus(controller);
+        out += "\",\"error\":";
+        if (controller.failing) {
+            appendString(out, controller.error);
+        } else {
+            out += "null";
+        }
+        out += ",\"plants\":[";
+        bool first = true;
+        for (size_t i = 0; i < controller.plants.plants.size(); i++) {
+            const plant_cbor::Plant& plant = controller.plants.plants[i];
+            if (!plant.present) continue;
+            if (!first) out += ',';
+            first = false;
+            appendPlant(out, plant, i);
+        }
+        out += "]}";
+    }
+    out += "]}";
+    return out;
+}
+
+std::string renderStatus() {
+    static const char* const states[] = {"idle", "connecting", "sending", "receiving"};
+    std::string out = "{\"version\":";
+    appendNumber(out, fleetVersion());
+    out += ",\"pollsInFlight\":";
+    appendNumber(out, pollsInFlight());
+    out += ",\"controllers\":[";
+    for (size_t c = 0; c < controllers->size(); c++) {
+        const Controller& controller = (*controllers)[c];
+        if (c) out += ',';
+        out += "{\"name\":";
+        appendString(out, controller.name);
+        out += ",\"status\":\"";
+        out += controllerStatus(controller);
+        out += "\",\"poll\":\"";
+        out += states[controller.state];
+        out += "\",\"lastSeen\":";
+        if (controller.lastSeen) {
+            appendNumber(out, controller.lastSeen);
+        } else {
+            out += "null";
+        }
+        out += ",\"polls\":";
+        appendNumber(out, controller.polls);
+        out += ",\"changed\":";
+        appendNumber(out, controller.changed);
+        out += ",\"notModified\":";
+        appendNumber(out, controller.notModified);
+        out += ",\"failures\":";
+        appendNumber(out, controller.failures);
+        out += ",\"error\":";
+        if (controller.failing) {
+            appendString(out, controller.error);
+        } else {
+            out += "null";
+        }
+        out += '}';
+    }
+    out += "]}";
+    return out;
+}
+
+Response response(int status, const char* reason, const char* extraHeaders, const std::string& body) {
+    char head[256];
+    snprintf(head, sizeof(head),
+             "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n"
+             "Access-Control-Allow-Origin: *\r\nConnection: close\r\n%s\r\n",
+             status, reason, body.size(), extraHeaders);
+    return std::make_shared<const std::string>(head + body);
+}
+
+Response handleRequest(const std::string& request) {
+    char method[8], path[256];
+    if (sscanf(request.c_str(), "%7s %255s", method, path) != 2) {
+        return response(400, "Bad Request", "", "{\"error\":\"Bad request\"}");
+    }
+    if (strcmp(method, "GET") != 0) {
+        return response(405, "Method Not Allowed", "Allow: GET\r\n", "{\"error\":\"Method not allowed\"}");
+    }
+    if (strcmp(path, "/api/fleet/status") == 0) {
+        return response(200, "OK", "Cache-Control: no-cache\r\n", renderStatus());
+    }
+    if (strcmp(path, "/api/fleet") != 0) {
+        return response(404, "Not Found", "", "{\"error\":\"Not found\"}");
+    }
+
+    char etag[48];
+    snprintf(etag, sizeof(etag), "\"fleet-%llu\"", (unsigned long long)fleetVersion());
+    char headers[96];
+    snprintf(headers, sizeof(headers), "ETag: %s\r\nCache-Control: no-cache\r\n", etag);
+    for (size_t line = request.find("\r\n"); line != std::string::npos; line = request.find("\r\n", line + 2)) {
+        if (strncasecmp(request.c_str() + line + 2, "If-None-Match:", 14) != 0) continue;
+        size_t end = request.find("\r\n", line + 2);
+        if (request.substr(line + 16, end - line - 16).find(etag) != std::string::npos) {
+            return response(304, "Not Modified", headers, "");
+        }
+    }
+    if (!fleetResponse || fleetResponseVersion != fleetVersion()) {
+        fleetResponse = response(200, "OK", headers, renderFleet());
+        fleetResponseVersion = fleetVersion();
+    }
+    return fleetResponse;
+}
+
+void closeClient(Client& client) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+    close(client.fd);
+    client.fd = -1;
+    std::string().swap(client.in);
+    client.out.reset();
+    client.sent = 0;
+}
+
+// Sends what it can; the rest goes on EPOLLOUT
+void flushClient(Client& client) {
+    const std::string& out = *client.out;
+    while (client.sent < out.size()) {
+        ssize_t n = send(client.fd, out.data() + client.sent, out.size() - client.sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            closeClient(client);
+            return;
+        }
+        client.sent += n;
+    }
+    closeClient(client);
+}
+
+}  // namespace
+
+bool serverBegin(const FleetConfig& config, const std::vector<Controller>& fleet, std::string& error) {
+    controllers = &fleet;
+    clients.resize(config.maxClients);
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int on = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.listenPort);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listenFd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 128) != 0) {
+        error = std::string("listen on port ") + std::to_string(config.listenPort) + ": " + strerror(errno);
+        return false;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = watchTag(WATCH_LISTENER, 0);
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    return true;
+}
+
+void serverListenerEvent() {
+    for (;;) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        size_t slot = 0;
+        while (slot < clients.size() && clients[slot].fd >= 0) slot++;
+        if (slot == clients.size()) {
+            // Every slot busy: a best-effort 503 rather than a queue
+            Response busy = response(503, "Service Unavailable", "Retry-After: 1\r\n", "{\"error\":\"Busy\"}");
+            send(fd, busy->data(), busy->size(), MSG_NOSIGNAL);
+            close(fd);
+            continue;
+        }
+        clients[slot].fd = fd;
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = watchTag(WATCH_CLIENT, slot);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void serverClientEvent(uint32_t index, uint32_t events) {
+    Client& client = clients[index];
+    if (client.fd < 0) return;
+    if (client.out) {
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            closeClient(client);
+        } else {
+            flushClient(client);
+        }
+        return;
+    }
+
+    char buffer[2048];
+    for (;;) {
+        ssize_t n = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            closeClient(client);
+            return;
+        }
+        if (n < 0) break;
+        client.in.append(buffer, n);
+        if (client.in.size() > MAX_REQUEST_BYTES) {
+            client.out = response(431, "Request Header Fields Too Large", "", "{\"error\":\"Request too large\"}");
+            break;
+        }
+    }
+    if (!client.out) {
+        if (client.in.find("\r\n\r\n") == std::string::npos) return;
+        client.out = handleRequest(client.in);
+    }
+    epoll_event event = {};
+    event.events = EPOLLOUT;
+    event.data.u64 = watchTag(WATCH_CLIENT, index);
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &event);
+    flushClient(client);
+}
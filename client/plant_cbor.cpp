@@ -0,0 +1,229 @@
+// plant_cbor.cpp - decoder for the CBOR body of GET /api/plants
+#include "plant_cbor.h"
+#include <math.h>
+
+namespace plant_cbor {
+
+namespace {
+
+const uint8_t MAJOR_UNSIGNED = 0;
+const uint8_t MAJOR_NEGATIVE = 1;
+const uint8_t MAJOR_BYTES = 2;
+const uint8_t MAJOR_TEXT = 3;
+const uint8_t MAJOR_ARRAY = 4;
+const uint8_t MAJOR_MAP = 5;
+const uint8_t MAJOR_TAG = 6;
+const uint8_t CBOR_FALSE = 0xf4;
+const uint8_t CBOR_TRUE = 0xf5;
+const uint8_t CBOR_NULL = 0xf6;
+
+// Nesting allowed in fields being skipped
+const int MAX_SKIP_DEPTH = 16;
+
+// Cursor over the body. The first failure sticks: it empties the input so
+// every later read fails too, and the caller only checks at the end.
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    const char* error = nullptr;
+
+    bool fail(const char* why) {
+        if (!error) error = why;
+        p = end;
+        return false;
+    }
+
+    size_t remaining() const {
+        return end - p;
+    }
+
+    bool peek(uint8_t b) const {
+        return p < end && *p == b;
+    }
+
+    // Initial byte and argument of the next item
+    bool head(uint8_t& major, uint64_t& arg) {
+        if (p >= end) return fail("truncated");
+        uint8_t initial = *p++;
+        major = initial >> 5;
+        uint8_t info = initial & 0x1f;
+        if (info < 24) {
+            arg = info;
+            return true;
+        }
+        if (info > 27) return fail(info == 31 ? "indefinite length not supported" : "reserved initial byte");
+        size_t bytes = (size_t)1 << (info - 24);
+        if (remaining() < bytes) return fail("truncated");
+        arg = 0;
+        for (size_t i = 0; i < bytes; i++) arg = arg << 8 | *p++;
+        return true;
+    }
+
+    bool integer(int64_t& value) {
+        uint8_t major;
+        uint64_t arg;
+        if (!head(major, arg)) return false;
+        if ((major != MAJOR_UNSIGNED && major != MAJOR_NEGATIVE) || arg > (uint64_t)INT64_MAX) {
+            return fail("expected an integer");
+        }
+        value = major == MAJOR_UNSIGNED ? (int64_t)arg : -1 - (int64_t)arg;
+        return true;
+    }
+
+    bool unsignedInt(uint64_t& value) {
+        int64_t v;
+        if (!integer(v)) return false;
+        if (v < 0) return fail("expected an unsigned integer");
+        value = v;
+        return true;
+    }
+
+    // Hundredths of an ounce, or null
+    bool oz(float& value) {
+        if (peek(CBOR_NULL)) {
+            p++;
+            value = NAN;
+            return true;
+        }
+        int64_t centi;
+        if (!integer(centi)) return false;
+        value = centi / 100.0f;
+        return true;
+    }
+
+    bool boolean(bool& value) {
+        if (p >= end || (*p != CBOR_FALSE && *p != CBOR_TRUE)) return fail("expected a boolean");
+        value = *p++ == CBOR_TRUE;
+        return true;
+    }
+
+    bool text(std::string& value) {
+        uint8_t major;
+        uint64_t len;
+        if (!head(major, len)) return false;
+        if (major != MAJOR_TEXT) return fail("expected a text string");
+        if (len > remaining()) return fail("truncated");
+        value.assign((const char*)p, len);
+        p += len;
+        return true;
+    }
+
+    // An array of at least minCount items; count is what it declares
+    bool array(uint64_t& count, uint64_t minCount) {
+        uint8_t major;
+        if (!head(major, count)) return false;
+        if (major != MAJOR_ARRAY) return fail("expected an array");
+        if (count < minCount) return fail("array too short");
+        // Every item takes at least a byte
+        if (count > remaining()) return fail("truncated");
+        return true;
+    }
+
+    // Steps over one item of any type
+    bool skip(int depth = 0) {
+        if (depth > MAX_SKIP_DEPTH) return fail("nested too deeply");
+        uint8_t major;
+        uint64_t arg;
+        if (!head(major, arg)) return false;
+        switch (major) {
+        case MAJOR_BYTES:
+        case MAJOR_TEXT:
+            if (arg > remaining()) return fail("truncated");
+            p += arg;
+            return true;
+        case MAJOR_ARRAY:
+        case MAJOR_MAP:
+            if (arg > remaining()) return fail("truncated");
+            for (uint64_t i = 0; i < (major == MAJOR_MAP ? arg * 2 : arg); i++) {
+                if (!skip(depth + 1)) return false;
+            }
+            return true;
+        case MAJOR_TAG:
+            return skip(depth + 1);
+        default:
+            // Integers and simple values are all head
+            return true;
+        }
+    }
+
+    // Skips the fields of an array past the ones this decoder knows
+    bool skipRest(uint64_t count, uint64_t known) {
+        for (uint64_t i = known; i < count; i++) {
+            if (!skip()) return false;
+        }
+        return true;
+    }
+};
+
+bool decodeWatering(Reader& in, Watering& watering) {
+    uint64_t fields;
+    return in.array(fields, 2) && in.integer(watering.timestamp) && in.oz(watering.oz) &&
+           in.skipRest(fields, 2);
+}
+
+bool decodeUsage(Reader& in, Usage& usage) {
+    uint64_t fields, waterings, meanInterval;
+    if (!in.array(fields, 3) || !in.unsignedInt(waterings) || !in.oz(usage.oz) ||
+        !in.unsignedInt(meanInterval)) {
+        return false;
+    }
+    usage.waterings = (uint32_t)waterings;
+    usage.meanIntervalMinutes = (uint32_t)meanInterval;
+    return in.skipRest(fields, 3);
+}
+
+bool decodePlant(Reader& in, Plant& plant) {
+    if (in.peek(CBOR_NULL)) {
+        in.p++;
+        return true;
+    }
+    uint64_t fields;
+    int64_t state;
+    if (!in.array(fields, 8) || !in.text(plant.name) || !in.oz(plant.ozPerWatering) ||
+        !in.integer(plant.intervalMinutes) || !in.integer(state) || !in.integer(plant.waitingSince) ||
+        !in.boolean(plant.needsWatering)) {
+        return false;
+    }
+    plant.pumpState = (PumpState)state;
+
+    uint64_t count;
+    if (!in.array(count, 0)) return false;
+    for (uint64_t h = 0; h < count; h++) {
+        plant.history.emplace_back();
+        if (!decodeWatering(in, plant.history.back())) return false;
+    }
+
+    if (!in.array(count, 0)) return false;
+    for (uint64_t w = 0; w < count; w++) {
+        bool ok = w < USAGE_WINDOWS ? decodeUsage(in, plant.usage[w]) : in.skip();
+        if (!ok) return false;
+    }
+
+    plant.present = true;
+    return in.skipRest(fields, 8);
+}
+
+}  // namespace
+
+bool decodePlants(const uint8_t* data, size_t len, Plants& out, std::string* error) {
+    Reader in = {data, data + len};
+    out = Plants();
+    uint64_t fields = 0, schema = 0, count = 0;
+    if (in.array(fields, 4) && in.unsignedInt(schema)) {
+        out.schema = (uint32_t)schema;
+        if (schema < SCHEMA) in.fail("unsupported schema");
+    }
+    if (in.unsignedInt(out.stateVersion) && in.integer(out.now) && in.array(count, 0)) {
+        // Grown as plants arrive rather than trusting the declared count
+        for (uint64_t i = 0; i < count; i++) {
+            out.plants.emplace_back();
+            if (!decodePlant(in, out.plants.back())) break;
+        }
+    }
+    in.skipRest(fields, 4);
+    if (!in.error && in.p != in.end) in.fail("trailing bytes");
+    if (in.error && error) *error = in.error;
+    return !in.error;
+}
+
+}  // namespace plant_cbor
@@ -0,0 +1,67 @@
+// plant_cbor.h - decoder for the CBOR body of GET /api/plants
+//
+// For scrapers and other machine clients: fetch /api/plants.bin, or
+// /api/plants with "Accept: application/cbor", and hand the body to
+// decodePlants(). Plain C++17, no dependencies beyond the standard
+// library. The layout is documented in water_my_plants/plant_cbor.cpp;
+// fields a newer controller appends are skipped.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace plant_cbor {
+
+// Schema this decoder was written against; later ones only add fields
+const uint32_t SCHEMA = 1;
+
+enum PumpState : uint8_t {
+    PUMP_IDLE = 0,
+    PUMP_WAITING = 1,
+    PUMP_RUNNING = 2
+};
+
+struct Watering {
+    int64_t timestamp;              // UTC seconds, 0 for an empty slot
+    float oz;                       // NAN if the controller sent null
+};
+
+struct Usage {
+    uint32_t waterings;
+    float oz;
+    uint32_t meanIntervalMinutes;   // 0 if there were no waterings
+};
+
+enum UsageWindow {
+    USAGE_24H,
+    USAGE_7D,
+    USAGE_30D,
+    USAGE_LIFETIME,
+    USAGE_WINDOWS
+};
+
+struct Plant {
+    bool present = false;           // false if the controller sent null
+    std::string name;
+    float ozPerWatering = 0;
+    int64_t intervalMinutes = 0;
+    PumpState pumpState = PUMP_IDLE;
+    int64_t waitingSince = 0;       // UTC seconds while waiting, else 0
+    bool needsWatering = false;
+    std::vector<Watering> history;  // newest first
+    Usage usage[USAGE_WINDOWS] = {};
+};
+
+struct Plants {
+    uint32_t schema = 0;
+    uint64_t stateVersion = 0;      // as in the ETag
+    int64_t now = 0;                // controller's UTC seconds
+    std::vector<Plant> plants;      // by plant index
+};
+
+// Decodes a whole body into out. Returns false with a reason in error (if
+// given) on malformed input or an older, incompatible schema.
+bool decodePlants(const uint8_t* data, size_t len, Plants& out, std::string* error = nullptr);
+
+}  // namespace plant_cbor
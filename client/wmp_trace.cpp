@@ -0,0 +1,329 @@
+// wmp_trace.cpp - timeline from a controller's flight recorder
+//
+// Usage: wmp_trace [--plant N] [FILE|-]
+//
+// FILE is a download of GET /api/trace (standard input by default), e.g.
+//   curl -s http://plants.local/api/trace | wmp_trace
+// One line per event, oldest first. Times are UTC to the microsecond once
+// the controller has synced its clock in that boot, otherwise seconds
+// since the boot. Each pump stop shows how long the pump actually ran
+// against the run time it was started with. --plant N keeps boots and the
+// events of plant (and pump) N.
+//
+// Plain C++17, no dependencies beyond the standard library. The layout is
+// documented in water_my_plants/trace.cpp; the event numbers below follow
+// TraceType in water_my_plants.h.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Format version this decoder was written against
+const uint16_t FORMAT_VERSION = 1;
+const size_t HEADER_SIZE = 32;
+
+enum EventType : uint8_t {
+    BOOT = 1,
+    PUMP_ON = 2,
+    PUMP_OFF = 3,
+    NEEDS_WATERING = 4,
+    WATERED = 5,
+    EEPROM_COMMIT = 6,
+    WIFI = 7,
+    NTP_START = 8,
+    TIME_SYNC = 9,
+    COMMAND_QUEUED = 10,
+    COMMAND_APPLIED = 11
+};
+
+// CommandType of a batch edit, whose subject is its size
+const uint8_t COMMAND_BATCH = 4;
+
+struct Event {
+    uint32_t boot;          // boot count, 0 if it came before the first boot marker kept
+    int64_t micros;         // since that boot
+    uint8_t type;
+    uint8_t detail;
+    uint16_t subject;
+    uint16_t position;
+    uint32_t arg;
+};
+
+// Where a boot's esp_timer time was known to be a UTC time
+struct Anchor {
+    int64_t micros;
+    int64_t utcMicros;
+};
+
+uint16_t le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+uint32_t le32(const uint8_t* p) {
+    return le16(p) | (uint32_t)le16(p + 2) << 16;
+}
+
+const char* name(const char* const* names, size_t count, unsigned value) {
+    return value < count ? names[value] : "?";
+}
+
+const char* resetReasonName(unsigned reason) {
+    static const char* const names[] = {"unknown", "power-on", "external pin", "software restart",
+                                        "panic", "interrupt watchdog", "task watchdog", "watchdog",
+                                        "deep sleep", "brownout", "SDIO"};
+    return name(names, sizeof(names) / sizeof(names[0]), reason);
+}
+
+const char* commandName(unsigned type) {
+    static const char* const names[] = {"water-now", "set amount", "set interval", "set name", "batch"};
+    return name(names, sizeof(names) / sizeof(names[0]), type);
+}
+
+const char* sourceName(unsigned source) {
+    static const char* const names[] = {"scheduled", "manual"};
+    return name(names, sizeof(names) / sizeof(names[0]), source);
+}
+
+const char* wifiName(unsigned detail) {
+    static const char* const names[] = {"connected", "disconnected", "connect failed", "connect timed out"};
+    return name(names, sizeof(names) / sizeof(names[0]), detail);
+}
+
+bool readAll(FILE* in, std::vector<uint8_t>& data) {
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) data.insert(data.end(), buffer, buffer + n);
+    return !ferror(in);
+}
+
+std::string formatTime(const Event& event, const std::map<uint32_t, std::vector<Anchor>>& anchors) {
+    char text[48];
+    auto found = anchors.find(event.boot);
+    if (found == anchors.end()) {
+        snprintf(text, sizeof(text), "boot+%lld.%06llds", (long long)(event.micros / 1000000),
+                 (long long)(event.micros % 1000000));
+        return text;
+    }
+    // The latest sync at or before the event, or the first one after it
+    const std::vector<Anchor>& syncs = found->second;
+    const Anchor* anchor = &syncs.front();
+    for (const Anchor& sync : syncs) {
+        if (sync.micros <= event.micros) anchor = &sync;
+    }
+    int64_t utcMicros = anchor->utcMicros + (event.micros - anchor->micros);
+    time_t seconds = (time_t)(utcMicros / 1000000);
+    struct tm timeinfo;
+    gmtime_r(&seconds, &timeinfo);
+    size_t len = strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S", &timeinfo);
+    snprintf(text + len, sizeof(text) - len, ".%06lldZ", (long long)(utcMicros % 1000000));
+    return text;
+}
+
+bool concernsPlant(const Event& event, int plant) {
+    switch (event.type) {
+        case BOOT:
+            return true;
+        case PUMP_ON:
+        case PUMP_OFF:
+        case NEEDS_WATERING:
+        case WATERED:
+            return event.subject == plant;
+        case COMMAND_QUEUED:
+        case COMMAND_APPLIED:
+            // A batch's subject is its size, so it might touch any plant
+            return event.detail == COMMAND_BATCH || event.subject == plant;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int plant = -1;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--plant") && i + 1 < argc) {
+            plant = atoi(argv[++i]);
+        } else if (argv[i][0] == '-' && strcmp(argv[i], "-")) {
+            fprintf(stderr, "usage: wmp_trace [--plant N] [FILE|-]\n");
+            return 2;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    FILE* in = path && strcmp(path, "-") ? fopen(path, "rb") : stdin;
+    if (!in) {
+        fprintf(stderr, "can't open %s\n", path);
+        return 1;
+    }
+    std::vector<uint8_t> data;
+    bool ok = readAll(in, data);
+    if (in != stdin) fclose(in);
+    if (!ok) {
+        fprintf(stderr, "can't read %s\n", path ? path : "standard input");
+        return 1;
+    }
+
+    if (data.size() < HEADER_SIZE || memcmp(data.data(), "WMPT", 4)) {
+        fprintf(stderr, "not a flight recorder download\n");
+        return 1;
+    }
+    const uint8_t* header = data.data();
+    uint16_t version = le16(header + 4);
+    uint16_t eventSize = le16(header + 6);
+    if (version != FORMAT_VERSION || eventSize < 16) {
+        fprintf(stderr, "unsupported trace format %u (event size %u)\n", version, eventSize);
+        return 1;
+    }
+    uint32_t bootCount = le32(header + 8);
+    uint32_t firstPosition = le32(header + 12);
+    int64_t nowMicros = (int64_t)((uint64_t)le32(header + 16) | (uint64_t)le32(header + 20) << 32);
+    uint32_t nowUtc = le32(header + 24);
+    uint16_t nowMillis = le16(header + 28);
+
+    // Events up to the first boot marker belong to the boot before it; if
+    // there is none, they are all from the current one
+    std::vector<Event> events;
+    uint32_t boot = 0;
+    for (size_t offset = HEADER_SIZE; offset + eventSize <= data.size(); offset += eventSize) {
+        const uint8_t* p = data.data() + offset;
+        Event event;
+        event.micros = (int64_t)((uint64_t)le32(p) | (uint64_t)le16(p + 4) << 32);
+        event.type = p[6];
+        event.detail = p[7];
+        event.subject = le16(p + 8);
+        event.position = le16(p + 10);
+        event.arg = le32(p + 12);
+        if (event.type == BOOT) boot = event.arg;
+        event.boot = boot;
+        events.push_back(event);
+    }
+    uint32_t firstBoot = bootCount;
+    for (const Event& event : events) {
+        if (event.type == BOOT) {
+            firstBoot = event.arg - 1;
+            break;
+        }
+    }
+    for (Event& event : events) {
+        if (event.boot == 0) event.boot = firstBoot;
+    }
+
+    std::map<uint32_t, std::vector<Anchor>> anchors;
+    for (const Event& event : events) {
+        if (event.type == TIME_SYNC) {
+            anchors[event.boot].push_back({event.micros, (int64_t)event.arg * 1000000 + event.subject * 1000});
+        }
+    }
+    // Without a sync in this boot, the download's own clock reading will do
+    if (nowUtc && !anchors.count(bootCount)) {
+        anchors[bootCount].push_back({nowMicros, (int64_t)nowUtc * 1000000 + nowMillis * 1000});
+    }
+
+    Event now = {bootCount, nowMicros, 0, 0, 0, 0, 0};
+    printf("Boot %u, %zu events, downloaded at %s\n", bootCount, events.size(), formatTime(now, anchors).c_str());
+
+    // Start of each pump's current run, with the run time it was given
+    std::map<std::pair<uint32_t, uint16_t>, std::pair<int64_t, uint32_t>> running;
+    uint16_t expected = (uint16_t)firstPosition;
+    unsigned long lost = 0;
+    for (const Event& event : events) {
+        if (event.position != expected) {
+            uint16_t missing = (uint16_t)(event.position - expected);
+            printf("  ... %u events lost\n", missing);
+            lost += missing;
+        }
+        expected = (uint16_t)(event.position + 1);
+
+        char text[160];
+        switch (event.type) {
+            case BOOT:
+                snprintf(text, sizeof(text), "boot %u (%s)", event.arg, resetReasonName(event.detail));
+                break;
+            case PUMP_ON:
+                running[{event.boot, event.subject}] = {event.micros, event.arg};
+                snprintf(text, sizeof(text), "pump %u on for %u ms", event.subject, event.arg);
+                break;
+            case PUMP_OFF: {
+                auto run = running.find({event.boot, event.subject});
+                if (run == running.end()) {
+                    snprintf(text, sizeof(text), "pump %u off", event.subject);
+                    break;
+                }
+                int64_t ranMicros = event.micros - run->second.first;
+                int64_t errorMicros = ranMicros - (int64_t)run->second.second * 1000;
+                snprintf(text, sizeof(text), "pump %u off after %lld.%06lld s (%+lld us)", event.subject,
+                         (long long)(ranMicros / 1000000), (long long)(ranMicros % 1000000),
+                         (long long)errorMicros);
+                running.erase(run);
+                break;
+            }
+            case NEEDS_WATERING:
+                if (event.detail) {
+                    snprintf(text, sizeof(text), "plant %u needs watering (%s)", event.subject, sourceName(event.arg));
+                } else {
+                    snprintf(text, sizeof(text), "plant %u no longer needs watering", event.subject);
+                }
+                break;
+            case WATERED:
+                snprintf(text, sizeof(text), "plant %u watered (%s, %u ms)", event.subject, sourceName(event.detail),
+                         event.arg);
+                break;
+            case EEPROM_COMMIT:
+                snprintf(text, sizeof(text), "EEPROM commit %s in %u us", event.detail ? "done" : "FAILED", event.arg);
+                break;
+            case WIFI:
+                if (event.detail == 0) {
+                    snprintf(text, sizeof(text), "Wi-Fi connected, RSSI %d dBm", (int)(int32_t)event.arg);
+                } else {
+                    snprintf(text, sizeof(text), "Wi-Fi %s", wifiName(event.detail));
+                }
+                break;
+            case NTP_START:
+                snprintf(text, sizeof(text), "SNTP %s", event.detail ? "restarted" : "started");
+                break;
+            case TIME_SYNC: {
+                time_t seconds = event.arg;
+                struct tm timeinfo;
+                gmtime_r(&seconds, &timeinfo);
+                char when[32];
+                strftime(when, sizeof(when), "%Y-%m-%dT%H:%M:%S", &timeinfo);
+                snprintf(text, sizeof(text), "time synced to %s.%03uZ", when, event.subject);
+                break;
+            }
+            case COMMAND_QUEUED:
+            case COMMAND_APPLIED: {
+                const char* what = event.type == COMMAND_QUEUED ? "queued" : "applied";
+                if (event.detail == COMMAND_BATCH) {
+                    snprintf(text, sizeof(text), "command %u %s: batch of %u", event.arg, what, event.subject);
+                } else {
+                    snprintf(text, sizeof(text), "command %u %s: %s plant %u", event.arg, what,
+                             commandName(event.detail), event.subject);
+                }
+                break;
+            }
+            default:
+                snprintf(text, sizeof(text), "event %u (detail %u, subject %u, arg %u)", event.type, event.detail,
+                         event.subject, event.arg);
+                break;
+        }
+        if (plant >= 0 && !concernsPlant(event, plant)) continue;
+        printf("%s  %s\n", formatTime(event, anchors).c_str(), text);
+    }
+
+    for (const auto& run : running) {
+        if (run.first.first == bootCount && (plant < 0 || run.first.second == plant)) {
+            printf("pump %u still running\n", run.first.second);
+        }
+    }
+    if (lost) printf("%lu events lost in total\n", lost);
+    return 0;
+}
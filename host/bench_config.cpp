@@ -0,0 +1,75 @@
+// bench_config.cpp - stand-in for config.cpp with BENCH_PUMPS pumps
+//
+// The plant table repeats the eight real profiles from config.cpp so the
+// per-plant work matches what the device does, just more of it.
+#include "config.h"
+#include "water_my_plants.h"
+
+#ifndef BENCH_PUMPS
+#define BENCH_PUMPS 8
+#endif
+
+const char* ssid = "bench";
+const char* password = "bench";
+
+const char* ntpServer = "pool.ntp.org";
+const char* ntpServer1 = "time.google.com";
+const char* ntpServer2 = "time.cloudflare.com";
+const long gmtOffset_sec = -18000;
+const int daylightOffset_sec = 3600;
+const int MINUTES_PER_DAY = 1440;
+
+// Every pump on an MCP23017, eight to a chip. A real bus takes eight chips;
+// the bench numbers them on past that since the shim doesn't mind.
+#define BENCH_EXPANDERS ((BENCH_PUMPS + 7) / 8)
+static PlantDefaults benchPlants[BENCH_PUMPS];
+static char benchNames[BENCH_PUMPS][32];
+static PumpWiring benchPumps[BENCH_PUMPS];
+static PumpExpander benchExpanders[BENCH_EXPANDERS];
+
+const PlantDefaults* const defaultPlants = benchPlants;
+const int NUM_DEFAULT_PLANTS = BENCH_PUMPS;
+const PumpWiring* const defaultPumps = benchPumps;
+const int NUM_DEFAULT_PUMPS = BENCH_PUMPS;
+const PumpExpander* const defaultPumpExpanders = benchExpanders;
+const int NUM_DEFAULT_PUMP_EXPANDERS = BENCH_EXPANDERS;
+
+namespace {
+
+struct Profile {
+    const char* name;
+    float ozPerWatering;
+    int intervalMinutes;
+};
+
+const Profile profiles[] = {
+    {"Prickly Pear", 3.0, 14 * MINUTES_PER_DAY},
+    {"Rosemary", 3.0, 4 * MINUTES_PER_DAY},
+    {"Fittonia", 1.5, 1 * MINUTES_PER_DAY},
+    {"Thyme", 3.0, 3 * MINUTES_PER_DAY},
+    {"Myrtle", 3.0, (int)(2.5 * MINUTES_PER_DAY)},
+    {"No Plant", 0.0, 100 * MINUTES_PER_DAY},
+    {"Lavender", 3.0, 4 * MINUTES_PER_DAY},
+    {"Mint Plant", 3.0, 2 * MINUTES_PER_DAY},
+};
+
+struct BenchTable {
+    BenchTable() {
+        const int numProfiles = sizeof(profiles) / sizeof(profiles[0]);
+        for (int i = 0; i < BENCH_PUMPS; i++) {
+            const Profile& profile = profiles[i % numProfiles];
+            snprintf(benchNames[i], sizeof(benchNames[i]), "%s %d", profile.name, i / numProfiles + 1);
+            benchPlants[i] = {benchNames[i], profile.ozPerWatering, profile.intervalMinutes};
+
+            int expander = i / 8, pin = i % 8 * 2;
+            benchPumps[i] = {EXPANDER_PIN(expander, pin), EXPANDER_PIN(expander, pin + 1), 1};
+        }
+        for (int e = 0; e < BENCH_EXPANDERS; e++) {
+            benchExpanders[e] = {&Wire, (uint8_t)(0x20 + e)};
+        }
+    }
+};
+
+BenchTable benchTable;
+
+}  // namespace
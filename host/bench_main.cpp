@@ -0,0 +1,382 @@
+// bench_main.cpp - per-iteration cost of the firmware hot paths
+//
+// Built once per pump count (wmp_bench_8, _64, _512). Each case runs for at
+// least BENCH_MIN_MS of host time and reports the mean and the best batch.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "plant_cbor.h"
+#include "sim.h"
+#include "water_my_plants.h"
+
+namespace {
+
+struct BenchResult {
+    double meanNs;
+    double bestNs;
+    unsigned long iterations;
+};
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+BenchResult measure(const std::function<void()>& fn, unsigned minMs) {
+    const unsigned long batch = 16;
+    BenchResult r = {0, 1e300, 0};
+    double total = 0;
+    // Warm up caches and the allocator before timing.
+    for (unsigned long i = 0; i < batch; i++) fn();
+    while (total < minMs * 1e6) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned long i = 0; i < batch; i++) fn();
+        double ns = elapsedNs(start);
+        total += ns;
+        r.iterations += batch;
+        if (ns / batch < r.bestNs) r.bestNs = ns / batch;
+    }
+    r.meanNs = total / r.iterations;
+    return r;
+}
+
+void report(const char* name, const BenchResult& r, const std::string& extra = std::string()) {
+    printf("%-5d %-28s %10lu %12.0f %12.0f  %s\n",
+           numPumps, name, r.iterations, r.meanNs, r.bestNs, extra.c_str());
+}
+
+// Marks every plant as just watered so a scan finds nothing to do.
+void waterAllNow() {
+    time_t now = time(nullptr);
+    for (int i = 0; i < numPumps; i++) {
+        Plant& plant = plants[i];
+        for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
+            plant.wateringHistory[j].timestamp = now - (WATERING_HISTORY_SIZE - j) * 60;
+            plant.wateringHistory[j].amount = plant.ozPerWatering;
+        }
+        plant.currentHistoryIndex = 0;
+        zones.needsWatering[i] = false;
+    }
+    rescheduleAllPlants();
+    checkWateringNeeds();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    unsigned minMs = 300;
+    if (const char* env = getenv("BENCH_MIN_MS")) minMs = (unsigned)atoi(env);
+    std::string stateDir = argc > 1 ? argv[1] : "bench_state";
+
+    sim::setSerialOutput(nullptr);
+    sim::setEepromPath(stateDir + "-eeprom.bin");
+    sim::setSpiffsRoot(stateDir + "-spiffs");
+    remove((stateDir + "-eeprom.bin").c_str());
+
+    traceBegin();
+    // Fresh flash, so the built-in zone table applies
+    SPIFFS.begin(true);
+    SPIFFS.format();
+    pumpRegistryBegin();
+    metricsBegin();
+    timeBaseBegin();
+    WiFi.begin(ssid, password);
+    delay(2000);
+    configTime(gmtOffset_sec, daylightOffset_sec, ntpServer, ntpServer1, ntpServer2);
+    delay(1000);
+    if (!pumpsBegin()) {
+        fprintf(stderr, "pump outputs failed to initialize\n");
+        return 1;
+    }
+    schedulerBegin();
+    commandsBegin();
+    journalBegin();
+    loadWateringTimes();
+    snapshotsBegin();
+    setupWebServer();
+    waterAllNow();
+
+    printf("%-5s %-28s %10s %12s %12s\n", "pumps", "case", "iters", "mean ns", "best ns");
+
+    report("check+water (idle)", measure([] {
+        checkWateringNeeds();
+        waterPlants();
+    }, minMs));
+
+    // Every pump switched on and back off in two passes: one write per
+    // expander each, however many pumps share it
+    sim::resetI2cStats();
+    unsigned long passes = 0;
+    BenchResult outputs = measure([&passes] {
+        for (int i = 0; i < numPumps; i++) pumpOn(pumps[i]);
+        flushPumpOutputs();
+        for (int i = 0; i < numPumps; i++) pumpOff(pumps[i]);
+        flushPumpOutputs();
+        passes += 2;
+    }, minMs);
+    char extra[128];
+    snprintf(extra, sizeof(extra), "%.1f I2C writes, %.0f us of bus per pass (%d expanders)",
+             (double)sim::i2cStats().transactions / passes, (double)sim::i2cStats().busMicros / passes,
+             numPumpExpanders);
+    report("pump outputs (all on/off)", outputs, extra);
+
+    sim::resetEepromStats();
+    sim::resetI2cStats();
+    double drainMs = 0;
+    BenchResult cycle = measure([&drainMs] {
+        // Same as POST /api/plants/water-now for every pump, then what the
+        // control loop does until the power budget has let them all run
+        uint64_t start = sim::nowMicros();
+        for (int i = 0; i < numPumps; i++) {
+            zones.needsWatering[i] = true;
+            markPlantChanged(i);
+        }
+        checkWateringNeeds();
+        waterPlants();
+        while (waitingPumpCount() > 0 || runningPumpWeight() > 0) {
+            // Up to the next stagger slot or pump stop, whichever is first
+            uint64_t wake = std::min<uint64_t>(sim::nextTimerMicros(),
+                                sim::nowMicros() + std::min(millisUntilNextWatering(), 86400000UL) * 1000ULL);
+            sim::advanceMicros(wake - sim::nowMicros());
+            waterPlants();
+            checkWateringNeeds();
+            // The log task gets the CPU whenever the control loop sleeps
+            logDrain();
+        }
+        drainMs = (sim::nowMicros() - start) / 1000.0;
+        // What the service and log tasks then do with the finished waterings
+        journalFlush();
+        sendPlantEvents();
+        commitDirtyPlants(false);
+        logDrain();
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%u commits, %zu records journaled, %u I2C writes, drained in %.1f s simulated",
+             sim::eepromStats().commits, journalRecordCount(), sim::i2cStats().transactions, drainMs / 1000);
+    report("water cycle (start+stop)", cycle, extra);
+    waterAllNow();
+
+    // A watering's log line as the control loop pays for it, and what the
+    // log task spends turning it into text afterwards
+    double postNs = 0;
+    unsigned long posts = 0;
+    uint32_t droppedBefore = logDroppedCount();
+    BenchResult logging = measure([&postNs, &posts] {
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < LOG_RING_SLOTS / 2; n++) {
+            LOG_INFO("Finished watering %s (%.1f oz)", pumps[n % numPumps].plant->name, 2.5);
+        }
+        postNs += elapsedNs(start);
+        posts += LOG_RING_SLOTS / 2;
+        logDrain();
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%.0f ns per post, %u dropped", postNs / posts,
+             (unsigned)(logDroppedCount() - droppedBefore));
+    report("log 32 lines (post+print)", logging, extra);
+
+    // The flight recorder entries around one dose: what pumpOn() and
+    // pumpOff() add to the control loop
+    BenchResult tracing = measure([] {
+        for (int n = 0; n < 16; n++) {
+            traceRecord(TRACE_PUMP_ON, n % numPumps, 0, 30000);
+            traceRecord(TRACE_PUMP_OFF, n % numPumps, 0, 0);
+        }
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%.1f ns per event", tracing.meanNs / 32);
+    report("trace 32 events", tracing, extra);
+
+    sim::resetEepromStats();
+    BenchResult save = measure([] { saveWateringTimes(); }, minMs);
+    snprintf(extra, sizeof(extra), "%u commits, %d B image", sim::eepromStats().commits, eepromSize);
+    report("saveWateringTimes", save, extra);
+
+    time_t journalTime = time(nullptr);
+    BenchResult journal = measure([&journalTime] {
+        journalAppend(0, journalTime++, 1.5f, 30000, WATERING_SCHEDULED);
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu records, %zu segments", journalRecordCount(), journalSegmentCount());
+    report("journalAppend", journal, extra);
+
+    // Three years of waterings for up to 8 plants, three a day each, in a
+    // fresh journal: paging through a plant must see every record once and
+    // the weekly totals must add up to the same thing
+    SPIFFS.format();
+    journalBegin();
+    const int historyPlants = numPumps < 8 ? numPumps : 8;
+    const time_t historyEnd = time(nullptr);
+    const time_t historyStart = historyEnd - 3 * 365 * 86400L;
+    unsigned long expectedCount = 0;
+    double expectedOz = 0;
+    for (time_t t = historyStart; t < historyEnd; t += 8 * 3600) {
+        for (int p = 0; p < historyPlants; p++) {
+            float oz = 0.5f + (t / 86400 + p) % 4 * 0.25f;
+            journalAppend(p, t + p * 60, oz, (uint32_t)(oz * MILLIS_PER_OZ), WATERING_SCHEDULED);
+            if (p == 0) {
+                expectedCount++;
+                expectedOz += oz;
+            }
+        }
+    }
+
+    unsigned long pagedCount = 0, pages = 0;
+    double pagedOz = 0;
+    std::string next;
+    do {
+        std::string url = "/api/plants/0/history?limit=1000";
+        if (!next.empty()) url += "&cursor=" + next;
+        std::string body = sim::http(server, "GET", url).body;
+        pages++;
+        for (size_t at = body.find("\"amount\":"); at != std::string::npos; at = body.find("\"amount\":", at + 1)) {
+            pagedCount++;
+            pagedOz += atof(body.c_str() + at + 9);
+        }
+        size_t token = body.rfind("\"next\":\"");
+        next = token == std::string::npos ? "" : body.substr(token + 8, body.find('"', token + 8) - token - 8);
+    } while (!next.empty());
+
+    std::string weekly = sim::http(server, "GET", "/api/plants/0/history?bucket=week&limit=1000").body;
+    unsigned long bucketCount = 0, buckets = 0;
+    for (size_t at = weekly.find("\"count\":"); at != std::string::npos; at = weekly.find("\"count\":", at + 1)) {
+        bucketCount += strtoul(weekly.c_str() + at + 8, nullptr, 10);
+        buckets++;
+    }
+    if (pagedCount != expectedCount || bucketCount != expectedCount || fabs(pagedOz - expectedOz) > 0.01 * pages) {
+        fprintf(stderr, "history mismatch: %lu records expected, %lu paged, %lu in buckets\n",
+                expectedCount, pagedCount, bucketCount);
+        return 1;
+    }
+
+    size_t historyBytes = 0;
+    BenchResult page = measure([&historyBytes] {
+        historyBytes = sim::http(server, "GET", "/api/plants/0/history?limit=100").body.size();
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu B, %zu records journaled", historyBytes, journalRecordCount());
+    report("GET history (100 records)", page, extra);
+
+    BenchResult week = measure([&historyBytes] {
+        historyBytes = sim::http(server, "GET", "/api/plants/0/history?bucket=week&limit=1000").body.size();
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu B, %lu weeks, %zu B cursor", historyBytes, buckets, sizeof(HistoryCursor));
+    report("GET history (3 y by week)", week, extra);
+
+    size_t jsonBytes = 0;
+    BenchResult json = measure([&jsonBytes] {
+        static PlantJsonCursor cursor;
+        uint8_t window[1436];
+        cursor = PlantJsonCursor();
+        jsonBytes = 0;
+        while (size_t n = fillPlantDataJson(cursor, window, sizeof(window))) jsonBytes += n;
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu B", jsonBytes);
+    report("fillPlantDataJson", json, extra);
+
+    size_t cborBytes = 0;
+    BenchResult cbor = measure([&cborBytes] {
+        static PlantCborCursor cursor;
+        uint8_t window[1436];
+        cursor = PlantCborCursor();
+        cborBytes = 0;
+        while (size_t n = fillPlantDataCbor(cursor, window, sizeof(window))) cborBytes += n;
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu B, %.1fx smaller and %.1fx faster than JSON", cborBytes,
+             (double)jsonBytes / cborBytes, json.meanNs / cbor.meanNs);
+    report("fillPlantDataCbor", cbor, extra);
+
+    size_t httpBytes = 0;
+    BenchResult get = measure([&httpBytes] {
+        httpBytes = sim::http(server, "GET", "/api/plants").body.size();
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu B", httpBytes);
+    report("GET /api/plants", get, extra);
+
+    // The scraper's view: both formats must describe the same plants
+    std::string binary;
+    BenchResult getBinary = measure([&binary] {
+        binary = sim::http(server, "GET", "/api/plants", "", {{"Accept", "application/cbor"}}).body;
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu B", binary.size());
+    report("GET /api/plants (CBOR)", getBinary, extra);
+
+    plant_cbor::Plants decoded;
+    std::string decodeError;
+    BenchResult decode = measure([&binary, &decoded, &decodeError] {
+        plant_cbor::decodePlants((const uint8_t*)binary.data(), binary.size(), decoded, &decodeError);
+    }, minMs);
+    std::string text = sim::http(server, "GET", "/api/plants").body;
+    size_t textPlants = 0;
+    for (size_t at = text.find("\"name\":"); at != std::string::npos; at = text.find("\"name\":", at + 1)) {
+        textPlants++;
+    }
+    bool same = decodeError.empty() && decoded.plants.size() == (size_t)numPumps && textPlants == decoded.plants.size();
+    for (int i = 0; same && i < numPumps; i++) {
+        PlantSnapshot plant;
+        readPlantSnapshot(i, plant);
+        const plant_cbor::Plant& got = decoded.plants[i];
+        same = got.present && got.name == plant.name && fabsf(got.ozPerWatering - plant.ozPerWatering) < 0.005f &&
+               got.intervalMinutes == plant.intervalMinutes && got.history.size() == WATERING_HISTORY_SIZE &&
+               got.history[0].timestamp == plant.history[0].timestamp;
+    }
+    if (!same) {
+        fprintf(stderr, "CBOR mismatch: %s, %zu plants decoded, %zu in JSON\n",
+                decodeError.empty() ? "fields differ" : decodeError.c_str(), decoded.plants.size(), textPlants);
+        return 1;
+    }
+    snprintf(extra, sizeof(extra), "%zu plants, schema %u", decoded.plants.size(), (unsigned)decoded.schema);
+    report("decodePlants (client)", decode, extra);
+
+    // A burst of settings edits: each request is queued and applied by the
+    // next control loop pass, which only marks the plant dirty; the commit
+    // happens once for the whole burst
+    sim::resetEepromStats();
+    int putIndex = 0;
+    BenchResult put = measure([&putIndex] {
+        char body[64];
+        snprintf(body, sizeof(body), "{\"plantIndex\":%d,\"ozPerWatering\":2.5}", putIndex++ % numPumps);
+        sim::http(server, "PUT", "/api/plants/amount", body);
+        applyCommands();
+    }, minMs);
+    commitDirtyPlants(true);
+    snprintf(extra, sizeof(extra), "%u commits", sim::eepromStats().commits);
+    report("PUT /api/plants/amount", put, extra);
+
+    // The same edit for every plant, split into batches as a client would:
+    // one command per batch, and one commit for the lot
+    std::vector<std::string> batches;
+    for (int i = 0; i < numPumps; i++) {
+        if (i % BATCH_MAX_UPDATES == 0) batches.push_back("[");
+        char entry[64];
+        snprintf(entry, sizeof(entry), "%s{\"plantIndex\":%d,\"ozPerWatering\":2.5}",
+                 i % BATCH_MAX_UPDATES ? "," : "", i);
+        batches.back() += entry;
+    }
+    for (std::string& batch : batches) batch += "]";
+    sim::resetEepromStats();
+    sim::HttpOptions segments;
+    segments.bodyChunk = 1436;
+    unsigned long edits = 0;
+    BenchResult putBatch = measure([&batches, &segments, &edits] {
+        for (const std::string& batch : batches) {
+            sim::http(server, "PUT", "/api/plants/batch", batch, sim::Headers(), segments);
+            applyCommands();
+        }
+        commitDirtyPlants(false);
+        edits++;
+    }, minMs);
+    snprintf(extra, sizeof(extra), "%zu x %zu B body, %u commits for %lu edits", batches.size(),
+             batches[0].size(), sim::eepromStats().commits, edits);
+    report("PUT /api/plants/batch", putBatch, extra);
+
+    sim::HttpResponse first = sim::http(server, "GET", "/api/plants");
+    sim::Headers conditional = {{"If-None-Match", *first.header("ETag")}};
+    int status = 0;
+    BenchResult notModified = measure([&conditional, &status] {
+        status = sim::http(server, "GET", "/api/plants", "", conditional).status;
+    }, minMs);
+    snprintf(extra, sizeof(extra), "status %d", status);
+    report("GET /api/plants (ETag hit)", notModified, extra);
+
+    return 0;
+}
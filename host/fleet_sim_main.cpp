@@ -0,0 +1,240 @@
+// fleet_sim_main.cpp - the simulated firmware on real TCP ports, as a
+// stand-in fleet for wmp_aggregator
+//
+// Usage: wmp_fleet_sim [--port BASE] [--count N] [--speed X]
+//
+// Boots the sketch on the host shim with the bench pump table and answers
+// HTTP on ports BASE..BASE+N-1 (default 9000, 100 ports), every one backed
+// by the same firmware. Simulated time runs X times faster than real time
+// (default 60), so plants get watered and ETags move while the aggregator
+// polls. One request per connection, like the aggregator sends.
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "sim.h"
+#include "water_my_plants.h"
+
+namespace {
+
+const size_t MAX_REQUEST_BYTES = 65536;
+
+struct Connection {
+    std::string in;
+    std::string out;
+    size_t sent = 0;
+};
+
+int epollFd = -1;
+std::vector<int> listeners;
+std::vector<Connection> connections;    // by fd
+
+// What the control and service tasks would do, up to targetMicros
+void runUntil(uint64_t targetMicros) {
+    while (sim::nowMicros() < targetMicros) {
+        uint64_t now = sim::nowMicros();
+        uint64_t wake = std::min<uint64_t>(targetMicros, sim::nextTimerMicros());
+        wake = std::min<uint64_t>(wake, now + std::min(millisUntilNextWatering(), 3600000UL) * 1000ULL);
+        if (wake < now + 1000) wake = std::min<uint64_t>(targetMicros, now + 1000);
+        sim::advanceMicros(wake - now);
+        applyCommands();
+        checkWateringNeeds();
+        waterPlants();
+        journalFlush();
+        sendPlantEvents();
+        commitDirtyPlants(false);
+        logDrain();
+    }
+}
+
+const char* reason(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 202: return "Accepted";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    default: return "Status";
+    }
+}
+
+// Hands a complete request to the in-process web server
+std::string answer(const std::string& request) {
+    size_t headEnd = request.find("\r\n\r\n");
+    char method[16], url[1024];
+    if (sscanf(request.c_str(), "%15s %1023s", method, url) != 2) {
+        return "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+    sim::Headers headers;
+    for (size_t line = request.find("\r\n"); line < headEnd; line = request.find("\r\n", line + 2)) {
+        size_t end = request.find("\r\n", line + 2);
+        std::string field = request.substr(line + 2, end - line - 2);
+        size_t colon = field.find(':');
+        if (colon == std::string::npos) continue;
+        size_t value = field.find_first_not_of(' ', colon + 1);
+        headers.push_back({field.substr(0, colon), value == std::string::npos ? "" : field.substr(value)});
+    }
+    sim::HttpResponse response = sim::http(server, method, url, request.substr(headEnd + 4), headers);
+
+    std::string out = "HTTP/1.1 " + std::to_string(response.status) + " " + reason(response.status) + "\r\n";
+    for (const auto& header : response.headers) {
+        if (strcasecmp(header.first.c_str(), "Content-Length") == 0) continue;
+        out += header.first + ": " + header.second + "\r\n";
+    }
+    out += "Content-Length: " + std::to_string(response.body.size()) + "\r\nConnection: close\r\n\r\n";
+    return out + response.body;
+}
+
+void closeConnection(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections[fd] = Connection();
+}
+
+void flush(int fd) {
+    Connection& connection = connections[fd];
+    while (connection.sent < connection.out.size()) {
+        ssize_t n = send(fd, connection.out.data() + connection.sent, connection.out.size() - connection.sent,
+                         MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) closeConnection(fd);
+            return;
+        }
+        connection.sent += n;
+    }
+    closeConnection(fd);
+}
+
+void readable(int fd) {
+    Connection& connection = connections[fd];
+    if (!connection.out.empty()) {
+        flush(fd);
+        return;
+    }
+    char buffer[4096];
+    for (;;) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) ||
+            connection.in.size() + (n > 0 ? n : 0) > MAX_REQUEST_BYTES) {
+            closeConnection(fd);
+            return;
+        }
+        if (n < 0) break;
+        connection.in.append(buffer, n);
+    }
+    size_t headEnd = connection.in.find("\r\n\r\n");
+    if (headEnd == std::string::npos) return;
+    size_t bodyLen = 0;
+    for (size_t at = connection.in.find("\r\n"); at < headEnd; at = connection.in.find("\r\n", at + 2)) {
+        if (strncasecmp(connection.in.c_str() + at + 2, "Content-Length:", 15) == 0) {
+            bodyLen = strtoul(connection.in.c_str() + at + 17, nullptr, 10);
+        }
+    }
+    if (connection.in.size() < headEnd + 4 + bodyLen) return;
+
+    connection.out = answer(connection.in);
+    epoll_event event = {};
+    event.events = EPOLLOUT;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    flush(fd);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int basePort = 9000, count = 100;
+    double speed = 60;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--port") && i + 1 < argc) {
+            basePort = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--speed") && i + 1 < argc) {
+            speed = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--port BASE] [--count N] [--speed X]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    sim::setSerialOutput(nullptr);
+    sim::setEepromPath("fleet_state-eeprom.bin");
+    sim::setSpiffsRoot("fleet_state-spiffs");
+    remove("fleet_state-eeprom.bin");
+
+    traceBegin();
+    // Fresh flash, so the built-in zone table applies
+    SPIFFS.begin(true);
+    SPIFFS.format();
+    pumpRegistryBegin();
+    metricsBegin();
+    timeBaseBegin();
+    WiFi.begin(ssid, password);
+    delay(2000);
+    configTime(gmtOffset_sec, daylightOffset_sec, ntpServer, ntpServer1, ntpServer2);
+    delay(1000);
+    pumpsBegin();
+    schedulerBegin();
+    commandsBegin();
+    journalBegin();
+    loadWateringTimes();
+    snapshotsBegin();
+    setupWebServer();
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    for (int port = basePort; port < basePort + count; port++) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 64) != 0) {
+            fprintf(stderr, "port %d: %s\n", port, strerror(errno));
+            return 1;
+        }
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        listeners.push_back(fd);
+    }
+    fprintf(stderr, "%d simulated controllers on 127.0.0.1:%d-%d, %d pumps each, %.0fx real time\n",
+            count, basePort, basePort + count - 1, numPumps, speed);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t simStart = sim::nowMicros();
+    epoll_event events[256];
+    for (;;) {
+        int n = epoll_wait(epollFd, events, 256, 100);
+        double realUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        runUntil(simStart + (uint64_t)(realUs * speed));
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (std::find(listeners.begin(), listeners.end(), fd) != listeners.end()) {
+                for (int client; (client = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0; ) {
+                    if ((size_t)client >= connections.size()) connections.resize(client + 1);
+                    epoll_event event = {};
+                    event.events = EPOLLIN;
+                    event.data.fd = client;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, client, &event);
+                }
+            } else {
+                readable(fd);
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// Arduino.h - host stand-in for the ESP32 Arduino core
+//
+// Only the pieces the sketch uses are provided. Time is simulated: delay()
+// advances the sim clock instead of sleeping, see sim.h.
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "IPAddress.h"
+#include "Print.h"
+#include "WString.h"
+
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(addr) (*(const unsigned char*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec,
+                const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+uint32_t esp_random();
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush();
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    [[noreturn]] void restart();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getHeapSize();
+};
+
+extern EspClass ESP;
@@ -0,0 +1,263 @@
+// ArduinoJson.h - host stand-in for the subset of ArduinoJson 6 the sketch uses
+//
+// Parsing only. Documents are tree-of-nodes on the host heap, but capacity is
+// still enforced per value slot so a document that would overflow its pool
+// on the device fails with NoMemory here too.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "WString.h"
+
+class JsonDocument;
+
+namespace ArduinoJson {
+namespace detail {
+
+enum class NodeType : uint8_t { Null, Bool, Integer, Float, String, Array, Object };
+
+struct Node {
+    NodeType type = NodeType::Null;
+    bool boolean = false;
+    long long integer = 0;
+    double real = 0;
+    std::string key;
+    std::string string;
+    std::vector<int> children;
+};
+
+}  // namespace detail
+}  // namespace ArduinoJson
+
+class JsonArrayConst;
+class JsonObjectConst;
+
+class JsonVariantConst {
+public:
+    JsonVariantConst() : _doc(nullptr), _index(-1) {}
+    JsonVariantConst(const JsonDocument* doc, int index) : _doc(doc), _index(index) {}
+
+    bool isNull() const;
+    template <typename T> bool is() const;
+    template <typename T> T as() const;
+    template <typename T> operator T() const { return as<T>(); }
+
+    JsonVariantConst operator[](const char* key) const;
+    JsonVariantConst operator[](const String& key) const { return (*this)[key.c_str()]; }
+    JsonVariantConst operator[](size_t index) const;
+    JsonVariantConst operator[](int index) const { return (*this)[(size_t)index]; }
+    bool containsKey(const char* key) const { return hasMember(key); }
+    size_t size() const;
+
+    template <typename T>
+    T operator|(T defaultValue) const { return is<T>() ? as<T>() : defaultValue; }
+    const char* operator|(const char* defaultValue) const;
+
+private:
+    friend class JsonArrayConst;
+    friend class JsonObjectConst;
+    const ArduinoJson::detail::Node* node() const;
+    bool hasMember(const char* key) const;
+
+    const JsonDocument* _doc;
+    int _index;
+};
+
+typedef JsonVariantConst JsonVariant;
+
+class JsonArrayConst {
+public:
+    class iterator {
+    public:
+        iterator(const JsonDocument* doc, const int* it) : _doc(doc), _it(it) {}
+        JsonVariantConst operator*() const { return JsonVariantConst(_doc, *_it); }
+        iterator& operator++() { ++_it; return *this; }
+        bool operator!=(const iterator& other) const { return _it != other._it; }
+
+    private:
+        const JsonDocument* _doc;
+        const int* _it;
+    };
+
+    JsonArrayConst() {}
+    explicit JsonArrayConst(JsonVariantConst v) : _v(v) {}
+    bool isNull() const;
+    size_t size() const { return _v.size(); }
+    JsonVariantConst operator[](size_t index) const { return _v[index]; }
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    JsonVariantConst _v;
+};
+
+typedef JsonArrayConst JsonArray;
+
+class JsonObjectConst {
+public:
+    JsonObjectConst() {}
+    explicit JsonObjectConst(JsonVariantConst v) : _v(v) {}
+    bool isNull() const;
+    size_t size() const { return _v.size(); }
+    bool containsKey(const char* key) const { return _v.containsKey(key); }
+    JsonVariantConst operator[](const char* key) const { return _v[key]; }
+
+private:
+    JsonVariantConst _v;
+};
+
+typedef JsonObjectConst JsonObject;
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+    DeserializationError(Code code = Ok) : _code(code) {}
+    explicit operator bool() const { return _code != Ok; }
+    bool operator==(Code code) const { return _code == code; }
+    bool operator!=(Code code) const { return _code != code; }
+    Code code() const { return _code; }
+    const char* c_str() const;
+
+private:
+    Code _code;
+};
+
+class JsonDocument {
+public:
+    explicit JsonDocument(size_t capacity) : _capacity(capacity) {}
+
+    void clear() { _nodes.clear(); }
+    size_t capacity() const { return _capacity; }
+    size_t memoryUsage() const { return _nodes.size() * kSlotSize; }
+    bool overflowed() const { return _overflowed; }
+
+    bool isNull() const { return root().isNull(); }
+    template <typename T> bool is() const { return root().is<T>(); }
+    template <typename T> T as() const { return root().as<T>(); }
+    JsonVariantConst operator[](const char* key) const { return root()[key]; }
+    JsonVariantConst operator[](const String& key) const { return root()[key]; }
+    JsonVariantConst operator[](size_t index) const { return root()[index]; }
+    JsonVariantConst operator[](int index) const { return root()[index]; }
+    bool containsKey(const char* key) const { return root().containsKey(key); }
+    size_t size() const { return root().size(); }
+
+    JsonVariantConst root() const { return JsonVariantConst(this, _nodes.empty() ? -1 : 0); }
+
+    // Internal to the parser.
+    int allocNode();
+    ArduinoJson::detail::Node& node(int index) { return _nodes[index]; }
+    const ArduinoJson::detail::Node& node(int index) const { return _nodes[index]; }
+
+    // A variant slot is 16 bytes on the 32-bit device.
+    static const size_t kSlotSize = 16;
+
+private:
+    size_t _capacity;
+    bool _overflowed = false;
+    std::vector<ArduinoJson::detail::Node> _nodes;
+};
+
+template <size_t N>
+class StaticJsonDocument : public JsonDocument {
+public:
+    StaticJsonDocument() : JsonDocument(N) {}
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+    explicit DynamicJsonDocument(size_t capacity) : JsonDocument(capacity) {}
+};
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input);
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t inputSize);
+DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* input, size_t inputSize);
+DeserializationError deserializeJson(JsonDocument& doc, const String& input);
+
+// --- JsonVariantConst conversions ---------------------------------------------
+
+template <> inline bool JsonVariantConst::is<bool>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return n && n->type == ArduinoJson::detail::NodeType::Bool;
+}
+template <> inline bool JsonVariantConst::is<long long>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return n && n->type == ArduinoJson::detail::NodeType::Integer;
+}
+template <> inline bool JsonVariantConst::is<int>() const { return is<long long>(); }
+template <> inline bool JsonVariantConst::is<long>() const { return is<long long>(); }
+template <> inline bool JsonVariantConst::is<unsigned int>() const {
+    return is<long long>() && node()->integer >= 0;
+}
+template <> inline bool JsonVariantConst::is<unsigned long>() const { return is<unsigned int>(); }
+template <> inline bool JsonVariantConst::is<double>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return n && (n->type == ArduinoJson::detail::NodeType::Float ||
+                 n->type == ArduinoJson::detail::NodeType::Integer);
+}
+template <> inline bool JsonVariantConst::is<float>() const { return is<double>(); }
+template <> inline bool JsonVariantConst::is<const char*>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return n && n->type == ArduinoJson::detail::NodeType::String;
+}
+template <> inline bool JsonVariantConst::is<String>() const { return is<const char*>(); }
+template <> inline bool JsonVariantConst::is<JsonArrayConst>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return n && n->type == ArduinoJson::detail::NodeType::Array;
+}
+template <> inline bool JsonVariantConst::is<JsonObjectConst>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return n && n->type == ArduinoJson::detail::NodeType::Object;
+}
+
+template <> inline double JsonVariantConst::as<double>() const {
+    const ArduinoJson::detail::Node* n = node();
+    if (!n) return 0;
+    switch (n->type) {
+        case ArduinoJson::detail::NodeType::Integer: return (double)n->integer;
+        case ArduinoJson::detail::NodeType::Float: return n->real;
+        case ArduinoJson::detail::NodeType::Bool: return n->boolean ? 1 : 0;
+        case ArduinoJson::detail::NodeType::String: return strtod(n->string.c_str(), nullptr);
+        default: return 0;
+    }
+}
+template <> inline float JsonVariantConst::as<float>() const { return (float)as<double>(); }
+template <> inline long long JsonVariantConst::as<long long>() const {
+    const ArduinoJson::detail::Node* n = node();
+    if (!n) return 0;
+    switch (n->type) {
+        case ArduinoJson::detail::NodeType::Integer: return n->integer;
+        case ArduinoJson::detail::NodeType::Float: return (long long)n->real;
+        case ArduinoJson::detail::NodeType::Bool: return n->boolean ? 1 : 0;
+        case ArduinoJson::detail::NodeType::String: return strtoll(n->string.c_str(), nullptr, 10);
+        default: return 0;
+    }
+}
+template <> inline int JsonVariantConst::as<int>() const { return (int)as<long long>(); }
+template <> inline long JsonVariantConst::as<long>() const { return (long)as<long long>(); }
+template <> inline unsigned int JsonVariantConst::as<unsigned int>() const { return (unsigned int)as<long long>(); }
+template <> inline unsigned long JsonVariantConst::as<unsigned long>() const { return (unsigned long)as<long long>(); }
+template <> inline bool JsonVariantConst::as<bool>() const {
+    const ArduinoJson::detail::Node* n = node();
+    if (!n) return false;
+    if (n->type == ArduinoJson::detail::NodeType::Bool) return n->boolean;
+    return as<long long>() != 0;
+}
+template <> inline const char* JsonVariantConst::as<const char*>() const {
+    const ArduinoJson::detail::Node* n = node();
+    return (n && n->type == ArduinoJson::detail::NodeType::String) ? n->string.c_str() : nullptr;
+}
+template <> inline String JsonVariantConst::as<String>() const {
+    const char* s = as<const char*>();
+    return String(s ? s : "null");
+}
+template <> inline JsonArrayConst JsonVariantConst::as<JsonArrayConst>() const { return JsonArrayConst(*this); }
+template <> inline JsonObjectConst JsonVariantConst::as<JsonObjectConst>() const { return JsonObjectConst(*this); }
+
+inline bool JsonArrayConst::isNull() const { return !_v.is<JsonArrayConst>(); }
+inline bool JsonObjectConst::isNull() const { return !_v.is<JsonObjectConst>(); }
+inline const char* JsonVariantConst::operator|(const char* defaultValue) const {
+    return is<const char*>() ? as<const char*>() : defaultValue;
+}
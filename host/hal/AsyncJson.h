@@ -0,0 +1,4 @@
+// AsyncJson.h - host stand-in; the sketch only needs the includes
+#pragma once
+#include <ArduinoJson.h>
+#include "ESPAsyncWebServer.h"
@@ -0,0 +1,46 @@
+// EEPROM.h - host stand-in for the ESP32 flash-emulated EEPROM
+//
+// The whole image is kept in RAM and written to a backing file on commit(),
+// the same way the ESP32 core rewrites its flash partition.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+class EEPROMClass {
+public:
+    bool begin(size_t size);
+    void end();
+
+    uint8_t read(int address);
+    void write(int address, uint8_t val);
+    bool commit();
+    size_t length() { return data.size(); }
+    uint8_t* getDataPtr() { return data.data(); }
+
+    template <typename T>
+    T& get(int address, T& t) {
+        if (address >= 0 && address + sizeof(T) <= data.size()) {
+            memcpy((uint8_t*)&t, data.data() + address, sizeof(T));
+        }
+        return t;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& t) {
+        if (address >= 0 && address + sizeof(T) <= data.size()) {
+            // Like the ESP32 core, put() marks the image dirty even when the
+            // bytes are unchanged.
+            memcpy(data.data() + address, (const uint8_t*)&t, sizeof(T));
+            dirty = true;
+        }
+        return t;
+    }
+
+private:
+    std::vector<uint8_t> data;
+    bool dirty = false;
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,308 @@
+// ESPAsyncWebServer.h - in-process host stand-in for ESPAsyncWebServer
+//
+// There is no socket: requests are injected with sim::http(), which runs the
+// same handler matching, body chunking and response filling as the library.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Arduino.h"
+#include "FS.h"
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+class AsyncEventSource;
+class AsyncEventSourceClient;
+
+namespace sim {
+struct EventStream;
+}
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, const String& filename, size_t index,
+                           uint8_t* data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, uint8_t* data, size_t len,
+                           size_t index, size_t total)> ArBodyHandlerFunction;
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+
+class AsyncWebHeader {
+public:
+    AsyncWebHeader(const String& name, const String& value) : _name(name), _value(value) {}
+    const String& name() const { return _name; }
+    const String& value() const { return _value; }
+
+private:
+    String _name;
+    String _value;
+};
+
+class AsyncWebParameter {
+public:
+    AsyncWebParameter(const String& name, const String& value) : _name(name), _value(value) {}
+    const String& name() const { return _name; }
+    const String& value() const { return _value; }
+
+private:
+    String _name;
+    String _value;
+};
+
+class AsyncWebServerResponse {
+public:
+    AsyncWebServerResponse(int code, const String& contentType) : _code(code), _contentType(contentType) {}
+    virtual ~AsyncWebServerResponse() {}
+
+    void setCode(int code) { _code = code; }
+    void setContentType(const String& type) { _contentType = type; }
+    void addHeader(const String& name, const String& value) { _headers.emplace_back(name, value); }
+
+    int code() const { return _code; }
+    const String& contentType() const { return _contentType; }
+    const std::list<AsyncWebHeader>& headers() const { return _headers; }
+
+    // Produces the body into chunks of at most maxLen bytes, like the TCP
+    // send path does with whatever window space is free.
+    virtual size_t fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) = 0;
+
+protected:
+    int _code;
+    String _contentType;
+    std::list<AsyncWebHeader> _headers;
+};
+
+class AsyncBasicResponse : public AsyncWebServerResponse {
+public:
+    AsyncBasicResponse(int code, const String& contentType = String(), const String& content = String())
+        : AsyncWebServerResponse(code, contentType), _content(content) {}
+    size_t fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) override;
+
+private:
+    String _content;
+};
+
+class AsyncProgmemResponse : public AsyncWebServerResponse {
+public:
+    AsyncProgmemResponse(int code, const String& contentType, const uint8_t* content, size_t len)
+        : AsyncWebServerResponse(code, contentType), _content(content), _len(len) {}
+    size_t fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) override;
+
+private:
+    const uint8_t* _content;
+    size_t _len;
+};
+
+class AsyncCallbackResponse : public AsyncWebServerResponse {
+public:
+    AsyncCallbackResponse(const String& contentType, AwsResponseFiller callback)
+        : AsyncWebServerResponse(200, contentType), _callback(callback) {}
+    size_t fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) override;
+
+private:
+    AwsResponseFiller _callback;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+public:
+    AsyncResponseStream(const String& contentType, size_t bufferSize)
+        : AsyncWebServerResponse(200, contentType) { _content.reserve(bufferSize); }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t len) override;
+    using Print::write;
+    size_t fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) override;
+
+private:
+    std::string _content;
+};
+
+class AsyncWebServerRequest {
+public:
+    AsyncWebServerRequest(AsyncWebServer* server, WebRequestMethodComposite method, const String& url);
+    ~AsyncWebServerRequest();
+
+    AsyncWebServer* server() const { return _server; }
+    WebRequestMethodComposite method() const { return _method; }
+    const String& url() const { return _url; }
+    size_t contentLength() const { return _contentLength; }
+
+    bool hasHeader(const String& name) const;
+    AsyncWebHeader* getHeader(const String& name) const;
+    const String& header(const char* name) const;
+    void addHeader(const String& name, const String& value) { _headers.emplace_back(name, value); }
+
+    bool hasParam(const String& name, bool post = false) const;
+    AsyncWebParameter* getParam(const String& name, bool post = false) const;
+    const String& arg(const String& name) const;
+    bool hasArg(const char* name) const { return hasParam(name); }
+
+    void send(AsyncWebServerResponse* response);
+    void send(int code, const String& contentType = String(), const String& content = String());
+    void send_P(int code, const String& contentType, const uint8_t* content, size_t len);
+    void redirect(const String& url);
+
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(),
+                                          const String& content = String());
+    AsyncWebServerResponse* beginResponse_P(int code, const String& contentType,
+                                            const uint8_t* content, size_t len);
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller callback);
+    AsyncResponseStream* beginResponseStream(const String& contentType, size_t bufferSize = 1460);
+
+    void onDisconnect(std::function<void()> fn) { _onDisconnect = fn; }
+
+    // Host only: the response the handlers settled on, if any.
+    AsyncWebServerResponse* response() const { return _response; }
+    void setContentLength(size_t len) { _contentLength = len; }
+    void disconnect();
+
+    void* _tempObject = nullptr;
+
+private:
+    AsyncWebServer* _server;
+    WebRequestMethodComposite _method;
+    String _url;
+    size_t _contentLength = 0;
+    mutable std::list<AsyncWebHeader> _headers;
+    mutable std::list<AsyncWebParameter> _params;
+    AsyncWebServerResponse* _response = nullptr;
+    std::function<void()> _onDisconnect;
+};
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest* request) = 0;
+    virtual void handleRequest(AsyncWebServerRequest* request) = 0;
+    virtual void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len,
+                            size_t index, size_t total) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+public:
+    void setUri(const String& uri) { _uri = uri; }
+    void setMethod(WebRequestMethodComposite method) { _method = method; }
+    void onRequest(ArRequestHandlerFunction fn) { _onRequest = fn; }
+    void onUpload(ArUploadHandlerFunction fn) { _onUpload = fn; }
+    void onBody(ArBodyHandlerFunction fn) { _onBody = fn; }
+
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+    void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len,
+                    size_t index, size_t total) override;
+    bool isRequestHandlerTrivial() override { return !_onRequest; }
+
+private:
+    String _uri;
+    WebRequestMethodComposite _method = HTTP_ANY;
+    ArRequestHandlerFunction _onRequest;
+    ArUploadHandlerFunction _onUpload;
+    ArBodyHandlerFunction _onBody;
+};
+
+typedef std::function<void(AsyncEventSourceClient* client)> ArEventHandlerFunction;
+
+// One subscriber; on the host its bytes go to a sim::EventStream.
+class AsyncEventSourceClient {
+public:
+    AsyncEventSourceClient(AsyncEventSource* server, std::shared_ptr<sim::EventStream> stream,
+                           uint32_t lastId);
+
+    void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+    void close();
+    bool connected() const;
+    uint32_t lastId() const { return _lastId; }
+    AsyncEventSource* server() const { return _server; }
+
+private:
+    AsyncEventSource* _server;
+    std::shared_ptr<sim::EventStream> _stream;
+    uint32_t _lastId;
+};
+
+class AsyncEventSource : public AsyncWebHandler {
+public:
+    explicit AsyncEventSource(const String& url) : _url(url) {}
+
+    const char* url() const { return _url.c_str(); }
+    void onConnect(ArEventHandlerFunction cb) { _connectcb = cb; }
+    void close();
+    void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+    size_t count() const;
+
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+    bool isRequestHandlerTrivial() override { return false; }
+
+    // Host only: attaches a subscriber, as the library does once the
+    // response headers are out.
+    void connect(std::shared_ptr<sim::EventStream> stream, uint32_t lastId);
+
+private:
+    String _url;
+    std::list<std::unique_ptr<AsyncEventSourceClient>> _clients;
+    ArEventHandlerFunction _connectcb;
+};
+
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port) : _port(port) {}
+    ~AsyncWebServer();
+
+    void begin() { _started = true; }
+    void end() { _started = false; }
+    bool started() const { return _started; }
+
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+    bool removeHandler(AsyncWebHandler* handler);
+
+    AsyncCallbackWebHandler& on(const char* uri, ArRequestHandlerFunction onRequest);
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method,
+                                ArRequestHandlerFunction onRequest);
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method,
+                                ArRequestHandlerFunction onRequest, ArUploadHandlerFunction onUpload);
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method,
+                                ArRequestHandlerFunction onRequest, ArUploadHandlerFunction onUpload,
+                                ArBodyHandlerFunction onBody);
+
+    void onNotFound(ArRequestHandlerFunction fn) { _notFound = fn; }
+    void reset();
+
+    // Host only: routes a request to the first handler that accepts it.
+    AsyncWebHandler* findHandler(AsyncWebServerRequest* request);
+    void handleNotFound(AsyncWebServerRequest* request);
+
+private:
+    uint16_t _port;
+    bool _started = false;
+    std::vector<AsyncWebHandler*> _handlers;
+    std::vector<std::unique_ptr<AsyncCallbackWebHandler>> _ownedHandlers;
+    ArRequestHandlerFunction _notFound;
+};
+
+class DefaultHeaders {
+public:
+    static DefaultHeaders& Instance();
+    void addHeader(const String& name, const String& value) { _headers.emplace_back(name, value); }
+    const std::list<AsyncWebHeader>& headers() const { return _headers; }
+
+private:
+    std::list<AsyncWebHeader> _headers;
+};
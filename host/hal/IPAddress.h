@@ -0,0 +1,18 @@
+// IPAddress.h - host stand-in for the Arduino IPAddress class
+#pragma once
+#include <stdint.h>
+#include "Print.h"
+#include "WString.h"
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : octets{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+
+    uint8_t operator[](int index) const { return octets[index]; }
+    String toString() const;
+    size_t printTo(Print& p) const override;
+
+private:
+    uint8_t octets[4];
+};
@@ -0,0 +1,59 @@
+// WiFi.h - host stand-in for the ESP32 WiFi library
+//
+// Association completes after a simulated latency as long as the sim says an
+// access point is available, see sim::setWifiAvailable(). Events are
+// delivered from sim timers, the way the ESP32 delivers them from its event
+// task.
+#pragma once
+#include <stdint.h>
+#include "IPAddress.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+    WIFI_POWER_19_5dBm = 78,
+    WIFI_POWER_8_5dBm = 34
+} wifi_power_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 8,
+    ARDUINO_EVENT_MAX = 46
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef uint16_t wifi_event_id_t;
+
+class WiFiClass {
+public:
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    bool disconnect(bool wifioff = false);
+    bool reconnect();
+    bool setAutoReconnect(bool autoReconnect);
+    wifi_event_id_t onEvent(WiFiEventCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+    bool mode(wifi_mode_t m);
+    bool setTxPower(wifi_power_t power);
+    wl_status_t status();
+    IPAddress localIP();
+    int8_t RSSI();
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,34 @@
+// Wire.h - host stand-in for the ESP32 I2C master
+//
+// Only writes are modelled. Every address acknowledges and keeps a 256-byte
+// register file with an auto-incrementing pointer, the way an MCP23017 in
+// its default sequential mode does; sim.h reads the registers back.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class TwoWire {
+public:
+    explicit TwoWire(uint8_t busNum) : bus(busNum) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool setClock(uint32_t frequency);
+    uint32_t getClock() { return clock; }
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t len);
+    // 0 on success, like the ESP32 core
+    uint8_t endTransmission(bool sendStop = true);
+
+private:
+    uint8_t bus;
+    uint32_t clock = 100000;
+    bool started = false;
+    uint8_t address = 0;
+    std::vector<uint8_t> pending;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
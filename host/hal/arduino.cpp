@@ -0,0 +1,373 @@
+// arduino.cpp - GPIO, Serial, String/Print and ESP for the host build
+#include <malloc.h>
+#include <ctype.h>
+#include "Arduino.h"
+#include "sim.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+
+uint8_t pinLevels[256];
+uint8_t pinModes[256];
+sim::PinWriteHook pinWriteHook;
+FILE* serialOut = stdout;
+uint32_t randomState = 0x9E3779B9;
+esp_reset_reason_t resetReason = ESP_RST_POWERON;
+
+// Nominal ESP32 heap for free-heap reporting; host allocations made by the
+// sketch after boot are charged against it.
+const uint32_t SIM_HEAP_SIZE = 320 * 1024;
+size_t heapBaseline = 0;
+size_t heapPeak = 0;
+
+size_t heapInUse() {
+    struct mallinfo2 mi = mallinfo2();
+    if (heapBaseline == 0) heapBaseline = mi.uordblks;
+    size_t used = mi.uordblks > heapBaseline ? mi.uordblks - heapBaseline : 0;
+    if (used > heapPeak) heapPeak = used;
+    return used;
+}
+
+String formatInteger(unsigned long long value, bool negative, unsigned char base) {
+    if (base < 2) base = 10;
+    char buf[72];
+    char* p = buf + sizeof(buf) - 1;
+    *p = '\0';
+    do {
+        int digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while (value);
+    if (negative) *--p = '-';
+    return String(p);
+}
+
+String formatFloat(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    return String(buf);
+}
+
+}  // namespace
+
+namespace sim {
+
+uint8_t pinLevel(uint8_t pin) {
+    return pinLevels[pin];
+}
+
+void setPinWriteHook(PinWriteHook hook) {
+    pinWriteHook = hook;
+}
+
+void setSerialOutput(FILE* out) {
+    serialOut = out;
+}
+
+}  // namespace sim
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    pinModes[pin] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    pinLevels[pin] = val ? HIGH : LOW;
+    if (pinWriteHook) pinWriteHook(pin, pinLevels[pin], sim::nowMicros());
+}
+
+int digitalRead(uint8_t pin) {
+    return pinLevels[pin];
+}
+
+// Deterministic so simulation runs are repeatable.
+uint32_t esp_random() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// --- Serial ----------------------------------------------------------------------
+
+void HardwareSerial::begin(unsigned long baud) {
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialOut) fputc(c, serialOut);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (serialOut) fwrite(buffer, 1, size, serialOut);
+    return size;
+}
+
+void HardwareSerial::flush() {
+    if (serialOut) fflush(serialOut);
+}
+
+// --- ESP -------------------------------------------------------------------------
+
+void EspClass::restart() {
+    throw sim::Restart();
+}
+
+esp_reset_reason_t esp_reset_reason() {
+    return resetReason;
+}
+
+void sim::setResetReason(esp_reset_reason_t reason) {
+    resetReason = reason;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    size_t used = heapInUse();
+    return used < SIM_HEAP_SIZE ? SIM_HEAP_SIZE - used : 0;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    heapInUse();
+    return heapPeak < SIM_HEAP_SIZE ? SIM_HEAP_SIZE - heapPeak : 0;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return getFreeHeap();
+}
+
+uint32_t EspClass::getHeapSize() {
+    return SIM_HEAP_SIZE;
+}
+
+// --- Print -----------------------------------------------------------------------
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    return str ? write((const uint8_t*)str, strlen(str)) : 0;
+}
+
+size_t Print::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t n = vprintf(format, args);
+    va_end(args);
+    return n;
+}
+
+size_t Print::vprintf(const char* format, va_list args) {
+    char small[128];
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(small, sizeof(small), format, copy);
+    va_end(copy);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, len);
+    char* big = (char*)malloc(len + 1);
+    if (!big) return 0;
+    vsnprintf(big, len + 1, format, args);
+    size_t n = write((const uint8_t*)big, len);
+    free(big);
+    return n;
+}
+
+size_t Print::print(const String& s) { return write(s.c_str(), s.length()); }
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(int value, int base) { return print((long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(unsigned long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(long long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(unsigned long long value, int base) { return print(String(value, (unsigned char)base)); }
+size_t Print::print(double value, int digits) { return print(String(value, (unsigned int)digits)); }
+size_t Print::print(const Printable& p) { return p.printTo(*this); }
+
+size_t Print::print(struct tm* timeinfo, const char* format) {
+    const char* f = format ? format : "%c";
+    char buf[64];
+    size_t len = strftime(buf, sizeof(buf), f, timeinfo);
+    return write((const uint8_t*)buf, len);
+}
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const String& s) { return print(s) + println(); }
+size_t Print::println(const char* str) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char value, int base) { return print(value, base) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(long long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
+size_t Print::println(const Printable& p) { return print(p) + println(); }
+size_t Print::println(struct tm* timeinfo, const char* format) { return print(timeinfo, format) + println(); }
+
+// --- IPAddress -------------------------------------------------------------------
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+}
+
+size_t IPAddress::printTo(Print& p) const {
+    return p.print(toString());
+}
+
+// --- String ----------------------------------------------------------------------
+
+String::String(const char* cstr) : buffer(cstr ? cstr : "") {}
+String::String(char c) : buffer(1, c) {}
+String::String(unsigned char value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base)
+    : String(formatInteger(value < 0 && base == 10 ? -(long long)value : (unsigned int)value,
+                           value < 0 && base == 10, base)) {}
+String::String(unsigned int value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base)
+    : String(formatInteger(value < 0 && base == 10 ? -(long long)value : (unsigned long)value,
+                           value < 0 && base == 10, base)) {}
+String::String(unsigned long value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(long long value, unsigned char base)
+    : String(formatInteger(value < 0 && base == 10 ? -(unsigned long long)value : (unsigned long long)value,
+                           value < 0 && base == 10, base)) {}
+String::String(unsigned long long value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(float value, unsigned int decimalPlaces) : String(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned int decimalPlaces) : String(formatFloat(value, decimalPlaces)) {}
+
+String& String::operator=(const char* cstr) {
+    buffer = cstr ? cstr : "";
+    return *this;
+}
+
+bool String::reserve(unsigned int size) {
+    buffer.reserve(size);
+    return true;
+}
+
+bool String::concat(const String& str) {
+    buffer += str.buffer;
+    return true;
+}
+
+bool String::concat(const char* cstr) {
+    if (!cstr) return false;
+    buffer += cstr;
+    return true;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (!cstr) return false;
+    buffer.append(cstr, length);
+    return true;
+}
+
+bool String::concat(char c) {
+    buffer += c;
+    return true;
+}
+
+bool String::equals(const char* cstr) const {
+    return buffer == (cstr ? cstr : "");
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    if (buffer.size() != s.buffer.size()) return false;
+    for (size_t i = 0; i < buffer.size(); i++) {
+        if (tolower((unsigned char)buffer[i]) != tolower((unsigned char)s.buffer[i])) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return buffer.compare(0, prefix.buffer.size(), prefix.buffer) == 0;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > buffer.size()) return false;
+    return buffer.compare(offset, prefix.buffer.size(), prefix.buffer) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.buffer.size() > buffer.size()) return false;
+    return buffer.compare(buffer.size() - suffix.buffer.size(), suffix.buffer.size(), suffix.buffer) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < buffer.size() ? buffer[index] : '\0';
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    size_t pos = buffer.find(ch, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    size_t pos = buffer.find(str.buffer, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    return substring(beginIndex, buffer.size());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= buffer.size()) return String();
+    if (endIndex > buffer.size()) endIndex = buffer.size();
+    return String(buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::toLowerCase() {
+    for (char& c : buffer) c = tolower((unsigned char)c);
+}
+
+void String::trim() {
+    size_t begin = buffer.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        buffer.clear();
+        return;
+    }
+    size_t end = buffer.find_last_not_of(" \t\r\n");
+    buffer = buffer.substr(begin, end - begin + 1);
+}
+
+long String::toInt() const {
+    return strtol(buffer.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return strtof(buffer.c_str(), nullptr);
+}
+
+String operator+(const String& lhs, const String& rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+}
+
+String operator+(const String& lhs, char rhs) {
+    String s(lhs);
+    s.concat(rhs);
+    return s;
+}
@@ -0,0 +1,461 @@
+// async_web_server.cpp - in-process request routing for the host build
+#include <string.h>
+#include <algorithm>
+#include "ESPAsyncWebServer.h"
+#include "sim.h"
+
+namespace {
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string urlDecode(const std::string& in) {
+    std::string out;
+    out.reserve(in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        if (in[i] == '+') {
+            out += ' ';
+        } else if (in[i] == '%' && i + 2 < in.size() && hexValue(in[i + 1]) >= 0 && hexValue(in[i + 2]) >= 0) {
+            out += (char)(hexValue(in[i + 1]) * 16 + hexValue(in[i + 2]));
+            i += 2;
+        } else {
+            out += in[i];
+        }
+    }
+    return out;
+}
+
+WebRequestMethodComposite parseMethod(const char* method) {
+    if (!strcmp(method, "GET")) return HTTP_GET;
+    if (!strcmp(method, "POST")) return HTTP_POST;
+    if (!strcmp(method, "DELETE")) return HTTP_DELETE;
+    if (!strcmp(method, "PUT")) return HTTP_PUT;
+    if (!strcmp(method, "PATCH")) return HTTP_PATCH;
+    if (!strcmp(method, "HEAD")) return HTTP_HEAD;
+    if (!strcmp(method, "OPTIONS")) return HTTP_OPTIONS;
+    return HTTP_ANY;
+}
+
+}  // namespace
+
+// --- Responses -------------------------------------------------------------------
+
+size_t AsyncBasicResponse::fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) {
+    if (index >= _content.length()) return 0;
+    size_t n = std::min(maxLen, (size_t)_content.length() - index);
+    memcpy(buffer, _content.c_str() + index, n);
+    return n;
+}
+
+size_t AsyncProgmemResponse::fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) {
+    if (index >= _len) return 0;
+    size_t n = std::min(maxLen, _len - index);
+    memcpy(buffer, _content + index, n);
+    return n;
+}
+
+size_t AsyncCallbackResponse::fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) {
+    return _callback(buffer, maxLen, index);
+}
+
+size_t AsyncResponseStream::write(uint8_t c) {
+    _content += (char)c;
+    return 1;
+}
+
+size_t AsyncResponseStream::write(const uint8_t* data, size_t len) {
+    _content.append((const char*)data, len);
+    return len;
+}
+
+size_t AsyncResponseStream::fillBuffer(uint8_t* buffer, size_t maxLen, size_t index) {
+    if (index >= _content.size()) return 0;
+    size_t n = std::min(maxLen, _content.size() - index);
+    memcpy(buffer, _content.data() + index, n);
+    return n;
+}
+
+// --- Request ---------------------------------------------------------------------
+
+AsyncWebServerRequest::AsyncWebServerRequest(AsyncWebServer* server, WebRequestMethodComposite method,
+                                             const String& url)
+    : _server(server), _method(method) {
+    const std::string& raw = url.str();
+    size_t q = raw.find('?');
+    _url = String(urlDecode(raw.substr(0, q)));
+    if (q == std::string::npos) return;
+    std::string query = raw.substr(q + 1);
+    size_t start = 0;
+    while (start <= query.size()) {
+        size_t amp = query.find('&', start);
+        if (amp == std::string::npos) amp = query.size();
+        std::string pair = query.substr(start, amp - start);
+        if (!pair.empty()) {
+            size_t eq = pair.find('=');
+            std::string name = urlDecode(pair.substr(0, eq));
+            std::string value = eq == std::string::npos ? "" : urlDecode(pair.substr(eq + 1));
+            _params.emplace_back(String(name), String(value));
+        }
+        start = amp + 1;
+    }
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+    delete _response;
+    if (_tempObject) free(_tempObject);
+}
+
+bool AsyncWebServerRequest::hasHeader(const String& name) const {
+    return getHeader(name) != nullptr;
+}
+
+AsyncWebHeader* AsyncWebServerRequest::getHeader(const String& name) const {
+    for (AsyncWebHeader& h : _headers) {
+        if (h.name().equalsIgnoreCase(name)) return &h;
+    }
+    return nullptr;
+}
+
+const String& AsyncWebServerRequest::header(const char* name) const {
+    static const String empty;
+    AsyncWebHeader* h = getHeader(name);
+    return h ? h->value() : empty;
+}
+
+bool AsyncWebServerRequest::hasParam(const String& name, bool post) const {
+    return getParam(name, post) != nullptr;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool post) const {
+    if (post) return nullptr;
+    for (AsyncWebParameter& p : _params) {
+        if (p.name() == name) return &p;
+    }
+    return nullptr;
+}
+
+const String& AsyncWebServerRequest::arg(const String& name) const {
+    static const String empty;
+    AsyncWebParameter* p = getParam(name);
+    return p ? p->value() : empty;
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+    if (_response) {
+        delete response;
+        return;
+    }
+    _response = response;
+}
+
+void AsyncWebServerRequest::send(int code, const String& contentType, const String& content) {
+    send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::send_P(int code, const String& contentType, const uint8_t* content, size_t len) {
+    send(beginResponse_P(code, contentType, content, len));
+}
+
+void AsyncWebServerRequest::redirect(const String& url) {
+    AsyncWebServerResponse* response = beginResponse(302);
+    response->addHeader("Location", url);
+    send(response);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& contentType,
+                                                             const String& content) {
+    return new AsyncBasicResponse(code, contentType, content);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& contentType,
+                                                               const uint8_t* content, size_t len) {
+    return new AsyncProgmemResponse(code, contentType, content, len);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const String& contentType,
+                                                                    AwsResponseFiller callback) {
+    return new AsyncCallbackResponse(contentType, callback);
+}
+
+AsyncResponseStream* AsyncWebServerRequest::beginResponseStream(const String& contentType, size_t bufferSize) {
+    return new AsyncResponseStream(contentType, bufferSize);
+}
+
+void AsyncWebServerRequest::disconnect() {
+    if (_onDisconnect) _onDisconnect();
+    _onDisconnect = nullptr;
+}
+
+// --- Handlers --------------------------------------------------------------------
+
+bool AsyncCallbackWebHandler::canHandle(AsyncWebServerRequest* request) {
+    if (!_onRequest) return false;
+    if (!(_method & request->method())) return false;
+    if (_uri.length() && _uri.endsWith("*")) {
+        String prefix = _uri.substring(0, _uri.length() - 1);
+        if (!request->url().startsWith(prefix)) return false;
+    } else if (_uri.length() && _uri != request->url() && !request->url().startsWith(_uri + "/")) {
+        return false;
+    }
+    return true;
+}
+
+void AsyncCallbackWebHandler::handleRequest(AsyncWebServerRequest* request) {
+    if (_onRequest) {
+        _onRequest(request);
+    } else {
+        request->send(500);
+    }
+}
+
+void AsyncCallbackWebHandler::handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len,
+                                         size_t index, size_t total) {
+    if (_onBody) _onBody(request, data, len, index, total);
+}
+
+// --- Event source ----------------------------------------------------------------
+
+namespace {
+
+// Same framing as the library's generateEventMessage()
+std::string formatEvent(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+    std::string out;
+    char num[16];
+    if (reconnect) {
+        snprintf(num, sizeof(num), "%u", (unsigned)reconnect);
+        out += "retry: " + std::string(num) + "\r\n";
+    }
+    if (id) {
+        snprintf(num, sizeof(num), "%u", (unsigned)id);
+        out += "id: " + std::string(num) + "\r\n";
+    }
+    if (event) out += "event: " + std::string(event) + "\r\n";
+    if (message) {
+        // Multi-line messages become one data: field per line.
+        const char* line = message;
+        for (;;) {
+            const char* end = strpbrk(line, "\r\n");
+            out += "data: " + std::string(line, end ? end - line : strlen(line)) + "\r\n";
+            if (!end) break;
+            line = end + (end[0] == '\r' && end[1] == '\n' ? 2 : 1);
+        }
+    }
+    out += "\r\n";
+    return out;
+}
+
+}  // namespace
+
+AsyncEventSourceClient::AsyncEventSourceClient(AsyncEventSource* server,
+                                               std::shared_ptr<sim::EventStream> stream, uint32_t lastId)
+    : _server(server), _stream(stream), _lastId(lastId) {
+    _stream->status = 200;
+    _stream->connected = true;
+}
+
+void AsyncEventSourceClient::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+    if (connected()) _stream->text += formatEvent(message, event, id, reconnect);
+}
+
+void AsyncEventSourceClient::close() {
+    _stream->connected = false;
+}
+
+bool AsyncEventSourceClient::connected() const {
+    return _stream->connected;
+}
+
+void AsyncEventSource::close() {
+    for (auto& client : _clients) client->close();
+}
+
+void AsyncEventSource::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+    _clients.remove_if([](const std::unique_ptr<AsyncEventSourceClient>& c) { return !c->connected(); });
+    for (auto& client : _clients) client->send(message, event, id, reconnect);
+}
+
+size_t AsyncEventSource::count() const {
+    size_t n = 0;
+    for (auto& client : _clients) {
+        if (client->connected()) n++;
+    }
+    return n;
+}
+
+bool AsyncEventSource::canHandle(AsyncWebServerRequest* request) {
+    return request->method() == HTTP_GET && request->url() == _url;
+}
+
+void AsyncEventSource::handleRequest(AsyncWebServerRequest* request) {
+    // Only sim::subscribe() can keep a connection open; a plain request
+    // gets the headers and an empty, already closed stream.
+    request->send(200, "text/event-stream");
+}
+
+void AsyncEventSource::connect(std::shared_ptr<sim::EventStream> stream, uint32_t lastId) {
+    _clients.emplace_back(new AsyncEventSourceClient(this, stream, lastId));
+    AsyncEventSourceClient* client = _clients.back().get();
+    if (_connectcb) _connectcb(client);
+}
+
+// --- Server ----------------------------------------------------------------------
+
+AsyncWebServer::~AsyncWebServer() {
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler) {
+    _handlers.push_back(handler);
+    return *handler;
+}
+
+bool AsyncWebServer::removeHandler(AsyncWebHandler* handler) {
+    auto it = std::find(_handlers.begin(), _handlers.end(), handler);
+    if (it == _handlers.end()) return false;
+    _handlers.erase(it);
+    return true;
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, ArRequestHandlerFunction onRequest) {
+    return on(uri, HTTP_ANY, onRequest);
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest) {
+    return on(uri, method, onRequest, nullptr, nullptr);
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest,
+                                            ArUploadHandlerFunction onUpload) {
+    return on(uri, method, onRequest, onUpload, nullptr);
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest,
+                                            ArUploadHandlerFunction onUpload,
+                                            ArBodyHandlerFunction onBody) {
+    _ownedHandlers.emplace_back(new AsyncCallbackWebHandler());
+    AsyncCallbackWebHandler* handler = _ownedHandlers.back().get();
+    handler->setUri(uri);
+    handler->setMethod(method);
+    handler->onRequest(onRequest);
+    handler->onUpload(onUpload);
+    handler->onBody(onBody);
+    addHandler(handler);
+    return *handler;
+}
+
+void AsyncWebServer::reset() {
+    _handlers.clear();
+    _ownedHandlers.clear();
+    _notFound = nullptr;
+}
+
+AsyncWebHandler* AsyncWebServer::findHandler(AsyncWebServerRequest* request) {
+    for (AsyncWebHandler* handler : _handlers) {
+        if (handler->canHandle(request)) return handler;
+    }
+    return nullptr;
+}
+
+void AsyncWebServer::handleNotFound(AsyncWebServerRequest* request) {
+    if (_notFound) {
+        _notFound(request);
+    } else {
+        request->send(404);
+    }
+}
+
+DefaultHeaders& DefaultHeaders::Instance() {
+    static DefaultHeaders instance;
+    return instance;
+}
+
+// --- sim::http -------------------------------------------------------------------
+
+namespace sim {
+
+const std::string* HttpResponse::header(const char* name) const {
+    for (const auto& h : headers) {
+        if (String(h.first.c_str()).equalsIgnoreCase(name)) return &h.second;
+    }
+    return nullptr;
+}
+
+HttpResponse http(AsyncWebServer& server, const char* method, const std::string& url,
+                  const std::string& body, const Headers& headers, const HttpOptions& options) {
+    HttpResponse result;
+    AsyncWebServerRequest request(&server, parseMethod(method), String(url));
+    for (const auto& h : headers) request.addHeader(String(h.first), String(h.second));
+    request.setContentLength(body.size());
+
+    AsyncWebHandler* handler = server.findHandler(&request);
+    if (!handler) {
+        server.handleNotFound(&request);
+    } else {
+        if (!body.empty()) {
+            // Copy each chunk into its own buffer like a TCP segment.
+            size_t chunk = options.bodyChunk ? options.bodyChunk : body.size();
+            size_t end = options.dropAfter ? std::min(options.dropAfter, body.size()) : body.size();
+            for (size_t index = 0; index < end; index += chunk) {
+                size_t len = std::min(chunk, end - index);
+                std::vector<uint8_t> segment(body.begin() + index, body.begin() + index + len);
+                // Not NUL-terminated, no more than a TCP segment is
+                handler->handleBody(&request, segment.data(), len, index, body.size());
+            }
+        }
+        if (options.dropAfter) {
+            request.disconnect();
+            return result;
+        }
+        handler->handleRequest(&request);
+    }
+
+    AsyncWebServerResponse* response = request.response();
+    if (!response) return result;
+
+    result.status = response->code();
+    for (const AsyncWebHeader& h : DefaultHeaders::Instance().headers()) {
+        result.headers.emplace_back(h.name().str(), h.value().str());
+    }
+    if (response->contentType().length()) {
+        result.headers.emplace_back("Content-Type", response->contentType().str());
+    }
+    for (const AsyncWebHeader& h : response->headers()) {
+        result.headers.emplace_back(h.name().str(), h.value().str());
+    }
+
+    std::vector<uint8_t> window(options.sendWindow);
+    for (;;) {
+        size_t n = response->fillBuffer(window.data(), window.size(), result.body.size());
+        if (n == 0) break;
+        result.body.append((const char*)window.data(), n);
+        result.chunks++;
+    }
+    request.disconnect();
+    return result;
+}
+
+std::shared_ptr<EventStream> subscribe(AsyncWebServer& server, const std::string& url, const Headers& headers) {
+    auto stream = std::make_shared<EventStream>();
+    AsyncWebServerRequest request(&server, HTTP_GET, String(url));
+    for (const auto& h : headers) request.addHeader(String(h.first), String(h.second));
+    AsyncEventSource* source = dynamic_cast<AsyncEventSource*>(server.findHandler(&request));
+    if (!source) {
+        stream->status = http(server, "GET", url, std::string(), headers).status;
+        return stream;
+    }
+    const String& lastId = request.header("Last-Event-ID");
+    source->connect(stream, lastId.length() ? (uint32_t)strtoul(lastId.c_str(), nullptr, 10) : 0);
+    return stream;
+}
+
+void unsubscribe(const std::shared_ptr<EventStream>& stream) {
+    stream->connected = false;
+}
+
+}  // namespace sim
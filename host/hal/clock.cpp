@@ -0,0 +1,253 @@
+// clock.cpp - simulated monotonic clock, timers and wall time
+#include <map>
+#include <utility>
+#include "Arduino.h"
+#include "WiFi.h"
+#include "esp_sntp.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "sim.h"
+
+namespace {
+
+uint64_t nowUs = 0;
+sim::TimerId nextTimerId = 1;
+std::multimap<uint64_t, std::pair<sim::TimerId, std::function<void()>>> timers;
+
+// Default to a fixed date so runs are reproducible.
+time_t wallAtBoot = 1717243200;  // 2024-06-01 12:00:00 UTC
+
+// How fast the device's oscillator runs against true time. millis(),
+// micros(), esp_timer and the system clock all count the oscillator.
+int32_t oscillatorPpm = 0;
+
+// Offset from the oscillator to the system clock, set at each SNTP sync.
+bool timeSynced = false;
+int64_t utcOffsetUs = 0;
+sntp_sync_time_cb_t syncCallback = nullptr;
+
+bool sntpRunning = false;
+bool ntpReachable = true;
+uint32_t ntpLatencyMs = 150;
+sim::TimerId sntpTimer = 0;
+
+const uint32_t SNTP_RETRY_MS = 15000;
+const uint32_t SNTP_SYNC_INTERVAL_MS = 3600000;
+
+void sntpAttempt();
+
+int64_t oscillatorMicros() {
+    return (int64_t)nowUs + (int64_t)nowUs * oscillatorPpm / 1000000;
+}
+
+// Seconds since boot until SNTP syncs, UTC afterwards
+int64_t systemMicros() {
+    return oscillatorMicros() + (timeSynced ? utcOffsetUs : 0);
+}
+
+void scheduleSntp(uint32_t delayMs) {
+    if (sntpTimer) sim::cancel(sntpTimer);
+    sntpTimer = sim::schedule(nowUs + (uint64_t)delayMs * 1000, sntpAttempt);
+}
+
+void sntpAttempt() {
+    sntpTimer = 0;
+    if (!sntpRunning) return;
+    if (WiFi.status() == WL_CONNECTED && ntpReachable) {
+        timeSynced = true;
+        utcOffsetUs = sim::utcMicros() - oscillatorMicros();
+        scheduleSntp(SNTP_SYNC_INTERVAL_MS);
+        if (syncCallback) {
+            int64_t us = systemMicros();
+            struct timeval tv = {(time_t)(us / 1000000), (suseconds_t)(us % 1000000)};
+            syncCallback(&tv);
+        }
+    } else {
+        scheduleSntp(SNTP_RETRY_MS);
+    }
+}
+
+}  // namespace
+
+namespace sim {
+
+uint64_t nowMicros() {
+    return nowUs;
+}
+
+void advanceMicros(uint64_t us) {
+    uint64_t target = nowUs + us;
+    while (!timers.empty() && timers.begin()->first <= target) {
+        auto it = timers.begin();
+        if (it->first > nowUs) nowUs = it->first;
+        std::function<void()> fn = std::move(it->second.second);
+        timers.erase(it);
+        fn();
+    }
+    if (target > nowUs) nowUs = target;
+}
+
+void advanceMillis(uint64_t ms) {
+    advanceMicros(ms * 1000);
+}
+
+TimerId schedule(uint64_t atMicros, std::function<void()> fn) {
+    TimerId id = nextTimerId++;
+    timers.emplace(atMicros, std::make_pair(id, std::move(fn)));
+    return id;
+}
+
+uint64_t nextTimerMicros() {
+    return timers.empty() ? UINT64_MAX : timers.begin()->first;
+}
+
+void cancel(TimerId id) {
+    for (auto it = timers.begin(); it != timers.end(); ++it) {
+        if (it->second.first == id) {
+            timers.erase(it);
+            return;
+        }
+    }
+}
+
+void setWallClock(time_t utc) {
+    wallAtBoot = utc - (time_t)(nowUs / 1000000);
+}
+
+time_t wallClock() {
+    return wallAtBoot + (time_t)(nowUs / 1000000);
+}
+
+int64_t utcMicros() {
+    return (int64_t)wallAtBoot * 1000000 + (int64_t)nowUs;
+}
+
+void setOscillatorPpm(int32_t ppm) {
+    oscillatorPpm = ppm;
+}
+
+void setNtpReachable(bool reachable) {
+    ntpReachable = reachable;
+}
+
+void setNtpLatencyMs(uint32_t ms) {
+    ntpLatencyMs = ms;
+}
+
+}  // namespace sim
+
+// Linked with -Wl,--wrap=time and --wrap=gettimeofday so the sketch reads
+// the simulated system time.
+extern "C" time_t __wrap_time(time_t* t) {
+    time_t now = (time_t)(systemMicros() / 1000000);
+    if (t) *t = now;
+    return now;
+}
+
+extern "C" int __wrap_gettimeofday(struct timeval* tv, void*) {
+    int64_t us = systemMicros();
+    tv->tv_sec = (time_t)(us / 1000000);
+    tv->tv_usec = (suseconds_t)(us % 1000000);
+    return 0;
+}
+
+int64_t esp_timer_get_time() {
+    return oscillatorMicros();
+}
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void* arg;
+    sim::TimerId id;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+    if (!args || !args->callback || !out) return ESP_ERR_INVALID_ARG;
+    *out = new esp_timer{args->callback, args->arg, 0};
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    if (timer->id) return ESP_ERR_INVALID_STATE;
+    // timeout_us is counted by the oscillator; convert to true time
+    uint64_t trueUs = (uint64_t)((double)timeout_us * 1000000.0 / (1000000.0 + oscillatorPpm) + 0.5);
+    timer->id = sim::schedule(nowUs + trueUs, [timer] {
+        timer->id = 0;
+        timer->callback(timer->arg);
+    });
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer->id) return ESP_ERR_INVALID_STATE;
+    sim::cancel(timer->id);
+    timer->id = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (timer->id) return ESP_ERR_INVALID_STATE;
+    delete timer;
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+    return timer->id != 0;
+}
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+    syncCallback = callback;
+}
+
+unsigned long millis() {
+    return (unsigned long)(oscillatorMicros() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)oscillatorMicros();
+}
+
+// Like the ESP32 core's, a vTaskDelay(): other tasks run meanwhile
+void delay(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    sim::advanceMicros(us);
+}
+
+void yield() {
+}
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec,
+                const char* server1, const char* server2, const char* server3) {
+    // Same POSIX TZ string the ESP32 core builds.
+    char tz[48];
+    long hours = labs(gmtOffset_sec / 3600);
+    snprintf(tz, sizeof(tz), "UTC%c%02ld", gmtOffset_sec < 0 ? '+' : '-', hours);
+    if (daylightOffset_sec) {
+        long dstHours = labs((gmtOffset_sec + daylightOffset_sec) / 3600);
+        char dst[24];
+        snprintf(dst, sizeof(dst), "DST%c%02ld", (gmtOffset_sec + daylightOffset_sec) < 0 ? '+' : '-', dstHours);
+        strncat(tz, dst, sizeof(tz) - strlen(tz) - 1);
+    }
+    setenv("TZ", tz, 1);
+    tzset();
+
+    sntpRunning = server1 != nullptr;
+    if (sntpRunning) scheduleSntp(ntpLatencyMs);
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+    uint32_t start = millis();
+    time_t now;
+    while ((millis() - start) <= ms) {
+        time(&now);
+        localtime_r(&now, info);
+        if (info->tm_year > (2016 - 1900)) {
+            return true;
+        }
+        delay(10);
+    }
+    return false;
+}
@@ -0,0 +1,88 @@
+// eeprom.cpp - file-backed EEPROM emulation
+#include <stdio.h>
+#include <string>
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "sim.h"
+
+EEPROMClass EEPROM;
+
+namespace {
+
+std::string eepromPath = "eeprom.bin";
+uint32_t flashSectorWriteMs = 45;
+sim::EepromStats stats = {0, 0, 0};
+
+const size_t FLASH_SECTOR_SIZE = 4096;
+
+}  // namespace
+
+namespace sim {
+
+void setEepromPath(const std::string& path) {
+    eepromPath = path;
+}
+
+void setFlashSectorWriteMs(uint32_t ms) {
+    flashSectorWriteMs = ms;
+}
+
+const EepromStats& eepromStats() {
+    return stats;
+}
+
+void resetEepromStats() {
+    stats = EepromStats{0, 0, 0};
+}
+
+}  // namespace sim
+
+bool EEPROMClass::begin(size_t size) {
+    if (size == 0) return false;
+    data.assign(size, 0xFF);
+    FILE* f = fopen(eepromPath.c_str(), "rb");
+    if (f) {
+        size_t n = fread(data.data(), 1, size, f);
+        (void)n;
+        fclose(f);
+    }
+    dirty = false;
+    return true;
+}
+
+void EEPROMClass::end() {
+    commit();
+    data.clear();
+}
+
+uint8_t EEPROMClass::read(int address) {
+    if (address < 0 || (size_t)address >= data.size()) return 0;
+    return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t val) {
+    if (address < 0 || (size_t)address >= data.size()) return;
+    if (data[address] != val) dirty = true;
+    data[address] = val;
+}
+
+bool EEPROMClass::commit() {
+    if (data.empty()) return false;
+    if (!dirty) {
+        stats.skippedCommits++;
+        return true;
+    }
+    FILE* f = fopen(eepromPath.c_str(), "wb");
+    if (!f) return false;
+    size_t n = fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+    if (n != data.size()) return false;
+
+    // The ESP32 core erases and reprograms every sector of the partition.
+    size_t sectors = (data.size() + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE;
+    stats.commits++;
+    stats.bytesWritten += sectors * FLASH_SECTOR_SIZE;
+    dirty = false;
+    delay(sectors * flashSectorWriteMs);
+    return true;
+}
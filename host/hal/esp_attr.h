@@ -0,0 +1,8 @@
+// esp_attr.h - host stand-in for ESP-IDF placement attributes
+//
+// The host has no RTC memory and no reset that keeps RAM, so these only
+// leave the data in ordinary zero-initialized storage.
+#pragma once
+
+#define RTC_NOINIT_ATTR
+#define __NOINIT_ATTR
@@ -0,0 +1,7 @@
+// esp_sntp.h - host stand-in for the ESP-IDF SNTP client hooks
+#pragma once
+#include <sys/time.h>
+
+// Called after each successful SNTP sync, once the system time is set
+typedef void (*sntp_sync_time_cb_t)(struct timeval* tv);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
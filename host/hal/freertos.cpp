@@ -0,0 +1,177 @@
+// freertos.cpp - cooperative tasks and notifications on the simulated clock
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <algorithm>
+#include <vector>
+#include "freertos/task.h"
+#include "sim.h"
+
+#define STACK_FILL 0xA5
+
+enum TaskState {
+    TASK_READY,
+    TASK_BLOCKED,
+    TASK_DELETED
+};
+
+struct tskTaskControlBlock {
+    uint32_t notifyValue = 0;
+    const char* name = "loopTask";
+    UBaseType_t priority = 1;
+    TaskState state = TASK_READY;
+    bool waitNotify = false;        // blocked in ulTaskNotifyTake()
+    uint64_t wakeAt = UINT64_MAX;   // sim time the block times out
+    ucontext_t context;
+    std::vector<uint8_t> stack;     // empty for the loop task
+    TaskFunction_t fn = nullptr;
+    void* arg = nullptr;
+};
+
+namespace {
+
+tskTaskControlBlock loopTask;
+std::vector<TaskHandle_t> tasks = {&loopTask};
+TaskHandle_t current = &loopTask;
+
+bool canRun(TaskHandle_t t) {
+    switch (t->state) {
+        case TASK_READY:
+            return true;
+        case TASK_BLOCKED:
+            return (t->waitNotify && t->notifyValue) || sim::nowMicros() >= t->wakeAt;
+        default:
+            return false;
+    }
+}
+
+// Highest-priority task that can run; among equals, the first after the
+// current one, so tasks of the same priority take turns
+TaskHandle_t pickNext() {
+    size_t start = std::find(tasks.begin(), tasks.end(), current) - tasks.begin();
+    TaskHandle_t best = nullptr;
+    for (size_t k = 1; k <= tasks.size(); k++) {
+        TaskHandle_t t = tasks[(start + k) % tasks.size()];
+        if (canRun(t) && (!best || t->priority > best->priority)) best = t;
+    }
+    return best;
+}
+
+// Gives up the CPU until the current task can run again: runs other tasks
+// meanwhile, or advances the clock when nothing can run
+void reschedule() {
+    TaskHandle_t self = current;
+    for (;;) {
+        TaskHandle_t next = pickNext();
+        if (next) {
+            next->state = TASK_READY;
+            if (next == self) return;
+            current = next;
+            swapcontext(&self->context, &next->context);
+            // Switched back: whoever did so found this task ready
+            return;
+        }
+        uint64_t until = sim::nextTimerMicros();
+        for (TaskHandle_t t : tasks) {
+            if (t->state == TASK_BLOCKED) until = std::min(until, t->wakeAt);
+        }
+        if (until == UINT64_MAX) {
+            fprintf(stderr, "freertos: every task blocked forever with no timers pending\n");
+            abort();
+        }
+        uint64_t now = sim::nowMicros();
+        sim::advanceMicros(until > now ? until - now : 0);
+    }
+}
+
+void block(uint64_t wakeAt, bool waitNotify) {
+    current->state = TASK_BLOCKED;
+    current->wakeAt = wakeAt;
+    current->waitNotify = waitNotify;
+    reschedule();
+    current->waitNotify = false;
+    current->wakeAt = UINT64_MAX;
+}
+
+uint64_t deadlineAfter(TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return UINT64_MAX;
+    return sim::nowMicros() + (uint64_t)ticks * 1000000 / configTICK_RATE_HZ;
+}
+
+void taskEntry() {
+    TaskHandle_t self = current;
+    self->fn(self->arg);
+    // FreeRTOS tasks must not return; treat it as deleting itself
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return current;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreId) {
+    (void)stackDepth;
+    (void)coreId;
+    TaskHandle_t t = new tskTaskControlBlock();
+    t->name = name;
+    t->priority = priority;
+    t->fn = fn;
+    t->arg = arg;
+    t->stack.assign(sim::TASK_STACK_BYTES, STACK_FILL);
+    getcontext(&t->context);
+    t->context.uc_stack.ss_sp = t->stack.data();
+    t->context.uc_stack.ss_size = t->stack.size();
+    t->context.uc_link = nullptr;
+    makecontext(&t->context, taskEntry, 0);
+    tasks.push_back(t);
+    if (created) *created = t;
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    TaskHandle_t t = task ? task : current;
+    if (t == &loopTask) {
+        fprintf(stderr, "freertos: the loop task can't be deleted in the sim\n");
+        abort();
+    }
+    t->state = TASK_DELETED;
+    // The stack is kept: a task deleting itself is still running on it
+    if (t == current) reschedule();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    TaskHandle_t t = task ? task : current;
+    // Stacks grow down: the untouched bytes are at the start
+    size_t untouched = 0;
+    while (untouched < t->stack.size() && t->stack[untouched] == STACK_FILL) untouched++;
+    return untouched;
+}
+
+const char* pcTaskGetName(TaskHandle_t task) {
+    return (task ? task : current)->name;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    task->notifyValue++;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    TaskHandle_t self = current;
+    if (!self->notifyValue && ticksToWait > 0) block(deadlineAfter(ticksToWait), true);
+    uint32_t value = self->notifyValue;
+    if (clearCountOnExit) {
+        self->notifyValue = 0;
+    } else if (value) {
+        self->notifyValue--;
+    }
+    return value;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    block(deadlineAfter(ticks), false);
+}
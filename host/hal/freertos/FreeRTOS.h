@@ -0,0 +1,23 @@
+// FreeRTOS.h - host stand-in for the ESP-IDF FreeRTOS base types
+#pragma once
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+
+// Same tick rate as the Arduino ESP32 core (CONFIG_FREERTOS_HZ)
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+// ESP32 cores: Wi-Fi and the system tasks run on PRO_CPU, Arduino's loop
+// task on APP_CPU
+#define PRO_CPU_NUM 0
+#define APP_CPU_NUM 1
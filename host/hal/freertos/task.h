@@ -0,0 +1,30 @@
+// task.h - host stand-in for FreeRTOS tasks and task notifications
+//
+// Tasks are cooperative coroutines on the sim clock. setup()/loop() run as
+// the loop task; xTaskCreatePinnedToCore() adds more. A task runs until it
+// blocks (ulTaskNotifyTake(), vTaskDelay(), delay()); the highest-priority
+// task that can run goes next, and when none can, the sim clock advances to
+// the next timer or wake-up, firing timers on the way. A notification given
+// from a timer (e.g. an injected HTTP request) so ends a wait early just as
+// it would on the device. Core affinity is recorded but not modelled.
+#pragma once
+#include "FreeRTOS.h"
+
+struct tskTaskControlBlock;
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreId);
+void vTaskDelete(TaskHandle_t task);
+// Bytes of the task's stack never touched so far (ESP-IDF counts bytes).
+// The host stacks are larger than the firmware asks for, as x86-64 frames
+// are, so only the trend means anything; 0 for the loop task.
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+const char* pcTaskGetName(TaskHandle_t task);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+void vTaskDelay(TickType_t ticks);
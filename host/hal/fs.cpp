@@ -0,0 +1,251 @@
+// fs.cpp - host directory backed SPIFFS
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "SPIFFS.h"
+#include "sim.h"
+
+fs::SPIFFSFS SPIFFS;
+
+namespace {
+
+std::string spiffsRoot = "spiffs";
+bool mounted = false;
+
+std::string hostPath(const char* path) {
+    std::string p = path ? path : "";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return spiffsRoot + p;
+}
+
+void makeParents(const std::string& full) {
+    for (size_t pos = spiffsRoot.size() + 1; (pos = full.find('/', pos)) != std::string::npos; pos++) {
+        ::mkdir(full.substr(0, pos).c_str(), 0755);
+    }
+}
+
+bool isDir(const std::string& full) {
+    struct stat st;
+    return stat(full.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+}  // namespace
+
+namespace sim {
+
+void setSpiffsRoot(const std::string& path) {
+    spiffsRoot = path;
+}
+
+}  // namespace sim
+
+namespace fs {
+
+class FileImpl {
+public:
+    ~FileImpl() { close(); }
+    void close() {
+        if (file) fclose(file);
+        file = nullptr;
+        if (dir) closedir(dir);
+        dir = nullptr;
+    }
+
+    FILE* file = nullptr;
+    DIR* dir = nullptr;
+    std::string path;
+};
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!impl || !impl->file) return 0;
+    return fwrite(buf, 1, size, impl->file);
+}
+
+int File::available() {
+    if (!impl || !impl->file) return 0;
+    return (int)(size() - position());
+}
+
+int File::read() {
+    if (!impl || !impl->file) return -1;
+    return fgetc(impl->file);
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!impl || !impl->file) return 0;
+    return fread(buf, 1, size, impl->file);
+}
+
+void File::flush() {
+    if (impl && impl->file) fflush(impl->file);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!impl || !impl->file) return false;
+    int whence = mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END;
+    return fseek(impl->file, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!impl || !impl->file) return 0;
+    long pos = ftell(impl->file);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    if (!impl || !impl->file) return 0;
+    long cur = ftell(impl->file);
+    fseek(impl->file, 0, SEEK_END);
+    long end = ftell(impl->file);
+    fseek(impl->file, cur, SEEK_SET);
+    return end < 0 ? 0 : (size_t)end;
+}
+
+void File::close() {
+    if (impl) impl->close();
+    impl.reset();
+}
+
+File::operator bool() const {
+    return impl && (impl->file || impl->dir);
+}
+
+const char* File::path() const {
+    return impl ? impl->path.c_str() : "";
+}
+
+const char* File::name() const {
+    if (!impl) return "";
+    size_t slash = impl->path.rfind('/');
+    return impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const {
+    return impl && impl->dir;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!impl || !impl->dir) return File();
+    while (struct dirent* entry = readdir(impl->dir)) {
+        if (entry->d_name[0] == '.') continue;
+        std::string child = impl->path == "/" ? "/" + std::string(entry->d_name)
+                                              : impl->path + "/" + entry->d_name;
+        return SPIFFS.open(child.c_str(), mode);
+    }
+    return File();
+}
+
+void File::rewindDirectory() {
+    if (impl && impl->dir) rewinddir(impl->dir);
+}
+
+File FS::open(const char* path, const char* mode, const bool create) {
+    if (!mounted) return File();
+    std::string full = hostPath(path);
+    auto impl = std::make_shared<FileImpl>();
+    impl->path = path;
+    if (isDir(full)) {
+        impl->dir = opendir(full.c_str());
+        return impl->dir ? File(impl) : File();
+    }
+    std::string m = mode ? mode : "r";
+    if (m[0] != 'r' || create) makeParents(full);
+    m += "b";
+    impl->file = fopen(full.c_str(), m.c_str());
+    return impl->file ? File(impl) : File();
+}
+
+bool FS::exists(const char* path) {
+    struct stat st;
+    return mounted && stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    return mounted && ::unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    if (!mounted) return false;
+    std::string to = hostPath(pathTo);
+    makeParents(to);
+    return ::rename(hostPath(pathFrom).c_str(), to.c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    if (!mounted) return false;
+    std::string full = hostPath(path);
+    makeParents(full);
+    return ::mkdir(full.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool FS::rmdir(const char* path) {
+    return mounted && ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+bool SPIFFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel) {
+    ::mkdir(spiffsRoot.c_str(), 0755);
+    mounted = isDir(spiffsRoot);
+    return mounted;
+}
+
+bool SPIFFSFS::format() {
+    if (!mounted) return false;
+    std::vector<std::string> stack{spiffsRoot};
+    std::vector<std::string> dirs;
+    while (!stack.empty()) {
+        std::string dirPath = stack.back();
+        stack.pop_back();
+        dirs.push_back(dirPath);
+        DIR* d = opendir(dirPath.c_str());
+        if (!d) continue;
+        while (struct dirent* entry = readdir(d)) {
+            if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) continue;
+            std::string child = dirPath + "/" + entry->d_name;
+            if (isDir(child)) stack.push_back(child);
+            else ::unlink(child.c_str());
+        }
+        closedir(d);
+    }
+    for (size_t i = dirs.size(); i-- > 1;) ::rmdir(dirs[i].c_str());
+    return true;
+}
+
+size_t SPIFFSFS::totalBytes() {
+    return 1408 * 1024;
+}
+
+size_t SPIFFSFS::usedBytes() {
+    size_t used = 0;
+    std::vector<std::string> stack{spiffsRoot};
+    while (!stack.empty()) {
+        std::string dirPath = stack.back();
+        stack.pop_back();
+        DIR* d = opendir(dirPath.c_str());
+        if (!d) continue;
+        while (struct dirent* entry = readdir(d)) {
+            if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) continue;
+            std::string child = dirPath + "/" + entry->d_name;
+            struct stat st;
+            if (stat(child.c_str(), &st) != 0) continue;
+            if (S_ISDIR(st.st_mode)) stack.push_back(child);
+            else used += st.st_size;
+        }
+        closedir(d);
+    }
+    return used;
+}
+
+void SPIFFSFS::end() {
+    mounted = false;
+}
+
+}  // namespace fs
@@ -0,0 +1,296 @@
+// json.cpp - parser behind the ArduinoJson host stand-in
+#include <stdlib.h>
+#include <ArduinoJson.h>
+
+using ArduinoJson::detail::Node;
+using ArduinoJson::detail::NodeType;
+
+namespace {
+
+const int MAX_NESTING = 10;
+
+class Parser {
+public:
+    Parser(JsonDocument& doc, const char* p, const char* end) : doc(doc), p(p), end(end) {}
+
+    DeserializationError parse() {
+        doc.clear();
+        skipSpace();
+        if (p >= end) return DeserializationError::EmptyInput;
+        int root = doc.allocNode();
+        if (root < 0) return DeserializationError::NoMemory;
+        return parseValue(root, 0);
+    }
+
+private:
+    JsonDocument& doc;
+    const char* p;
+    const char* end;
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    }
+
+    DeserializationError parseValue(int index, int depth) {
+        if (depth > MAX_NESTING) return DeserializationError::TooDeep;
+        skipSpace();
+        if (p >= end) return DeserializationError::IncompleteInput;
+        switch (*p) {
+            case '{': return parseObject(index, depth);
+            case '[': return parseArray(index, depth);
+            case '"':
+            case '\'': {
+                std::string s;
+                DeserializationError err = parseString(s);
+                if (err) return err;
+                doc.node(index).type = NodeType::String;
+                doc.node(index).string = s;
+                return DeserializationError::Ok;
+            }
+            case 't': return parseLiteral(index, "true");
+            case 'f': return parseLiteral(index, "false");
+            case 'n': return parseLiteral(index, "null");
+            default: return parseNumber(index);
+        }
+    }
+
+    DeserializationError parseLiteral(int index, const char* word) {
+        size_t len = strlen(word);
+        if ((size_t)(end - p) < len) {
+            return strncmp(p, word, end - p) == 0 ? DeserializationError::IncompleteInput
+                                                  : DeserializationError::InvalidInput;
+        }
+        if (strncmp(p, word, len) != 0) return DeserializationError::InvalidInput;
+        p += len;
+        Node& n = doc.node(index);
+        if (word[0] == 'n') {
+            n.type = NodeType::Null;
+        } else {
+            n.type = NodeType::Bool;
+            n.boolean = word[0] == 't';
+        }
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError parseNumber(int index) {
+        const char* start = p;
+        bool isFloat = false;
+        if (p < end && (*p == '-' || *p == '+')) p++;
+        while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' ||
+                           ((*p == '-' || *p == '+') && (p[-1] == 'e' || p[-1] == 'E')))) {
+            if (*p == '.' || *p == 'e' || *p == 'E') isFloat = true;
+            p++;
+        }
+        if (p == start) return DeserializationError::InvalidInput;
+        std::string text(start, p - start);
+        char* parsedEnd = nullptr;
+        Node& n = doc.node(index);
+        if (isFloat) {
+            n.type = NodeType::Float;
+            n.real = strtod(text.c_str(), &parsedEnd);
+        } else {
+            n.type = NodeType::Integer;
+            n.integer = strtoll(text.c_str(), &parsedEnd, 10);
+        }
+        if (parsedEnd != text.c_str() + text.size()) return DeserializationError::InvalidInput;
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError parseString(std::string& out) {
+        char quote = *p++;
+        while (p < end && *p != quote) {
+            if (*p == '\\') {
+                p++;
+                if (p >= end) return DeserializationError::IncompleteInput;
+                switch (*p) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': {
+                        if (end - p < 5) return DeserializationError::IncompleteInput;
+                        unsigned code = strtoul(std::string(p + 1, 4).c_str(), nullptr, 16);
+                        if (code < 0x80) {
+                            out += (char)code;
+                        } else if (code < 0x800) {
+                            out += (char)(0xC0 | (code >> 6));
+                            out += (char)(0x80 | (code & 0x3F));
+                        } else {
+                            out += (char)(0xE0 | (code >> 12));
+                            out += (char)(0x80 | ((code >> 6) & 0x3F));
+                            out += (char)(0x80 | (code & 0x3F));
+                        }
+                        p += 4;
+                        break;
+                    }
+                    default: out += *p; break;
+                }
+                p++;
+            } else {
+                out += *p++;
+            }
+        }
+        if (p >= end) return DeserializationError::IncompleteInput;
+        p++;
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError parseArray(int index, int depth) {
+        p++;
+        doc.node(index).type = NodeType::Array;
+        skipSpace();
+        if (p < end && *p == ']') {
+            p++;
+            return DeserializationError::Ok;
+        }
+        for (;;) {
+            int child = doc.allocNode();
+            if (child < 0) return DeserializationError::NoMemory;
+            doc.node(index).children.push_back(child);
+            DeserializationError err = parseValue(child, depth + 1);
+            if (err) return err;
+            skipSpace();
+            if (p >= end) return DeserializationError::IncompleteInput;
+            if (*p == ',') {
+                p++;
+                continue;
+            }
+            if (*p == ']') {
+                p++;
+                return DeserializationError::Ok;
+            }
+            return DeserializationError::InvalidInput;
+        }
+    }
+
+    DeserializationError parseObject(int index, int depth) {
+        p++;
+        doc.node(index).type = NodeType::Object;
+        skipSpace();
+        if (p < end && *p == '}') {
+            p++;
+            return DeserializationError::Ok;
+        }
+        for (;;) {
+            skipSpace();
+            if (p >= end) return DeserializationError::IncompleteInput;
+            if (*p != '"' && *p != '\'') return DeserializationError::InvalidInput;
+            std::string key;
+            DeserializationError err = parseString(key);
+            if (err) return err;
+            skipSpace();
+            if (p >= end) return DeserializationError::IncompleteInput;
+            if (*p != ':') return DeserializationError::InvalidInput;
+            p++;
+            int child = doc.allocNode();
+            if (child < 0) return DeserializationError::NoMemory;
+            doc.node(child).key = key;
+            doc.node(index).children.push_back(child);
+            err = parseValue(child, depth + 1);
+            if (err) return err;
+            skipSpace();
+            if (p >= end) return DeserializationError::IncompleteInput;
+            if (*p == ',') {
+                p++;
+                continue;
+            }
+            if (*p == '}') {
+                p++;
+                return DeserializationError::Ok;
+            }
+            return DeserializationError::InvalidInput;
+        }
+    }
+};
+
+}  // namespace
+
+int JsonDocument::allocNode() {
+    if ((_nodes.size() + 1) * kSlotSize > _capacity) {
+        _overflowed = true;
+        return -1;
+    }
+    _nodes.emplace_back();
+    return (int)_nodes.size() - 1;
+}
+
+const Node* JsonVariantConst::node() const {
+    if (!_doc || _index < 0) return nullptr;
+    return &_doc->node(_index);
+}
+
+bool JsonVariantConst::isNull() const {
+    const Node* n = node();
+    return !n || n->type == NodeType::Null;
+}
+
+bool JsonVariantConst::hasMember(const char* key) const {
+    const Node* n = node();
+    if (!n || n->type != NodeType::Object || !key) return false;
+    for (int child : n->children) {
+        if (_doc->node(child).key == key) return true;
+    }
+    return false;
+}
+
+JsonVariantConst JsonVariantConst::operator[](const char* key) const {
+    const Node* n = node();
+    if (!n || n->type != NodeType::Object || !key) return JsonVariantConst();
+    for (int child : n->children) {
+        if (_doc->node(child).key == key) return JsonVariantConst(_doc, child);
+    }
+    return JsonVariantConst();
+}
+
+JsonVariantConst JsonVariantConst::operator[](size_t index) const {
+    const Node* n = node();
+    if (!n || n->type != NodeType::Array || index >= n->children.size()) return JsonVariantConst();
+    return JsonVariantConst(_doc, n->children[index]);
+}
+
+size_t JsonVariantConst::size() const {
+    const Node* n = node();
+    if (!n || (n->type != NodeType::Array && n->type != NodeType::Object)) return 0;
+    return n->children.size();
+}
+
+JsonArrayConst::iterator JsonArrayConst::begin() const {
+    const Node* n = _v.node();
+    if (!n || n->type != NodeType::Array) return iterator(nullptr, nullptr);
+    return iterator(_v._doc, n->children.data());
+}
+
+JsonArrayConst::iterator JsonArrayConst::end() const {
+    const Node* n = _v.node();
+    if (!n || n->type != NodeType::Array) return iterator(nullptr, nullptr);
+    return iterator(_v._doc, n->children.data() + n->children.size());
+}
+
+const char* DeserializationError::c_str() const {
+    static const char* const messages[] = {
+        "Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep"};
+    return messages[_code];
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+    if (!input) return DeserializationError::EmptyInput;
+    return deserializeJson(doc, input, strlen(input));
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t inputSize) {
+    if (!input) return DeserializationError::EmptyInput;
+    // Like ArduinoJson, a NUL ends the input even when a size is given.
+    const char* nul = (const char*)memchr(input, '\0', inputSize);
+    const char* end = nul ? nul : input + inputSize;
+    Parser parser(doc, input, end);
+    return parser.parse();
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* input, size_t inputSize) {
+    return deserializeJson(doc, (const char*)input, inputSize);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const String& input) {
+    return deserializeJson(doc, input.c_str(), input.length());
+}
@@ -0,0 +1,148 @@
+// sim.h - control surface of the host simulation
+//
+// The HAL shim runs on a simulated clock: nothing sleeps, delay() and the
+// helpers below move time forward and fire whatever timers fall due. The
+// sim and bench drivers use this header to set up the world the sketch sees
+// (Wi-Fi, NTP, storage locations) and to inject HTTP requests.
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "esp_system.h"
+
+class AsyncWebServer;
+
+namespace sim {
+
+// --- Clock ---------------------------------------------------------------------
+
+uint64_t nowMicros();
+void advanceMicros(uint64_t us);
+void advanceMillis(uint64_t ms);
+
+// Runs fn once the sim clock reaches atMicros. Timers fire from inside
+// advanceMicros() in deadline order.
+typedef uint32_t TimerId;
+TimerId schedule(uint64_t atMicros, std::function<void()> fn);
+void cancel(TimerId id);
+// Deadline of the earliest pending timer, UINT64_MAX if there is none.
+uint64_t nextTimerMicros();
+
+// True UTC at boot. The sketch only sees it after an NTP sync completes.
+void setWallClock(time_t utc);
+time_t wallClock();
+int64_t utcMicros();
+
+// Error of the device oscillator behind millis(), esp_timer and the system
+// clock; positive runs fast. SNTP syncs step the system clock back to UTC.
+void setOscillatorPpm(int32_t ppm);
+
+// --- Network -------------------------------------------------------------------
+
+void setWifiAvailable(bool available);
+void setWifiConnectLatencyMs(uint32_t ms);
+void setNtpReachable(bool reachable);
+void setNtpLatencyMs(uint32_t ms);
+
+// --- GPIO ----------------------------------------------------------------------
+
+uint8_t pinLevel(uint8_t pin);
+typedef std::function<void(uint8_t pin, uint8_t level, uint64_t atMicros)> PinWriteHook;
+void setPinWriteHook(PinWriteHook hook);
+
+// --- I2C ---------------------------------------------------------------------
+
+// Register reg of the device at address on Wire (bus 0) or Wire1 (bus 1),
+// as last written; 0 if never written.
+uint8_t i2cRegister(uint8_t bus, uint8_t address, uint8_t reg);
+
+struct I2cStats {
+    uint32_t transactions;
+    uint64_t bytes;         // register pointer and data, not the address
+    uint64_t busMicros;     // time the bus was busy at the set clock
+};
+const I2cStats& i2cStats();
+void resetI2cStats();
+
+// --- Storage -------------------------------------------------------------------
+
+void setEepromPath(const std::string& path);
+void setSpiffsRoot(const std::string& path);
+
+// Simulated cost of one flash sector erase+program during EEPROM.commit().
+void setFlashSectorWriteMs(uint32_t ms);
+
+struct EepromStats {
+    uint32_t commits;
+    uint32_t skippedCommits;
+    uint64_t bytesWritten;
+};
+const EepromStats& eepromStats();
+void resetEepromStats();
+
+// --- Serial --------------------------------------------------------------------
+
+// nullptr mutes Serial output.
+void setSerialOutput(FILE* out);
+
+// --- Tasks ---------------------------------------------------------------------
+
+// Host stacks are this big whatever the firmware asks for: glibc's printf
+// alone needs more than a typical ESP32 task budget on x86-64.
+const unsigned TASK_STACK_BYTES = 256 * 1024;
+
+// --- Restart -------------------------------------------------------------------
+
+// Thrown by ESP.restart() so drivers can decide what a reboot means.
+struct Restart {};
+
+// What esp_reset_reason() reports, for a driver modelling a reboot
+void setResetReason(esp_reset_reason_t reason);
+
+// --- HTTP ----------------------------------------------------------------------
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+struct HttpResponse {
+    int status = 0;
+    Headers headers;
+    std::string body;
+    size_t chunks = 0;
+
+    const std::string* header(const char* name) const;
+};
+
+struct HttpOptions {
+    // Size of each onBody() call; 0 delivers the body in one piece.
+    size_t bodyChunk = 0;
+    // Drop the connection after this many body bytes, before the request
+    // handler runs, as a client that goes away mid-upload does; 0 never.
+    size_t dropAfter = 0;
+    // Size of the buffer handed to response fillers.
+    size_t sendWindow = 1436;
+};
+
+HttpResponse http(AsyncWebServer& server, const char* method, const std::string& url,
+                  const std::string& body = std::string(), const Headers& headers = Headers(),
+                  const HttpOptions& options = HttpOptions());
+
+// An open text/event-stream connection. The server appends to text until
+// either side closes it.
+struct EventStream {
+    int status = 0;
+    bool connected = false;
+    std::string text;
+};
+
+// GETs an AsyncEventSource URL and keeps the connection open; any other
+// route is answered like http() and comes back closed.
+std::shared_ptr<EventStream> subscribe(AsyncWebServer& server, const std::string& url,
+                                       const Headers& headers = Headers());
+void unsubscribe(const std::shared_ptr<EventStream>& stream);
+
+}  // namespace sim
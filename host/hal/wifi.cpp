@@ -0,0 +1,113 @@
+// wifi.cpp - simulated station interface
+#include <vector>
+#include "Arduino.h"
+#include "WiFi.h"
+#include "sim.h"
+
+WiFiClass WiFi;
+
+namespace {
+
+bool apAvailable = true;
+uint32_t connectLatencyMs = 1200;
+bool connecting = false;
+bool connected = false;
+sim::TimerId connectTimer = 0;
+
+struct EventHandler {
+    WiFiEventCb callback;
+    arduino_event_id_t event;
+};
+std::vector<EventHandler> handlers;
+
+void fire(arduino_event_id_t event) {
+    for (const EventHandler& h : handlers) {
+        if (h.event == ARDUINO_EVENT_MAX || h.event == event) h.callback(event);
+    }
+}
+
+// Ends an association attempt: connected if the AP is there, otherwise the
+// "no AP found" disconnect the driver reports after its scan
+void finishConnect() {
+    connectTimer = 0;
+    connecting = false;
+    connected = apAvailable;
+    if (connected) {
+        fire(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+        fire(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    } else {
+        fire(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+}  // namespace
+
+namespace sim {
+
+void setWifiAvailable(bool available) {
+    apAvailable = available;
+    if (!available && connected) {
+        connected = false;
+        fire(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+void setWifiConnectLatencyMs(uint32_t ms) {
+    connectLatencyMs = ms;
+}
+
+}  // namespace sim
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase) {
+    if (connectTimer) sim::cancel(connectTimer);
+    connected = false;
+    connecting = true;
+    connectTimer = sim::schedule(sim::nowMicros() + (uint64_t)connectLatencyMs * 1000, finishConnect);
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::disconnect(bool wifioff) {
+    if (connectTimer) sim::cancel(connectTimer);
+    bool wasUp = connected || connecting;
+    connectTimer = 0;
+    connecting = false;
+    connected = false;
+    if (wasUp) fire(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    return true;
+}
+
+bool WiFiClass::reconnect() {
+    begin(nullptr);
+    return true;
+}
+
+// The sim never reconnects on its own, so there is nothing to turn off
+bool WiFiClass::setAutoReconnect(bool autoReconnect) {
+    return true;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb callback, arduino_event_id_t event) {
+    handlers.push_back({callback, event});
+    return (wifi_event_id_t)handlers.size();
+}
+
+bool WiFiClass::mode(wifi_mode_t m) {
+    return true;
+}
+
+bool WiFiClass::setTxPower(wifi_power_t power) {
+    return true;
+}
+
+wl_status_t WiFiClass::status() {
+    if (connected) return WL_CONNECTED;
+    return connecting ? WL_DISCONNECTED : WL_CONNECTION_LOST;
+}
+
+IPAddress WiFiClass::localIP() {
+    return connected ? IPAddress(192, 168, 1, 50) : IPAddress();
+}
+
+int8_t WiFiClass::RSSI() {
+    return connected ? -58 : 0;
+}
@@ -0,0 +1,81 @@
+// wire.cpp - I2C writes into simulated device register files
+#include <map>
+#include "Wire.h"
+#include "sim.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+namespace {
+
+struct Device {
+    uint8_t registers[256];
+};
+
+// (bus << 8 | address) -> device, created on first write
+std::map<uint16_t, Device> devices;
+sim::I2cStats stats = {0, 0, 0};
+
+}  // namespace
+
+namespace sim {
+
+uint8_t i2cRegister(uint8_t bus, uint8_t address, uint8_t reg) {
+    auto it = devices.find(bus << 8 | address);
+    return it == devices.end() ? 0 : it->second.registers[reg];
+}
+
+const I2cStats& i2cStats() {
+    return stats;
+}
+
+void resetI2cStats() {
+    stats = I2cStats{0, 0, 0};
+}
+
+}  // namespace sim
+
+bool TwoWire::begin(int, int, uint32_t frequency) {
+    if (frequency) clock = frequency;
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+    clock = frequency;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint8_t addr) {
+    started = true;
+    address = addr;
+    pending.clear();
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (!started) return 0;
+    pending.push_back(data);
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t len) {
+    if (!started) return 0;
+    pending.insert(pending.end(), data, data + len);
+    return len;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+    if (!started) return 4;
+    started = false;
+    // The first byte sets the register pointer, the rest are written from
+    // there on
+    if (!pending.empty()) {
+        Device& device = devices[bus << 8 | address];
+        uint8_t reg = pending[0];
+        for (size_t i = 1; i < pending.size(); i++) device.registers[reg++] = pending[i];
+    }
+    // Address byte plus data, nine clocks each, plus start and stop
+    stats.transactions++;
+    stats.bytes += pending.size();
+    stats.busMicros += ((pending.size() + 1) * 9 + 2) * 1000000ULL / clock;
+    return 0;
+}
@@ -0,0 +1,236 @@
+// sim_main.cpp - runs the sketch's setup()/loop() on simulated time
+//
+// Usage: wmp_sim [--days N] [--quiet] [--state PREFIX] [--keep-state]
+//               [--water-now SECONDS] [--drift-ppm PPM]
+//               [--ntp-outage FROM_SECONDS FOR_SECONDS]
+//               [--wifi-outage FROM_SECONDS FOR_SECONDS]
+//               [--max-dose-error-ms MS]
+//
+// State (EEPROM image, SPIFFS directory) starts empty unless --keep-state is
+// given; the simulated wall clock always starts at the same instant.
+//
+// Reports how many doses each pump delivered, how far each dose's measured
+// on-time was from its target (exiting with status 4 if any dose is off by
+// more than --max-dose-error-ms, default 1 ms), the host time the run took,
+// how much of each task's stack was never touched, the most pumps seen
+// running at once against the power budget, and what a dashboard
+// subscribed to /api/events received. A POST /api/plants/water-now for
+// pump 1 is injected at --water-now seconds (default 36 h) to measure how
+// quickly the sleeping loop reacts. The time base is sampled once a minute
+// against true UTC, next to the system clock it replaced, with the
+// oscillator off by --drift-ppm and NTP unreachable during --ntp-outage.
+// --wifi-outage takes the access point away.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "sim.h"
+#include "water_my_plants.h"
+
+void setup();
+void loop();
+
+namespace {
+
+struct PumpTrace {
+    uint64_t onAt = 0;
+    unsigned doses = 0;
+    double totalOnMs = 0;
+    double maxErrorMs = 0;
+    double sumErrorMs = 0;
+};
+
+std::vector<PumpTrace> traces;
+
+// Pumps switched on at once, now and at worst, and the shortest gap
+// between two pumps switching on
+int pumpsOn = 0;
+int maxPumpsOn = 0;
+uint64_t lastPumpOnAt = 0;
+uint64_t minStartGapUs = UINT64_MAX;
+
+// Time the injected water-now request was made, and when pump 1 responded
+uint64_t waterNowAt = 0;
+uint64_t waterNowPumpOnAt = 0;
+
+// Worst error against true UTC seen by the once-a-minute sampler, from six
+// hours in so the time base has had a few syncs to learn the drift
+double maxTimeBaseErrorMs = 0;
+double maxSystemClockErrorMs = 0;
+
+void sampleClocks() {
+    if (timeValid() && sim::nowMicros() >= 6ULL * 3600 * 1000000) {
+        int64_t utc = sim::utcMicros();
+        struct timeval tv;
+        gettimeofday(&tv, nullptr);
+        int64_t system = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+        maxTimeBaseErrorMs = max(maxTimeBaseErrorMs, llabs(timeNowMicros() - utc) / 1000.0);
+        maxSystemClockErrorMs = max(maxSystemClockErrorMs, llabs(system - utc) / 1000.0);
+    }
+    sim::schedule(sim::nowMicros() + 60000000, sampleClocks);
+}
+
+int pumpForPin(uint8_t pin) {
+    for (int i = 0; i < numPumps; i++) {
+        if (pumps[i].in1 == pin) return i;
+    }
+    return -1;
+}
+
+void onPinWrite(uint8_t pin, uint8_t level, uint64_t atMicros) {
+    int i = pumpForPin(pin);
+    if (i < 0) return;
+    // Sized on the first write, once setup() has read the zone table
+    if ((int)traces.size() < numPumps) traces.resize(numPumps);
+    PumpTrace& t = traces[i];
+    if (level == HIGH) {
+        if (!t.onAt) {
+            t.onAt = atMicros;
+            if (lastPumpOnAt) minStartGapUs = min(minStartGapUs, atMicros - lastPumpOnAt);
+            lastPumpOnAt = atMicros;
+            maxPumpsOn = max(maxPumpsOn, ++pumpsOn);
+        }
+        if (i == 0 && waterNowAt && !waterNowPumpOnAt) waterNowPumpOnAt = atMicros;
+        return;
+    }
+    if (!t.onAt) return;
+    pumpsOn--;
+    double onMs = (atMicros - t.onAt) / 1000.0;
+    double targetMs = pumps[i].plant->ozPerWatering * MILLIS_PER_OZ;
+    double error = onMs - targetMs;
+    t.doses++;
+    t.totalOnMs += onMs;
+    t.sumErrorMs += error;
+    if (fabs(error) > t.maxErrorMs) t.maxErrorMs = fabs(error);
+    t.onAt = 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    double days = 7;
+    bool quiet = false;
+    bool keepState = false;
+    double waterNowSeconds = 36 * 3600;
+    int32_t driftPpm = 0;
+    double outageFrom = 0;
+    double outageFor = 0;
+    double wifiOutageFrom = 0;
+    double wifiOutageFor = 0;
+    double maxDoseErrorMs = 1;
+    std::string stateDir = "sim_state";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--days") && i + 1 < argc) {
+            days = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--quiet")) {
+            quiet = true;
+        } else if (!strcmp(argv[i], "--state") && i + 1 < argc) {
+            stateDir = argv[++i];
+        } else if (!strcmp(argv[i], "--keep-state")) {
+            keepState = true;
+        } else if (!strcmp(argv[i], "--water-now") && i + 1 < argc) {
+            waterNowSeconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--drift-ppm") && i + 1 < argc) {
+            driftPpm = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--ntp-outage") && i + 2 < argc) {
+            outageFrom = atof(argv[++i]);
+            outageFor = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--wifi-outage") && i + 2 < argc) {
+            wifiOutageFrom = atof(argv[++i]);
+            wifiOutageFor = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--max-dose-error-ms") && i + 1 < argc) {
+            maxDoseErrorMs = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--days N] [--quiet] [--state PREFIX] [--keep-state] [--water-now SECONDS]\n"
+                            "       [--drift-ppm PPM] [--ntp-outage FROM_SECONDS FOR_SECONDS]\n"
+                            "       [--wifi-outage FROM_SECONDS FOR_SECONDS] [--max-dose-error-ms MS]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    sim::setSerialOutput(quiet ? nullptr : stdout);
+    sim::setEepromPath(stateDir + "-eeprom.bin");
+    sim::setSpiffsRoot(stateDir + "-spiffs");
+    if (!keepState) {
+        remove((stateDir + "-eeprom.bin").c_str());
+        if (SPIFFS.begin(true)) SPIFFS.format();
+        SPIFFS.end();
+    }
+    sim::setOscillatorPpm(driftPpm);
+    if (outageFor > 0) {
+        sim::schedule((uint64_t)(outageFrom * 1e6), [] { sim::setNtpReachable(false); });
+        sim::schedule((uint64_t)((outageFrom + outageFor) * 1e6), [] { sim::setNtpReachable(true); });
+    }
+    if (wifiOutageFor > 0) {
+        sim::schedule((uint64_t)(wifiOutageFrom * 1e6), [] { sim::setWifiAvailable(false); });
+        sim::schedule((uint64_t)((wifiOutageFrom + wifiOutageFor) * 1e6), [] { sim::setWifiAvailable(true); });
+    }
+    sampleClocks();
+    sim::setPinWriteHook(onPinWrite);
+    sim::schedule((uint64_t)(waterNowSeconds * 1e6), [] {
+        waterNowAt = sim::nowMicros();
+        sim::http(server, "POST", "/api/plants/water-now", "{\"plantIndex\":0}");
+    });
+
+    // loop() sleeps an hour at a time while the control and service tasks
+    // run; the run ends at the first loop() return past the end
+    uint64_t endUs = (uint64_t)(days * 86400.0 * 1e6);
+    std::shared_ptr<sim::EventStream> dashboard;
+    auto hostStart = std::chrono::steady_clock::now();
+    try {
+        setup();
+        traces.resize(numPumps);
+        dashboard = sim::subscribe(server, "/api/events");
+        while (sim::nowMicros() < endUs) loop();
+    } catch (const sim::Restart&) {
+        printf("\n*** ESP.restart() at %.3f s of simulated time\n", sim::nowMicros() / 1e6);
+        return 3;
+    }
+
+    double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hostStart).count();
+    printf("\n=== Simulated %.1f days in %.0f ms of host time ===\n", days, hostMs);
+    printf("stack never used: control %u B, service %u B (of %u B host stacks)\n",
+           (unsigned)controlTaskStackFree(), (unsigned)serviceTaskStackFree(), (unsigned)sim::TASK_STACK_BYTES);
+    printf("EEPROM commits: %u (%llu bytes written)\n", sim::eepromStats().commits,
+           (unsigned long long)sim::eepromStats().bytesWritten);
+    printf("journal: %zu waterings in %zu segments\n", journalRecordCount(), journalSegmentCount());
+    uint32_t rolledUp = 0;
+    float rolledUpOz = 0;
+    for (int i = 0; i < numPumps; i++) {
+        UsageTotals lifetime = rollupWindow(plants[i].rollup, ROLLUP_LIFETIME, timeNow());
+        rolledUp += lifetime.waterings;
+        rolledUpOz += lifetime.oz;
+    }
+    printf("usage totals: %u waterings, %.2f oz\n", (unsigned)rolledUp, rolledUpOz);
+    size_t plantEvents = 0;
+    for (size_t at = 0; (at = dashboard->text.find("event: plant", at)) != std::string::npos; at++) plantEvents++;
+    double pollBytes = sim::http(server, "GET", "/api/plants").body.size() * (days * 1440.0);
+    printf("/api/events: %zu plant events, %zu bytes (full GET /api/plants every 60 s: %.0f bytes)\n",
+           plantEvents, dashboard->text.size(), pollBytes);
+    printf("time base: max error %.3f ms vs UTC (system clock %.3f ms), drift %+.3f ppm (oscillator %+d ppm),"
+           " %u syncs\n", maxTimeBaseErrorMs, maxSystemClockErrorMs, timeDriftPpb() / 1000.0, driftPpm,
+           timeSyncCount());
+    if (waterNowPumpOnAt) {
+        printf("water-now at %.3f s: pump 1 on after %.3f ms\n", waterNowAt / 1e6,
+               (waterNowPumpOnAt - waterNowAt) / 1000.0);
+    }
+    printf("pumps on at once: at most %d (budget %d), starts at least %.3f s apart\n", maxPumpsOn,
+           MAX_CONCURRENT_PUMPS, minStartGapUs == UINT64_MAX ? 0.0 : minStartGapUs / 1e6);
+    printf("%-5s %-16s %6s %12s %14s %14s\n", "pump", "plant", "doses", "on-time s", "mean err ms", "max |err| ms");
+    double worstMs = 0;
+    for (int i = 0; i < numPumps; i++) {
+        const PumpTrace& t = traces[i];
+        printf("%-5d %-16s %6u %12.1f %14.3f %14.3f\n", pumps[i].number, pumps[i].plant->name, t.doses,
+               t.totalOnMs / 1000.0, t.doses ? t.sumErrorMs / t.doses : 0.0, t.maxErrorMs);
+        worstMs = max(worstMs, t.maxErrorMs);
+    }
+    if (worstMs > maxDoseErrorMs) {
+        printf("FAIL: a dose was off by %.3f ms (bound %.3f ms)\n", worstMs, maxDoseErrorMs);
+        return 4;
+    }
+    return 0;
+}
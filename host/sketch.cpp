@@ -0,0 +1,2 @@
+// sketch.cpp - compiles the sketch's .ino as a C++ translation unit
+#include "water_my_plants.ino"
@@ -1,7 +1,7 @@
 const express = require('express');
-const path = require('path');
+const { buildPage } = require('./tools/build_homepage');
 const app = express();
-const port = 4000;
+const port = Number(process.env.PORT) || 4000;
 
 // Enable JSON body parsing
 app.use(express.json());
@@ -46,9 +46,6 @@ const plants = [
     }
 ];
 
-// Serve static files from the data directory
-app.use(express.static(path.join(__dirname, 'data')));
-
 // Enable CORS for all routes
 app.use((req, res, next) => {
     res.header('Access-Control-Allow-Origin', '*');
@@ -60,9 +57,10 @@ app.use((req, res, next) => {
     next();
 });
 
-// Serve homepage at root
+// Serve the same minified page the firmware embeds, rebuilt on every
+// request so edits to data/homepage.html show up on reload
 app.get('/', (req, res) => {
-    res.sendFile(path.join(__dirname, 'data', 'homepage.html'));
+    res.type('html').send(buildPage().html);
 });
 
 // API endpoint for plant data
@@ -70,12 +68,103 @@ app.get('/api/plants', (req, res) => {
     res.json(plants);
 });
 
+// CBOR body in the firmware's layout (water_my_plants/plant_cbor.cpp), for
+// scrapers and the fleet aggregator. Express answers If-None-Match with 304.
+function cborHead(bytes, major, value) {
+    if (value < 24) {
+        bytes.push((major << 5) | value);
+    } else if (value < 0x100) {
+        bytes.push((major << 5) | 24, value);
+    } else if (value < 0x10000) {
+        bytes.push((major << 5) | 25, value >> 8, value & 0xff);
+    } else {
+        bytes.push((major << 5) | 26, (value >>> 24) & 0xff, (value >> 16) & 0xff, (value >> 8) & 0xff, value & 0xff);
+    }
+}
+
+function cborInt(bytes, value) {
+    value = Math.round(value);
+    if (value < 0) cborHead(bytes, 1, -1 - value);
+    else cborHead(bytes, 0, value);
+}
+
+function plantsCbor() {
+    const bytes = [];
+    cborHead(bytes, 4, 4);
+    cborInt(bytes, 1);                          // schema
+    cborInt(bytes, eventId);                    // state version
+    cborInt(bytes, Math.floor(Date.now() / 1000));
+    cborHead(bytes, 4, plants.length);
+    for (const plant of plants) {
+        const name = Buffer.from(plant.name, 'utf8');
+        cborHead(bytes, 4, 8);
+        cborHead(bytes, 3, name.length);
+        bytes.push(...name);
+        cborInt(bytes, plant.ozPerWatering * 100);
+        cborInt(bytes, plant.intervalMinutes);
+        cborInt(bytes, 0);                      // pump idle
+        cborInt(bytes, 0);                      // not waiting
+        bytes.push(0xf4);                       // needsWatering: false
+        cborHead(bytes, 4, plant.wateringHistory.length);
+        for (const event of plant.wateringHistory) {
+            cborHead(bytes, 4, 2);
+            cborInt(bytes, Math.floor(event.timestamp));
+            cborInt(bytes, event.amount * 100);
+        }
+        cborHead(bytes, 4, 4);                  // no usage totals in the mock
+        for (let w = 0; w < 4; w++) {
+            cborHead(bytes, 4, 3);
+            cborInt(bytes, 0);
+            cborInt(bytes, 0);
+            cborInt(bytes, 0);
+        }
+    }
+    return Buffer.from(bytes);
+}
+
+app.get('/api/plants.bin', (req, res) => {
+    res.type('application/cbor').send(plantsCbor());
+});
+
+// Server-sent events: one "plant" event per changed plant, like the ESP32
+const eventClients = new Set();
+let eventId = 0;
+
+app.get('/api/events', (req, res) => {
+    res.set({ 'Content-Type': 'text/event-stream', 'Cache-Control': 'no-cache' });
+    res.flushHeaders();
+    res.write(`retry: 5000\nid: ${eventId}\nevent: hello\ndata: {}\n\n`);
+    eventClients.add(res);
+    req.on('close', () => eventClients.delete(res));
+});
+
+function publishPlant(index) {
+    const message = `id: ${++eventId}\nevent: plant\ndata: ${JSON.stringify({ index, ...plants[index] })}\n\n`;
+    eventClients.forEach((res) => res.write(message));
+}
+
+// Like the firmware, changes are answered with 202 and a command id;
+// the mock applies them at once, so every command reads back as applied
+let lastCommandId = 0;
+const appliedAt = new Map();
+
+function accepted(res) {
+    const id = ++lastCommandId;
+    appliedAt.set(id, Math.floor(Date.now() / 1000));
+    res.status(202).location(`/api/commands/${id}`).json({ id, status: 'queued' });
+}
+
+app.get('/api/commands/:id', (req, res) => {
+    const id = Number(req.params.id);
+    if (!appliedAt.has(id)) return res.status(404).json({ error: 'Unknown command' });
+    res.json({ id, status: 'applied', appliedAt: appliedAt.get(id) });
+});
+
 // Update watering amount
-app.put('/api/plants/:index/amount', (req, res) => {
-    const index = parseInt(req.params.index);
-    const { ozPerWatering } = req.body;
+app.put('/api/plants/amount', (req, res) => {
+    const { plantIndex: index, ozPerWatering } = req.body;
     
-    if (isNaN(index) || index < 0 || index >= plants.length) {
+    if (!Number.isInteger(index) || index < 0 || index >= plants.length) {
         return res.status(400).json({ error: 'Invalid plant index' });
     }
     
@@ -84,15 +173,15 @@ app.put('/api/plants/:index/amount', (req, res) => {
     }
     
     plants[index].ozPerWatering = ozPerWatering;
-    res.json({ success: true });
+    publishPlant(index);
+    accepted(res);
 });
 
 // Update watering interval
-app.put('/api/plants/:index/interval', (req, res) => {
-    const index = parseInt(req.params.index);
-    const { intervalDays } = req.body;
+app.put('/api/plants/interval', (req, res) => {
+    const { plantIndex: index, intervalDays } = req.body;
     
-    if (isNaN(index) || index < 0 || index >= plants.length) {
+    if (!Number.isInteger(index) || index < 0 || index >= plants.length) {
         return res.status(400).json({ error: 'Invalid plant index' });
     }
     
@@ -102,14 +191,15 @@ app.put('/api/plants/:index/interval', (req, res) => {
     
     // Convert days to minutes
     plants[index].intervalMinutes = intervalDays * 24 * 60;
-    res.json({ success: true });
+    publishPlant(index);
+    accepted(res);
 });
 
 // Trigger immediate watering
-app.post('/api/plants/:index/water-now', (req, res) => {
-    const index = parseInt(req.params.index);
+app.post('/api/plants/water-now', (req, res) => {
+    const index = req.body.plantIndex;
     
-    if (isNaN(index) || index < 0 || index >= plants.length) {
+    if (!Number.isInteger(index) || index < 0 || index >= plants.length) {
         return res.status(400).json({ error: 'Invalid plant index' });
     }
     
@@ -122,14 +212,14 @@ app.post('/api/plants/:index/water-now', (req, res) => {
     // Keep only last 5 watering events
     plants[index].wateringHistory = plants[index].wateringHistory.slice(0, 5);
     
-    res.json({ success: true });
+    publishPlant(index);
+    accepted(res);
 });
 
-app.put('/api/plants/:index/name', (req, res) => {
-    const index = parseInt(req.params.index);
-    const { name } = req.body;
+app.put('/api/plants/name', (req, res) => {
+    const { plantIndex: index, name } = req.body;
     
-    if (isNaN(index) || index < 0 || index >= plants.length) {
+    if (!Number.isInteger(index) || index < 0 || index >= plants.length) {
         return res.status(400).json({ error: 'Invalid plant index' });
     }
     
@@ -138,7 +228,8 @@ app.put('/api/plants/:index/name', (req, res) => {
     }
     
     plants[index].name = name.trim();
-    res.json({ success: true });
+    publishPlant(index);
+    accepted(res);
 });
 
 app.listen(port, () => {
@@ -0,0 +1,143 @@
+// build_homepage.js - turns data/homepage.html into water_my_plants/homepage.h
+//
+// The page is minified, the Tailwind utilities it uses are inlined in place
+// of the @tailwind marker (see tailwind_classes.js), and the result is
+// gzipped into a PROGMEM byte array. HOMEPAGE_HASH is taken from the
+// minified page so the firmware can serve it under an immutable URL.
+//
+// Usage: node tools/build_homepage.js [--check]
+//   --check  exit 1 if homepage.h is out of date instead of writing it
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const { tailwindCss, known } = require('./tailwind_classes');
+
+const ROOT = path.join(__dirname, '..');
+const SOURCE = path.join(ROOT, 'data', 'homepage.html');
+const OUTPUT = path.join(ROOT, 'water_my_plants', 'homepage.h');
+const TAILWIND_MARKER = /<!--\s*@tailwind[\s\S]*?-->/;
+
+// Class names from class="..." attributes, including the string literals in
+// ${...} expressions of template literals, and classList calls.
+function usedClasses(html) {
+    const classes = new Set();
+    const addAll = (text) => text.split(/\s+/).filter(Boolean).forEach((c) => classes.add(c));
+    for (const [, value] of html.matchAll(/class="([^"]*)"/g)) {
+        for (const [, expr] of value.matchAll(/\$\{([^}]*)\}/g)) {
+            for (const [, literal] of expr.matchAll(/'([^']*)'/g)) addAll(literal);
+        }
+        addAll(value.replace(/\$\{[^}]*\}/g, ' '));
+    }
+    for (const [, name] of html.matchAll(/classList\.(?:add|remove|toggle)\('([^']*)'/g)) {
+        classes.add(name);
+    }
+    return classes;
+}
+
+// Classes the page styles itself in its own <style> blocks
+function pageClasses(html) {
+    const classes = new Set();
+    for (const [, css] of html.matchAll(/<style>([\s\S]*?)<\/style>/g)) {
+        for (const [, name] of css.matchAll(/\.([a-zA-Z][\w-]*)/g)) classes.add(name);
+    }
+    return classes;
+}
+
+function minifyCss(css) {
+    return css
+        .replace(/\/\*[\s\S]*?\*\//g, '')
+        .replace(/\s+/g, ' ')
+        .replace(/\s*([{};,>])\s*/g, '$1')
+        .replace(/:\s+/g, ':')
+        .replace(/;}/g, '}')
+        .trim();
+}
+
+// Conservative: drops comment-only lines and indentation but keeps line
+// breaks, so automatic semicolon insertion and template literals still work.
+function minifyJs(js) {
+    return js
+        .split('\n')
+        .map((line) => line.trim())
+        .filter((line) => line && !line.startsWith('//'))
+        .join('\n');
+}
+
+function minifyHtml(html) {
+    return html
+        .replace(/<!--[\s\S]*?-->/g, '')
+        .replace(/\s+/g, ' ')
+        .replace(/>\s+</g, '><')
+        .trim();
+}
+
+function buildPage(source = fs.readFileSync(SOURCE, 'utf8')) {
+    if (!TAILWIND_MARKER.test(source)) {
+        throw new Error(`${SOURCE}: missing <!-- @tailwind --> marker`);
+    }
+    const used = usedClasses(source);
+    const local = pageClasses(source);
+    const unknown = [...used].filter((c) => !known.has(c) && !local.has(c));
+    if (unknown.length) {
+        throw new Error(`classes missing from tools/tailwind_classes.js: ${unknown.sort().join(' ')}`);
+    }
+
+    const withCss = source.replace(TAILWIND_MARKER, () => `<style>${tailwindCss(used)}</style>`);
+    const html = withCss
+        .split(/(<script>[\s\S]*?<\/script>|<style>[\s\S]*?<\/style>)/)
+        .map((part) => {
+            if (part.startsWith('<script>')) return `<script>${minifyJs(part.slice(8, -9))}</script>`;
+            if (part.startsWith('<style>')) return `<style>${minifyCss(part.slice(7, -8))}</style>`;
+            return minifyHtml(part);
+        })
+        .join('');
+
+    const gzip = zlib.gzipSync(Buffer.from(html, 'utf8'), { level: 9 });
+    gzip[9] = 255;  // OS field: "unknown", so the bytes don't depend on the build host
+    const hash = crypto.createHash('sha256').update(html).digest('hex').slice(0, 8);
+    return { html, gzip, hash };
+}
+
+function renderHeader({ html, gzip, hash }) {
+    const lines = [];
+    for (let i = 0; i < gzip.length; i += 16) {
+        const row = [...gzip.subarray(i, i + 16)].map((b) => '0x' + b.toString(16).padStart(2, '0'));
+        lines.push('    ' + row.join(', ') + ',');
+    }
+    return `// homepage.h - generated by tools/build_homepage.js from data/homepage.html
+// Do not edit; run \`npm run build:homepage\` after changing the page.
+#ifndef HOMEPAGE_H
+#define HOMEPAGE_H
+
+#include <Arduino.h>
+
+// First 8 hex digits of the SHA-256 of the minified page
+#define HOMEPAGE_HASH "${hash}"
+
+// ${Buffer.byteLength(html)} bytes of minified HTML, gzip-compressed
+const size_t HOMEPAGE_GZ_LEN = ${gzip.length};
+const uint8_t HOMEPAGE_GZ[] PROGMEM = {
+${lines.join('\n')}
+};
+
+#endif
+`;
+}
+
+if (require.main === module) {
+    const page = buildPage();
+    const header = renderHeader(page);
+    const current = fs.existsSync(OUTPUT) ? fs.readFileSync(OUTPUT, 'utf8') : '';
+    if (process.argv.includes('--check')) {
+        if (current !== header) {
+            console.error('water_my_plants/homepage.h is out of date; run npm run build:homepage');
+            process.exit(1);
+        }
+    } else if (current !== header) {
+        fs.writeFileSync(OUTPUT, header);
+    }
+    console.log(`homepage ${page.hash}: ${Buffer.byteLength(page.html)} B minified, ${page.gzip.length} B gzip`);
+}
+
+module.exports = { buildPage };
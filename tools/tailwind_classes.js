@@ -0,0 +1,148 @@
+// tailwind_classes.js - the Tailwind CSS 2.2.19 utilities the dashboard may use
+//
+// Values are copied from the default Tailwind 2 build the page used to load
+// from a CDN. Entries are in Tailwind's own output order, which the build
+// keeps so later utilities still win over earlier ones. Add a class here
+// before using it in data/homepage.html; the build fails on unknown ones.
+
+// Trimmed preflight: the resets the page depends on
+const preflight = `
+*,::before,::after{box-sizing:border-box;border:0 solid #e5e7eb;--tw-ring-offset-width:0px;--tw-ring-offset-color:#fff;--tw-ring-color:rgba(59,130,246,0.5);--tw-ring-offset-shadow:0 0 #0000;--tw-ring-shadow:0 0 #0000;--tw-shadow:0 0 #0000}
+html{line-height:1.5;-webkit-text-size-adjust:100%;font-family:ui-sans-serif,system-ui,-apple-system,BlinkMacSystemFont,"Segoe UI",Roboto,"Helvetica Neue",Arial,"Noto Sans",sans-serif,"Apple Color Emoji","Segoe UI Emoji","Segoe UI Symbol","Noto Color Emoji"}
+body{margin:0;font-family:inherit;line-height:inherit}
+h1,h2,h3,p{margin:0}
+h1,h2,h3{font-size:inherit;font-weight:inherit}
+button,input{font-family:inherit;font-size:100%;line-height:inherit;color:inherit;margin:0;padding:0}
+button{text-transform:none;background-color:transparent;background-image:none;cursor:pointer;-webkit-appearance:button}
+input::placeholder{opacity:1;color:#9ca3af}
+`;
+
+const shadow = 'box-shadow:var(--tw-ring-offset-shadow,0 0 #0000),var(--tw-ring-shadow,0 0 #0000),var(--tw-shadow)';
+
+// [class, declarations, variant]; variant is a pseudo-class or 'sm'
+const utilities = [
+    ['space-y-2', 'margin-top:0.5rem', '>:not([hidden])~:not([hidden])'],
+    ['space-x-2', 'margin-left:0.5rem', '>:not([hidden])~:not([hidden])'],
+    ['space-y-3', 'margin-top:0.75rem', '>:not([hidden])~:not([hidden])'],
+    ['space-x-3', 'margin-left:0.75rem', '>:not([hidden])~:not([hidden])'],
+    ['space-y-4', 'margin-top:1rem', '>:not([hidden])~:not([hidden])'],
+    ['bg-white', 'background-color:#fff'],
+    ['bg-gray-50', 'background-color:#f9fafb'],
+    ['bg-gray-100', 'background-color:#f3f4f6'],
+    ['bg-red-50', 'background-color:#fef2f2'],
+    ['bg-red-500', 'background-color:#ef4444'],
+    ['bg-yellow-50', 'background-color:#fffbeb'],
+    ['bg-green-100', 'background-color:#d1fae5'],
+    ['bg-green-500', 'background-color:#10b981'],
+    ['bg-blue-50', 'background-color:#eff6ff'],
+    ['bg-blue-500', 'background-color:#3b82f6'],
+    ['hover:bg-gray-200', 'background-color:#e5e7eb', ':hover'],
+    ['hover:bg-blue-600', 'background-color:#2563eb', ':hover'],
+    ['active:bg-blue-700', 'background-color:#1d4ed8', ':active'],
+    ['bg-gradient-to-br', 'background-image:linear-gradient(to bottom right,var(--tw-gradient-stops))'],
+    ['from-green-50', '--tw-gradient-from:#ecfdf5;--tw-gradient-stops:var(--tw-gradient-from),var(--tw-gradient-to,rgba(236,253,245,0))'],
+    ['to-blue-50', '--tw-gradient-to:#eff6ff'],
+    ['border-gray-300', 'border-color:#d1d5db'],
+    ['focus:border-blue-500', 'border-color:#3b82f6', ':focus'],
+    ['rounded-lg', 'border-radius:0.5rem'],
+    ['rounded-xl', 'border-radius:0.75rem'],
+    ['rounded-full', 'border-radius:9999px'],
+    ['border', 'border-width:1px'],
+    ['border-t', 'border-top-width:1px'],
+    ['block', 'display:block'],
+    ['inline-block', 'display:inline-block'],
+    ['flex', 'display:flex'],
+    ['inline-flex', 'display:inline-flex'],
+    ['grid', 'display:grid'],
+    ['flex-col', 'flex-direction:column'],
+    ['items-start', 'align-items:flex-start'],
+    ['items-end', 'align-items:flex-end'],
+    ['items-center', 'align-items:center'],
+    ['justify-end', 'justify-content:flex-end'],
+    ['justify-between', 'justify-content:space-between'],
+    ['flex-1', 'flex:1 1 0%'],
+    ['font-mono', 'font-family:ui-monospace,SFMono-Regular,Menlo,Monaco,Consolas,"Liberation Mono","Courier New",monospace'],
+    ['font-medium', 'font-weight:500'],
+    ['font-semibold', 'font-weight:600'],
+    ['font-bold', 'font-weight:700'],
+    ['h-3', 'height:0.75rem'],
+    ['text-sm', 'font-size:0.875rem;line-height:1.25rem'],
+    ['text-lg', 'font-size:1.125rem;line-height:1.75rem'],
+    ['text-xl', 'font-size:1.25rem;line-height:1.75rem'],
+    ['text-3xl', 'font-size:1.875rem;line-height:2.25rem'],
+    ['mx-auto', 'margin-left:auto;margin-right:auto'],
+    ['mb-1', 'margin-bottom:0.25rem'],
+    ['mt-2', 'margin-top:0.5rem'],
+    ['mr-2', 'margin-right:0.5rem'],
+    ['mb-2', 'margin-bottom:0.5rem'],
+    ['mb-3', 'margin-bottom:0.75rem'],
+    ['mt-4', 'margin-top:1rem'],
+    ['mb-4', 'margin-bottom:1rem'],
+    ['mb-6', 'margin-bottom:1.5rem'],
+    ['mb-8', 'margin-bottom:2rem'],
+    ['max-w-7xl', 'max-width:80rem'],
+    ['min-h-screen', 'min-height:100vh'],
+    ['focus:outline-none', 'outline:2px solid transparent;outline-offset:2px', ':focus'],
+    ['overflow-hidden', 'overflow:hidden'],
+    ['p-1', 'padding:0.25rem'],
+    ['p-4', 'padding:1rem'],
+    ['p-6', 'padding:1.5rem'],
+    ['p-8', 'padding:2rem'],
+    ['py-2', 'padding-top:0.5rem;padding-bottom:0.5rem'],
+    ['px-3', 'padding-left:0.75rem;padding-right:0.75rem'],
+    ['py-3', 'padding-top:0.75rem;padding-bottom:0.75rem'],
+    ['px-4', 'padding-left:1rem;padding-right:1rem'],
+    ['pt-4', 'padding-top:1rem'],
+    ['text-center', 'text-align:center'],
+    ['text-white', 'color:#fff'],
+    ['text-gray-400', 'color:#9ca3af'],
+    ['text-gray-500', 'color:#6b7280'],
+    ['text-gray-600', 'color:#4b5563'],
+    ['text-gray-700', 'color:#374151'],
+    ['text-gray-800', 'color:#1f2937'],
+    ['text-gray-900', 'color:#111827'],
+    ['text-red-500', 'color:#ef4444'],
+    ['text-red-600', 'color:#dc2626'],
+    ['text-yellow-600', 'color:#d97706'],
+    ['text-green-700', 'color:#047857'],
+    ['text-blue-600', 'color:#2563eb'],
+    ['hover:text-gray-600', 'color:#4b5563', ':hover'],
+    ['shadow-sm', '--tw-shadow:0 1px 2px 0 rgba(0,0,0,0.05);' + shadow],
+    ['shadow-lg', '--tw-shadow:0 10px 15px -3px rgba(0,0,0,0.1),0 4px 6px -2px rgba(0,0,0,0.05);' + shadow],
+    ['focus:ring-2', '--tw-ring-offset-shadow:0 0 0 var(--tw-ring-offset-width) var(--tw-ring-offset-color);--tw-ring-shadow:0 0 0 calc(2px + var(--tw-ring-offset-width)) var(--tw-ring-color);box-shadow:var(--tw-ring-offset-shadow),var(--tw-ring-shadow),var(--tw-shadow,0 0 #0000)', ':focus'],
+    ['focus:ring-blue-500', '--tw-ring-color:#3b82f6', ':focus'],
+    ['transition-colors', 'transition-property:background-color,border-color,color,fill,stroke;transition-timing-function:cubic-bezier(0.4,0,0.2,1);transition-duration:150ms'],
+    ['grid-cols-1', 'grid-template-columns:repeat(1,minmax(0,1fr))'],
+    ['col-span-3', 'grid-column:span 3/span 3'],
+    ['gap-6', 'gap:1.5rem'],
+    ['w-3', 'width:0.75rem'],
+    ['w-full', 'width:100%'],
+    ['sm:p-6', 'padding:1.5rem', 'sm'],
+    ['sm:text-2xl', 'font-size:1.5rem;line-height:2rem', 'sm'],
+];
+
+const SM_MEDIA = '@media (min-width:640px)';
+
+function escapeClass(name) {
+    return name.replace(/([:.\/])/g, '\\$1');
+}
+
+// CSS for exactly the given class names, in table order
+function tailwindCss(used) {
+    let css = preflight.trim().replace(/\n/g, '');
+    let responsive = '';
+    for (const [name, decls, variant] of utilities) {
+        if (!used.has(name)) continue;
+        if (variant === 'sm') {
+            responsive += `.${escapeClass(name)}{${decls}}`;
+        } else {
+            css += `.${escapeClass(name)}${variant || ''}{${decls}}`;
+        }
+    }
+    if (responsive) css += `${SM_MEDIA}{${responsive}}`;
+    return css;
+}
+
+const known = new Set(utilities.map(([name]) => name));
+
+module.exports = { tailwindCss, known };
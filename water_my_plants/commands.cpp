@@ -0,0 +1,164 @@
+// commands.cpp
+#include "water_my_plants.h"
+
+// Settings changes and "water now" requests from the web server. Handlers
+// run on the AsyncTCP task and only validate and enqueue; the control loop
+// applies commands between watering passes, so plants[] and pumps[] are
+// only ever written from one task.
+
+#define COMMAND_QUEUE_SIZE 16   // power of two
+#define COMMAND_RESULTS 16      // recent application times kept for status
+
+static_assert((COMMAND_QUEUE_SIZE & (COMMAND_QUEUE_SIZE - 1)) == 0, "queue size must be a power of two");
+static_assert(sizeof(PlantUpdate().name) == sizeof(Plant().name), "names are copied whole");
+
+// Single-producer (AsyncTCP task), single-consumer (control loop) ring.
+// head and tail count up forever; the slot is the count modulo the size.
+static Command queue[COMMAND_QUEUE_SIZE];
+static std::atomic<uint32_t> queueHead(0);   // next slot to write, producer only
+static std::atomic<uint32_t> queueTail(0);   // next slot to read, consumer only
+
+static uint32_t nextCommandId = 1;                // producer only
+static std::atomic<uint32_t> lastIssuedId(0);
+static std::atomic<uint32_t> lastAppliedId(0);
+
+// When each of the most recent commands was applied. id is cleared while
+// the entry is rewritten, so a reader that sees the same id before and
+// after reading appliedAt has a matching pair.
+struct CommandResult {
+    std::atomic<uint32_t> id;
+    std::atomic<uint32_t> appliedAt;
+};
+static CommandResult results[COMMAND_RESULTS];
+
+// Room for one batch, BATCH_MAX_UPDATES updates, set aside at boot. A batch holds
+// it from validation until the control loop has applied it; a second one
+// meanwhile is turned away.
+static PlantUpdate* batchUpdates = nullptr;
+static std::atomic<bool> batchInFlight(false);
+
+void commandsBegin() {
+    if (!batchUpdates) batchUpdates = new PlantUpdate[BATCH_MAX_UPDATES];
+}
+
+// The batch slots for the web server to fill, or nullptr while another
+// batch holds them
+PlantUpdate* claimBatchUpdates() {
+    if (!batchUpdates || batchInFlight.exchange(true, std::memory_order_acquire)) return nullptr;
+    return batchUpdates;
+}
+
+// Hands the batch slots back, for a batch that wasn't queued
+void releaseBatchUpdates() {
+    batchInFlight.store(false, std::memory_order_release);
+}
+
+// The plant a command is for, or how many plants a batch has
+static uint16_t commandSubject(const Command& command) {
+    return command.type == COMMAND_BATCH ? command.batch.count : command.plant;
+}
+
+uint32_t enqueueCommand(Command& command) {
+    uint32_t head = queueHead.load(std::memory_order_relaxed);
+    if (head - queueTail.load(std::memory_order_acquire) >= COMMAND_QUEUE_SIZE) return 0;
+    command.id = nextCommandId++;
+    if (nextCommandId == 0) nextCommandId = 1;
+    queue[head % COMMAND_QUEUE_SIZE] = command;
+    // Before it's published, so it can't be recorded after being applied
+    traceRecord(TRACE_COMMAND_QUEUED, commandSubject(command), command.type, command.id);
+    queueHead.store(head + 1, std::memory_order_release);
+    lastIssuedId = command.id;
+    wakeControlTask();
+    return command.id;
+}
+
+// Applies one plant's changes; settings go to flash, "water now" doesn't
+static void applyUpdate(const PlantUpdate& update) {
+    int i = update.plant;
+    if (update.fields & UPDATE_NAME) {
+        memcpy(plants[i].name, update.name, sizeof(plants[i].name));
+        plants[i].name[sizeof(plants[i].name) - 1] = '\0';
+    }
+    if (update.fields & UPDATE_AMOUNT) plants[i].ozPerWatering = update.amount;
+    if (update.fields & UPDATE_INTERVAL) plants[i].intervalMinutes = update.intervalMinutes;
+    // A dose already running is left alone; the request waters again once
+    // it stops. Otherwise the dose is sized when the pump starts, so a new
+    // amount in the same update applies to it.
+    if (update.fields & UPDATE_WATER_NOW) {
+        if (zones.running[i]) {
+            pumps[i].waterAgain = true;
+        } else {
+            if (!zones.needsWatering[i]) traceRecord(TRACE_NEEDS_WATERING, i, 1, WATERING_MANUAL);
+            zones.needsWatering[i] = true;
+            pumps[i].source = WATERING_MANUAL;
+        }
+    }
+    markPlantChanged(i);
+    if (update.fields & ~UPDATE_WATER_NOW) markPlantDirty(i);
+}
+
+static void applyCommand(const Command& command) {
+    if (command.type == COMMAND_BATCH) {
+        // All in one pass, then straight to flash in a single commit
+        for (uint16_t k = 0; k < command.batch.count; k++) applyUpdate(command.batch.updates[k]);
+        releaseBatchUpdates();
+        requestCommit();
+        return;
+    }
+
+    PlantUpdate update = {};
+    update.plant = command.plant;
+    switch (command.type) {
+        case COMMAND_WATER_NOW:
+            update.fields = UPDATE_WATER_NOW;
+            break;
+        case COMMAND_SET_AMOUNT:
+            update.fields = UPDATE_AMOUNT;
+            update.amount = command.amount;
+            break;
+        case COMMAND_SET_INTERVAL:
+            update.fields = UPDATE_INTERVAL;
+            update.intervalMinutes = command.intervalMinutes;
+            break;
+        case COMMAND_SET_NAME:
+            update.fields = UPDATE_NAME;
+            memcpy(update.name, command.name, sizeof(update.name));
+            break;
+    }
+    applyUpdate(update);
+}
+
+// Applies everything queued so far; called from the control loop
+void applyCommands() {
+    uint32_t tail = queueTail.load(std::memory_order_relaxed);
+    uint32_t head = queueHead.load(std::memory_order_acquire);
+    if (tail == head) return;
+    uint32_t appliedAt = timeValid() ? (uint32_t)timeNow() : 0;
+    for (; tail != head; tail++) {
+        const Command& command = queue[tail % COMMAND_QUEUE_SIZE];
+        traceRecord(TRACE_COMMAND_APPLIED, commandSubject(command), command.type, command.id);
+        applyCommand(command);
+
+        CommandResult& result = results[command.id % COMMAND_RESULTS];
+        result.id = 0;
+        result.appliedAt = appliedAt;
+        result.id = command.id;
+        lastAppliedId = command.id;
+        // Hand the slot back to the producer only once it has been read
+        queueTail.store(tail + 1, std::memory_order_release);
+    }
+}
+
+CommandStatus commandStatus(uint32_t id, uint32_t& appliedAt) {
+    appliedAt = 0;
+    uint32_t issued = lastIssuedId.load();
+    // Ids count up from 1 and only wrap after four billion commands
+    if (id == 0 || id > issued) return COMMAND_UNKNOWN;
+    if (id > lastAppliedId.load()) return COMMAND_QUEUED;
+    CommandResult& result = results[id % COMMAND_RESULTS];
+    if (result.id.load() == id) {
+        uint32_t at = result.appliedAt.load();
+        if (result.id.load() == id) appliedAt = at;
+    }
+    return COMMAND_APPLIED;
+}
@@ -14,40 +14,41 @@ const long gmtOffset_sec = -18000;    // EST is UTC-5 * 3600 = -18000
 const int daylightOffset_sec = 3600;  // 1 hour DST
 const int MINUTES_PER_DAY = 1440;  // 24 hours * 60 minutes
 
-// Plant definitions
-Plant plants[] = {
-    {{"Prickly Pear"}, 3.0, 14 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"Rosemary"}, 3.0, 4 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"Fittonia"}, 1.5, 1 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"Thyme"}, 3.0, 3 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"Myrtle"}, 3.0, 2.5 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"No Plant"}, 0.0, 100 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"Lavender"}, 3.0, 4 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false},
-    {{"Mint Plant"}, 3.0, 2 * MINUTES_PER_DAY, {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, 0, false}
+// Plant defaults, by pump: what each zone starts with until its settings
+// are changed and saved. Zones past the end of this list start as
+// "Zone N" with nothing scheduled.
+static const PlantDefaults plantTable[] = {
+    {"Prickly Pear", 3.0, 14 * MINUTES_PER_DAY},
+    {"Rosemary", 3.0, 4 * MINUTES_PER_DAY},
+    {"Fittonia", 1.5, 1 * MINUTES_PER_DAY},
+    {"Thyme", 3.0, 3 * MINUTES_PER_DAY},
+    {"Myrtle", 3.0, (int)(2.5 * MINUTES_PER_DAY)},
+    {"No Plant", 0.0, 100 * MINUTES_PER_DAY},
+    {"Lavender", 3.0, 4 * MINUTES_PER_DAY},
+    {"Mint Plant", 3.0, 2 * MINUTES_PER_DAY}
 };
+const PlantDefaults* const defaultPlants = plantTable;
+const int NUM_DEFAULT_PLANTS = sizeof(plantTable) / sizeof(plantTable[0]);
 
-// Pump definitions
-Pump pumps[] = {
-    {33, 23, 1, &plants[0], false, 0, 0},
-    {21, 22, 2, &plants[1], false, 0, 0},
-    {16, 4,  3, &plants[2], false, 0, 0},
-    {15, 2,  4, &plants[3], false, 0, 0},
-    {14, 27, 5, &plants[4], false, 0, 0},
-    {25, 26, 6, &plants[5], false, 0, 0},
-    {19, 18, 7, &plants[6], false, 0, 0},
-    {17, 5,  8, &plants[7], false, 0, 0}
+// Pump wiring used when SPIFFS has no /pumps.cfg; the last field is how
+// much of the MAX_CONCURRENT_PUMPS budget the pump takes while running (2
+// for one drawing twice the current)
+static const PumpWiring pumpTable[] = {
+    {33, 23, 1},
+    {21, 22, 1},
+    {16, 4,  1},
+    {15, 2,  1},
+    {14, 27, 1},
+    {25, 26, 1},
+    {19, 18, 1},
+    {17, 5,  1}
 };
+const PumpWiring* const defaultPumps = pumpTable;
+const int NUM_DEFAULT_PUMPS = sizeof(pumpTable) / sizeof(pumpTable[0]);
 
-// EEPROM size calculation
-
-const int NUM_PUMPS = sizeof(pumps) / sizeof(pumps[0]);
-const int SIZE_PER_PLANT = 
-    32 +                   // name[32]
-    sizeof(float) +        // ozPerWatering
-    sizeof(int) +          // intervalMinutes
-    sizeof(int) +          // currentHistoryIndex
-    sizeof(bool) +         // needsWatering
-    3 +                    // padding to align to 4 bytes
-    (WATERING_HISTORY_SIZE * (sizeof(time_t) + sizeof(float))); // wateringHistory
-
-const int EEPROM_SIZE = sizeof(uint32_t) + NUM_PUMPS * SIZE_PER_PLANT;
+// GPIO expanders for pumps beyond the ESP32's own pins, e.g.
+//     static const PumpExpander expanders[] = {{&Wire, 0x20}, {&Wire, 0x21}};
+// with pumps wired as {EXPANDER_PIN(0, 0), EXPANDER_PIN(0, 1), 1}.
+// Up to eight per bus, eight pumps each. /pumps.cfg lists its own.
+const PumpExpander* const defaultPumpExpanders = nullptr;
+const int NUM_DEFAULT_PUMP_EXPANDERS = 0;
@@ -11,9 +11,9 @@ extern const char* ntpServer2;
 extern const long gmtOffset_sec;
 extern const int daylightOffset_sec;
 
-extern const int NUM_PUMPS;
-extern const int EEPROM_SIZE;
-extern const int SIZE_PER_PLANT;
-
-extern Plant plants[];
-extern Pump pumps[];
\ No newline at end of file
+extern const PlantDefaults* const defaultPlants;
+extern const int NUM_DEFAULT_PLANTS;
+extern const PumpWiring* const defaultPumps;
+extern const int NUM_DEFAULT_PUMPS;
+extern const PumpExpander* const defaultPumpExpanders;
+extern const int NUM_DEFAULT_PUMP_EXPANDERS;
\ No newline at end of file
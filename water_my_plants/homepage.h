@@ -1,462 +1,357 @@
+// homepage.h - generated by tools/build_homepage.js from data/homepage.html
+// Do not edit; run `npm run build:homepage` after changing the page.
 #ifndef HOMEPAGE_H
 #define HOMEPAGE_H
 
-const char HOMEPAGE_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0, maximum-scale=1.0, user-scalable=no">
-    <title>Smart Plant Watering System</title>
-    <link href="https://cdnjs.cloudflare.com/ajax/libs/tailwindcss/2.2.19/tailwind.min.css" rel="stylesheet">
-    <style>
-        /* iOS specific styles */
-        input[type="number"], input[type="text"] {
-            -webkit-appearance: none;
-            margin: 0;
-            -moz-appearance: textfield;
-            border-radius: 8px;
-            padding: 0.5rem;
-        }
-        
-        /* Prevent zoom on input focus for iOS */
-        input, select, textarea {
-            font-size: 16px;
-        }
-        
-        /* Better tap targets for iOS */
-        button {
-            padding: 12px !important;
-            touch-action: manipulation;
-        }
-        
-        /* Disable pull-to-refresh */
-        body {
-            overscroll-behavior-y: contain;
-        }
-        
-        /* Smooth scrolling for iOS */
-        .scroll-container {
-            -webkit-overflow-scrolling: touch;
-        }
-
-        /* Modal styles */
-        .modal {
-            position: fixed;
-            top: 0;
-            left: 0;
-            right: 0;
-            bottom: 0;
-            background-color: rgba(0, 0, 0, 0.5);
-            display: flex;
-            justify-content: center;
-            align-items: center;
-            z-index: 50;
-        }
-
-        .modal-content {
-            background-color: white;
-            padding: 1.5rem;
-            border-radius: 1rem;
-            width: 90%;
-            max-width: 400px;
-            margin: 1rem;
-            box-shadow: 0 20px 25px -5px rgb(0 0 0 / 0.1), 0 8px 10px -6px rgb(0 0 0 / 0.1);
-        }
-
-        /* Prevent background scrolling when modal is open */
-        .modal-open {
-            overflow: hidden;
-            position: fixed;
-            width: 100%;
-            height: 100%;
-        }
-
-        .edit-icon {
-            cursor: pointer;
-            opacity: 0.6;
-            transition: opacity 0.2s;
-        }
-        
-        .edit-icon:hover {
-            opacity: 1;
-        }
-
-        @keyframes pulse {
-            0% {
-                transform: scale(1);
-                opacity: 1;
-                box-shadow: 0 0 0 0 rgba(34, 197, 94, 0.4);
-            }
-            50% {
-                transform: scale(1.3);
-                opacity: 0.7;
-                box-shadow: 0 0 0 6px rgba(34, 197, 94, 0);
-            }
-            100% {
-                transform: scale(1);
-                opacity: 1;
-                box-shadow: 0 0 0 0 rgba(34, 197, 94, 0);
-            }
-        }
-
-        .status-pulse {
-            animation: pulse 1.5s cubic-bezier(0.4, 0, 0.6, 1) infinite;
-        }
-    </style>
-</head>
-<body class="bg-gradient-to-br from-green-50 to-blue-50 min-h-screen p-4">
-    <div class="max-w-7xl mx-auto">
-        <header class="text-center mb-8">
-            <h1 class="text-3xl font-bold text-gray-800 mb-2">Smart Plant Watering System</h1>
-            <p class="text-gray-600 text-sm">Keeping your plants happy and healthy</p>
-            <div class="mt-4 inline-flex items-center px-4 py-2 bg-green-100 rounded-full">
-                <div id="status-indicator" class="w-3 h-3 rounded-full bg-green-500 mr-2 status-pulse"></div>
-                <span id="update-status" class="text-sm text-green-700">Last updated: Just now</span>
-            </div>
-        </header>
-
-        <div id="plants-container" class="grid grid-cols-1 gap-6 scroll-container">
-            <div class="text-center p-8">
-                <div class="inline-block p-6 bg-blue-50 rounded-lg">
-                    <p class="text-blue-600 font-medium">Loading plant data...</p>
-                </div>
-            </div>
-        </div>
-    </div>
-
-    <!-- Water confirmation modal -->
-    <div id="confirmModal" class="modal" style="display: none;">
-        <div class="modal-content">
-            <h3 class="text-lg font-semibold text-gray-900 mb-4">Confirm Watering</h3>
-            <p class="text-gray-600 mb-6">Are you sure you want to water this plant now?</p>
-            <div class="flex justify-end space-x-3">
-                <button onclick="hideConfirmModal()" class="px-4 py-2 text-gray-700 bg-gray-100 rounded-lg hover:bg-gray-200">
-                    Cancel
-                </button>
-                <button id="confirmWaterButton" class="px-4 py-2 text-white bg-blue-500 rounded-lg hover:bg-blue-600">
-                    Water Now
-                </button>
-            </div>
-        </div>
-    </div>
-
-    <!-- Name edit modal -->
-    <div id="nameEditModal" class="modal" style="display: none;">
-        <div class="modal-content">
-            <h3 class="text-lg font-semibold text-gray-900 mb-4">Rename Plant</h3>
-            <div class="mb-6">
-                <label for="newPlantName" class="block text-sm font-medium text-gray-700 mb-2">New Name:</label>
-                <input 
-                    type="text" 
-                    id="newPlantName"
-                    class="w-full px-3 py-2 border border-gray-300 rounded-lg shadow-sm focus:outline-none focus:ring-2 focus:ring-blue-500 focus:border-blue-500"
-                    placeholder="Enter new name"
-                >
-            </div>
-            <div class="flex justify-end space-x-3">
-                <button onclick="hideNameEditModal()" class="px-4 py-2 text-gray-700 bg-gray-100 rounded-lg hover:bg-gray-200">
-                    Cancel
-                </button>
-                <button id="confirmNameButton" class="px-4 py-2 text-white bg-blue-500 rounded-lg hover:bg-blue-600">
-                    Save
-                </button>
-            </div>
-        </div>
-    </div>
-
-    <script>
-        const API_ENDPOINT = '/api/plants';
-        
-        function formatDate(timestamp) {
-            if (!timestamp) return 'No record';
-            try {
-                return new Date(timestamp * 1000).toLocaleString();
-            } catch {
-                return 'Invalid date';
-            }
-        }
-
-        function formatInterval(minutes) {
-            if (!minutes || isNaN(minutes)) return 'Unknown';
-            return `${(minutes / 1440).toFixed(1)} days`;
-        }
-
-        // Store the pending actions
-        let pendingWaterAction = null;
-        let pendingNameEdit = null;
-
-        // Water confirmation modal functions
-        function showConfirmModal(index) {
-            pendingWaterAction = index;
-            document.getElementById('confirmModal').style.display = 'flex';
-            document.body.classList.add('modal-open');
-            
-            document.getElementById('confirmWaterButton').onclick = () => {
-                if (pendingWaterAction !== null) {
-                    waterNow(pendingWaterAction);
-                }
-                hideConfirmModal();
-            };
-        }
-
-        function hideConfirmModal() {
-            document.getElementById('confirmModal').style.display = 'none';
-            document.body.classList.remove('modal-open');
-            pendingWaterAction = null;
-        }
-
-        // Name edit modal functions
-        function showNameEditModal(index, currentName) {
-            pendingNameEdit = index;
-            document.getElementById('nameEditModal').style.display = 'flex';
-            document.body.classList.add('modal-open');
-            
-            const input = document.getElementById('newPlantName');
-            input.value = currentName;
-            input.select();
-            
-            document.getElementById('confirmNameButton').onclick = () => {
-                const newName = input.value.trim();
-                if (newName) {
-                    updatePlantName(pendingNameEdit, newName);
-                }
-                hideNameEditModal();
-            };
-
-            input.onkeyup = (e) => {
-                if (e.key === 'Enter') {
-                    document.getElementById('confirmNameButton').click();
-                } else if (e.key === 'Escape') {
-                    hideNameEditModal();
-                }
-            };
-        }
-
-        function hideNameEditModal() {
-            document.getElementById('nameEditModal').style.display = 'none';
-            document.body.classList.remove('modal-open');
-            pendingNameEdit = null;
-        }
-
-        // Close modals when clicking outside
-        document.getElementById('confirmModal').addEventListener('click', (e) => {
-            if (e.target.id === 'confirmModal') {
-                hideConfirmModal();
-            }
-        });
-
-        document.getElementById('nameEditModal').addEventListener('click', (e) => {
-            if (e.target.id === 'nameEditModal') {
-                hideNameEditModal();
-            }
-        });
-
-        // Wrapper functions for backward compatibility
-        async function updateWateringAmount(index, amount) {
-            return updatePlantAmount(index, amount);
-        }
-
-        async function updateWateringInterval(index, days) {
-            return updatePlantInterval(index, days);
-        }
-
-        // Update dashboard to use fetchPlants
-        async function updateDashboard() {
-            return fetchPlants();
-        }
-
-        async function fetchPlants() {
-            try {
-                const response = await fetch(API_ENDPOINT);
-                if (!response.ok) throw new Error('Failed to fetch plants');
-                const plants = await response.json();
-                
-                if (!Array.isArray(plants)) throw new Error('Invalid data format');
-
-                const container = document.getElementById('plants-container');
-                if (!container) throw new Error('Container not found');
-
-                container.innerHTML = plants.map((plant, index) => createPlantCard(plant, index)).join('') || `
-                    <div class="col-span-3 text-center p-8">
-                        <div class="inline-block p-6 bg-yellow-50 rounded-lg">
-                            <p class="text-yellow-600 font-medium">No plants found</p>
-                        </div>
-                    </div>
-                `;
-
-                updateTimestamp();
-                const indicator = document.getElementById('status-indicator');
-                if (indicator) {
-                    indicator.classList.remove('bg-red-500');
-                    indicator.classList.add('bg-green-500');
-                }
-            } catch (error) {
-                const container = document.getElementById('plants-container');
-                const indicator = document.getElementById('status-indicator');
-
-                if (indicator) {
-                    indicator.classList.remove('bg-green-500');
-                    indicator.classList.add('bg-red-500');
-                }
-
-                if (container) {
-                    container.innerHTML = `
-                        <div class="col-span-3 text-center p-8">
-                            <div class="inline-block p-6 bg-red-50 rounded-lg">
-                                <p class="text-red-600 font-medium">Error loading plant data</p>
-                                <p class="text-red-500 text-sm mt-2">Please check your connection and try again</p>
-                            </div>
-                        </div>
-                    `;
-                }
-            }
-        }
-
-        async function waterNow(index) {
-            try {
-                const response = await fetch(`${API_ENDPOINT}/water-now`, {
-                    method: 'POST',
-                    headers: { 'Content-Type': 'application/json' },
-                    body: JSON.stringify({ plantIndex: index })
-                });
-                
-                if (!response.ok) throw new Error('Failed to water plant');
-                await fetchPlants();
-            } catch {
-                alert('Failed to water plant. Please try again.');
-            }
-        }
-
-        async function updatePlantAmount(index, amount) {
-            try {
-                const response = await fetch(`${API_ENDPOINT}/amount`, {
-                    method: 'PUT',
-                    headers: { 'Content-Type': 'application/json' },
-                    body: JSON.stringify({ plantIndex: index, ozPerWatering: amount })
-                });
-                
-                if (!response.ok) throw new Error('Failed to update amount');
-                await fetchPlants();
-            } catch {
-                alert('Failed to update amount. Please try again.');
-            }
-        }
-
-        async function updatePlantInterval(index, days) {
-            try {
-                const response = await fetch(`${API_ENDPOINT}/interval`, {
-                    method: 'PUT',
-                    headers: { 'Content-Type': 'application/json' },
-                    body: JSON.stringify({ plantIndex: index, intervalDays: days })
-                });
-                
-                if (!response.ok) throw new Error('Failed to update interval');
-                await fetchPlants();
-            } catch {
-                alert('Failed to update interval. Please try again.');
-            }
-        }
-
-        async function updatePlantName(index, name) {
-            try {
-                const response = await fetch(`${API_ENDPOINT}/name`, {
-                    method: 'PUT',
-                    headers: { 'Content-Type': 'application/json' },
-                    body: JSON.stringify({ plantIndex: index, name: name })
-                });
-                
-                if (!response.ok) throw new Error('Failed to update name');
-                await fetchPlants();
-            } catch {
-                alert('Failed to update name. Please try again.');
-            }
-        }
-
-        function createPlantCard(plant, index) {
-            if (!plant || !plant.name) return '';
-
-            return `
-                <div class="bg-white rounded-xl shadow-lg overflow-hidden">
-                    <div class="p-4 sm:p-6">
-                        <div class="flex justify-between items-start mb-4">
-                            <div class="flex items-center space-x-2">
-                                <h2 class="text-xl sm:text-2xl font-semibold text-gray-800 mb-1">${plant.name}</h2>
-                                <button 
-                                    onclick="showNameEditModal(${index}, '${plant.name.replace(/'/g, "\\'")}')"
-                                    class="edit-icon p-1 text-gray-400 hover:text-gray-600"
-                                >
-                                    ✎
-                                </button>
-                            </div>
-                            <div class="flex flex-col items-end">
-                                <span class="text-gray-500 text-sm mb-1">Pump ${index + 1}</span>
-                            </div>
-                        </div>
-
-                        <div class="space-y-4 bg-gray-50 p-4 rounded-lg mb-4">
-                            <div class="flex flex-col space-y-2">
-                                <label class="text-gray-600 text-sm">Water Amount (oz):</label>
-                                <div class="flex space-x-2">
-                                    <input 
-                                        type="number" 
-                                        step="0.1" 
-                                        value="${plant.ozPerWatering}"
-                                        class="flex-1 border rounded-lg px-3 py-2 shadow-sm"
-                                        onchange="updatePlantAmount(${index}, parseFloat(this.value))"
-                                    >
-                                </div>
-                            </div>
-                            <div class="flex flex-col space-y-2">
-                                <label class="text-gray-600 text-sm">Watering Interval (days):</label>
-                                <div class="flex space-x-2">
-                                    <input 
-                                        type="number" 
-                                        step="0.5" 
-                                        value="${(plant.intervalMinutes / 1440).toFixed(1)}"
-                                        class="flex-1 border rounded-lg px-3 py-2 shadow-sm"
-                                        onchange="updatePlantInterval(${index}, parseFloat(this.value))"
-                                    >
-                                </div>
-                            </div>
-                            <button 
-                                onclick="showConfirmModal(${index})"
-                                class="w-full bg-blue-500 hover:bg-blue-600 active:bg-blue-700 text-white font-medium py-3 px-4 rounded-lg transition-colors"
-                            >
-                                Water Now
-                            </button>
-                        </div>
-
-                        <div class="border-t pt-4">
-                            <h3 class="text-sm font-semibold text-gray-700 mb-3">Recent Watering History</h3>
-                            <div class="space-y-3">
-                                ${(plant.wateringHistory || []).map((event, i) => `
-                                    <div class="flex justify-between items-center text-sm ${i === 0 ? 'text-gray-800 font-medium' : 'text-gray-500'}">
-                                        <span>${formatDate(event.timestamp)}</span>
-                                        <span class="font-mono">${event.amount.toFixed(1)} oz</span>
-                                    </div>
-                                `).join('')}
-                            </div>
-                        </div>
-                    </div>
-                </div>
-            `;
-        }
-
-        function updateTimestamp() {
-            const status = document.getElementById('update-status');
-            if (status) {
-                status.textContent = `Last updated: ${new Date().toLocaleTimeString()}`;
-            }
-        }
-
-        // Initial load and setup refresh
-        fetchPlants();
-        setInterval(fetchPlants, 60000);
-    </script>
-</body>
-</html>
-)rawliteral";
-
-#endif
\ No newline at end of file
+#include <Arduino.h>
+
+// First 8 hex digits of the SHA-256 of the minified page
+#define HOMEPAGE_HASH "cd773291"
+
+// 17970 bytes of minified HTML, gzip-compressed
+const size_t HOMEPAGE_GZ_LEN = 5456;
+const uint8_t HOMEPAGE_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xc5, 0x3c, 0xed, 0x92, 0xdb, 0x36,
+    0x92, 0xff, 0xf5, 0x14, 0x08, 0xe3, 0xac, 0xa4, 0x0d, 0xc9, 0xa1, 0xbe, 0xe6, 0x83, 0x1a, 0x29,
+    0xeb, 0xd8, 0x4e, 0xc5, 0xbb, 0xf6, 0xc4, 0x95, 0x71, 0xee, 0xea, 0x2a, 0x49, 0xc5, 0x10, 0x09,
+    0x49, 0xc8, 0x90, 0x00, 0x8b, 0x84, 0x46, 0x92, 0x15, 0xde, 0x23, 0xdc, 0x13, 0xdc, 0xd3, 0xdd,
+    0x93, 0x5c, 0x35, 0x00, 0x82, 0x20, 0xa5, 0x99, 0x38, 0x8e, 0x2f, 0x57, 0x5b, 0xe5, 0x0c, 0xd1,
+    0x8d, 0x6e, 0xa0, 0xbb, 0xd1, 0xdd, 0x68, 0xb4, 0xf6, 0xfa, 0xb3, 0xe7, 0xdf, 0x3d, 0x7b, 0xfb,
+    0x1f, 0x6f, 0x5e, 0xa0, 0xb5, 0x48, 0x93, 0xf9, 0x35, 0xfc, 0x8b, 0x12, 0xcc, 0x56, 0x33, 0x87,
+    0x30, 0x67, 0x7e, 0xbd, 0x26, 0x38, 0x9e, 0x5f, 0xa7, 0x44, 0x60, 0x14, 0xad, 0x71, 0x5e, 0x10,
+    0x31, 0x73, 0x7e, 0x78, 0xfb, 0x8d, 0x77, 0xe9, 0xe8, 0x51, 0x86, 0x53, 0x32, 0x73, 0xee, 0x29,
+    0xd9, 0x66, 0x3c, 0x17, 0x0e, 0x8a, 0x38, 0x13, 0x84, 0x89, 0x99, 0xb3, 0xa5, 0xb1, 0x58, 0xcf,
+    0x62, 0x72, 0x4f, 0x23, 0xe2, 0xc9, 0x0f, 0x17, 0x51, 0x46, 0x05, 0xc5, 0x89, 0x57, 0x44, 0x38,
+    0x21, 0xb3, 0x81, 0x1f, 0xb8, 0x28, 0xc5, 0x3b, 0x9a, 0x6e, 0x52, 0x7b, 0x68, 0x53, 0x90, 0x5c,
+    0x7e, 0xe3, 0x45, 0x42, 0x66, 0x8c, 0x3b, 0xf3, 0x6b, 0x41, 0x45, 0x42, 0xe6, 0xb7, 0x29, 0xce,
+    0x05, 0x7a, 0x93, 0x60, 0x26, 0xd0, 0xbf, 0x63, 0x41, 0x72, 0xca, 0x56, 0xe8, 0x76, 0x5f, 0x08,
+    0x92, 0x5e, 0x9f, 0x29, 0x94, 0xeb, 0x42, 0xec, 0x13, 0x32, 0xff, 0xbb, 0x1b, 0x86, 0x0b, 0xb2,
+    0xe4, 0x39, 0x71, 0xc3, 0x10, 0x2f, 0x05, 0xc9, 0x0f, 0x0b, 0xbe, 0xf3, 0x0a, 0xfa, 0x9e, 0xb2,
+    0x55, 0xb8, 0xe0, 0x79, 0x4c, 0x72, 0x6f, 0xc1, 0x77, 0x53, 0xf5, 0x67, 0x18, 0xa0, 0x82, 0x27,
+    0x34, 0x46, 0x9f, 0x93, 0x09, 0xb9, 0x20, 0x8b, 0xa9, 0xe7, 0x89, 0xad, 0x07, 0xe4, 0x3d, 0xbe,
+    0x5c, 0x16, 0x44, 0xa8, 0x0d, 0x84, 0x41, 0xb6, 0x3b, 0x06, 0x45, 0x3c, 0xe1, 0x79, 0xf8, 0xf9,
+    0x72, 0xb9, 0xb4, 0x60, 0x6a, 0x30, 0x5f, 0x2d, 0x70, 0x6f, 0x72, 0xe5, 0x0e, 0x46, 0x81, 0x3b,
+    0x1c, 0x9f, 0xbb, 0x81, 0x3f, 0xe9, 0x1f, 0x13, 0x28, 0xd6, 0x38, 0xe6, 0xdb, 0x30, 0x40, 0x01,
+    0xfa, 0x3c, 0x08, 0x82, 0xc0, 0xc2, 0x38, 0x0d, 0x6a, 0x8f, 0x96, 0xa0, 0xb5, 0x43, 0x42, 0x19,
+    0xf1, 0xd6, 0x84, 0xae, 0xd6, 0x22, 0x1c, 0xf8, 0x93, 0xa9, 0xb7, 0x25, 0x8b, 0x3b, 0x2a, 0x3c,
+    0x41, 0x76, 0x02, 0x76, 0x4e, 0x3c, 0x1c, 0xff, 0xba, 0x29, 0x44, 0x38, 0x08, 0x82, 0x2f, 0xa6,
+    0x4b, 0xce, 0x84, 0xb7, 0xc4, 0x29, 0x4d, 0xf6, 0xe1, 0x86, 0x7a, 0x05, 0x66, 0x85, 0x57, 0x90,
+    0x9c, 0x2e, 0xdd, 0x42, 0x0a, 0xd4, 0xdb, 0x50, 0xd7, 0xc3, 0x59, 0x96, 0x10, 0x4f, 0x0d, 0xb8,
+    0x5f, 0x27, 0x94, 0xdd, 0xbd, 0xc6, 0x91, 0x12, 0xf8, 0x37, 0x9c, 0x09, 0xd7, 0xb9, 0x25, 0x2b,
+    0x4e, 0xd0, 0x0f, 0x2f, 0x1d, 0xf7, 0x7b, 0xbe, 0xe0, 0x82, 0xbb, 0xce, 0xb7, 0x24, 0xb9, 0x27,
+    0x82, 0x46, 0x18, 0xdd, 0x90, 0x0d, 0x71, 0xdc, 0xa7, 0x39, 0xc5, 0x89, 0xeb, 0xdc, 0x70, 0xc1,
+    0xd1, 0x2d, 0x66, 0x85, 0xe3, 0x5a, 0xac, 0x9c, 0xa7, 0xc0, 0x00, 0x3d, 0x03, 0x61, 0xa1, 0x17,
+    0x29, 0xff, 0x95, 0x3a, 0x35, 0xcd, 0xe3, 0x81, 0xdb, 0x7d, 0xba, 0xe0, 0x89, 0xa3, 0xa9, 0xd9,
+    0xb3, 0xca, 0x05, 0x8f, 0xf7, 0x87, 0x14, 0xe7, 0x2b, 0xca, 0xc2, 0xa0, 0xb1, 0x39, 0xca, 0xd6,
+    0x24, 0xa7, 0x62, 0x6a, 0x8b, 0x47, 0x8f, 0x95, 0xeb, 0x81, 0xbb, 0x1e, 0xba, 0xeb, 0x91, 0x9b,
+    0x99, 0xb9, 0x66, 0xec, 0x20, 0x89, 0x80, 0xdc, 0x0c, 0x09, 0x39, 0xb2, 0x6d, 0x92, 0x58, 0x6c,
+    0x84, 0xe0, 0xcc, 0xa5, 0x2c, 0xdb, 0x88, 0xc3, 0x29, 0xbe, 0x35, 0x19, 0x29, 0xf7, 0x13, 0xcb,
+    0x98, 0x2a, 0x63, 0xa9, 0xbe, 0xcc, 0x2e, 0x32, 0x1c, 0xc7, 0x60, 0xae, 0x81, 0x66, 0x72, 0x90,
+    0x9a, 0x14, 0x39, 0x66, 0xc5, 0x92, 0xe7, 0x69, 0xc8, 0x38, 0x23, 0xd3, 0x05, 0x8e, 0xee, 0x56,
+    0x39, 0xdf, 0xb0, 0x58, 0xdb, 0x9c, 0x84, 0x67, 0x38, 0x27, 0x4c, 0xd8, 0x40, 0x9a, 0xe2, 0x15,
+    0x51, 0x53, 0xa2, 0x4d, 0x5e, 0xf0, 0x3c, 0xcc, 0x38, 0x65, 0x82, 0xe4, 0xc6, 0x4e, 0x70, 0x96,
+    0x11, 0x9c, 0x63, 0x16, 0x91, 0x50, 0xf1, 0x2b, 0xe5, 0xa6, 0xc2, 0x30, 0x4b, 0x70, 0x44, 0xd6,
+    0x3c, 0x89, 0x49, 0x7e, 0xe0, 0x19, 0x8e, 0xa8, 0xd8, 0x87, 0x03, 0xbd, 0xe8, 0xcf, 0xaf, 0x22,
+    0x3c, 0xc2, 0xcb, 0xd2, 0x2f, 0x32, 0x1c, 0x11, 0x6f, 0xef, 0x0d, 0xe7, 0x21, 0xe3, 0xa2, 0xf7,
+    0xe3, 0x9a, 0xc6, 0x31, 0x61, 0x3f, 0xf7, 0xff, 0xb3, 0xf9, 0xa9, 0xe5, 0xec, 0x09, 0x9e, 0x85,
+    0x81, 0x3f, 0xc9, 0x49, 0x5a, 0x4d, 0xdd, 0x7d, 0xe8, 0xd4, 0x84, 0x2c, 0x45, 0x6b, 0xee, 0xde,
+    0x1b, 0xfd, 0x11, 0xb6, 0x17, 0x4d, 0xbe, 0xa3, 0x3f, 0xc4, 0xf7, 0xa2, 0xc9, 0x78, 0xfc, 0xe1,
+    0x8c, 0x07, 0x72, 0xe2, 0x62, 0xe5, 0x6d, 0xd7, 0x54, 0x90, 0xc3, 0x91, 0xe6, 0xc0, 0x85, 0x48,
+    0xf8, 0x2a, 0xc7, 0x7b, 0x6f, 0x12, 0x9c, 0xc2, 0xb8, 0x5a, 0xe2, 0xe5, 0xa2, 0x46, 0x1a, 0x04,
+    0x27, 0xb1, 0x46, 0xcb, 0xf1, 0xf2, 0x5c, 0x62, 0xe5, 0x24, 0x7e, 0x80, 0x12, 0x59, 0x0e, 0x97,
+    0x43, 0x0b, 0xe7, 0x14, 0x12, 0x59, 0x8e, 0xc7, 0xe3, 0xb1, 0x44, 0xda, 0x93, 0x24, 0xe1, 0xdb,
+    0x07, 0x68, 0x2d, 0x97, 0x0b, 0x52, 0xad, 0x8a, 0x10, 0xf6, 0xc0, 0xb2, 0xe2, 0xc1, 0x12, 0x93,
+    0x89, 0x85, 0x76, 0x9a, 0xe9, 0x20, 0x58, 0x5c, 0x5d, 0x0e, 0x24, 0xda, 0x22, 0xd9, 0x90, 0xd3,
+    0x2c, 0xc9, 0x72, 0x79, 0xae, 0xa5, 0xa5, 0x91, 0x4e, 0x61, 0x8d, 0x16, 0x97, 0x43, 0x10, 0xc4,
+    0x9a, 0xdf, 0x93, 0xfc, 0xa7, 0xb0, 0x92, 0xda, 0x30, 0x08, 0x42, 0x39, 0x74, 0x8a, 0xb0, 0x0c,
+    0x00, 0xf6, 0x14, 0x49, 0xff, 0xfc, 0x91, 0x29, 0xc3, 0xc9, 0xf9, 0x08, 0xa6, 0xe0, 0x48, 0xd0,
+    0x7b, 0x52, 0xcf, 0xb9, 0x08, 0x82, 0x50, 0x8d, 0x9d, 0xda, 0x65, 0x3c, 0x26, 0xf1, 0x65, 0xa5,
+    0xc9, 0x98, 0x12, 0x26, 0x3c, 0xc1, 0xbd, 0x45, 0x83, 0x81, 0x3a, 0xb4, 0xe0, 0x32, 0x70, 0x6e,
+    0xd0, 0x7a, 0x82, 0xa3, 0x05, 0x17, 0x82, 0xa7, 0x28, 0x07, 0x37, 0xe2, 0xde, 0xe3, 0xbc, 0x27,
+    0xe3, 0x82, 0x21, 0x54, 0x08, 0x9e, 0x15, 0xfd, 0x7e, 0xe9, 0x2f, 0x73, 0x9e, 0x1a, 0x61, 0x1f,
+    0x9a, 0x48, 0x00, 0x0b, 0x3f, 0x27, 0xd1, 0x32, 0x5e, 0x4e, 0xa6, 0x27, 0xe6, 0x87, 0xc7, 0x74,
+    0x61, 0x4a, 0xff, 0x04, 0x3f, 0xc1, 0x5d, 0x19, 0xea, 0x86, 0xa3, 0x73, 0x77, 0x38, 0x19, 0xb9,
+    0xc3, 0xf1, 0xc4, 0x0d, 0x80, 0x3f, 0xec, 0x48, 0xeb, 0xb0, 0x3d, 0xc3, 0xd2, 0xa1, 0x0a, 0xc7,
+    0x52, 0x35, 0x23, 0xd0, 0xa3, 0xfa, 0x36, 0x56, 0x13, 0x4f, 0xe2, 0x45, 0xe9, 0x2f, 0x79, 0xb4,
+    0x29, 0x7e, 0x32, 0xb1, 0x5b, 0x2b, 0x3d, 0x94, 0xc3, 0xad, 0x29, 0x95, 0xda, 0xa5, 0x10, 0x49,
+    0xec, 0x25, 0xab, 0x0a, 0x01, 0xd8, 0x6f, 0x0a, 0xe3, 0x3d, 0x2a, 0x84, 0x5d, 0x72, 0x84, 0x70,
+    0xd1, 0xc4, 0x58, 0x6e, 0x92, 0x36, 0xce, 0xd5, 0xd5, 0xd5, 0x55, 0xb6, 0xab, 0x96, 0x5f, 0x01,
+    0x55, 0xa2, 0x30, 0xa8, 0x01, 0x9e, 0xa8, 0x40, 0x82, 0x67, 0x0d, 0x70, 0xc2, 0xa3, 0xbb, 0x43,
+    0x4c, 0x8b, 0x2c, 0xc1, 0xfb, 0x50, 0x7e, 0x95, 0x3e, 0x65, 0x32, 0x40, 0x34, 0x61, 0xf6, 0x60,
+    0xe9, 0x2f, 0x13, 0xb2, 0x33, 0x20, 0xf8, 0x30, 0xb3, 0x1a, 0x10, 0x6b, 0xac, 0xf4, 0x57, 0x39,
+    0x8d, 0x0d, 0x04, 0x3e, 0x14, 0x19, 0x10, 0xd8, 0x41, 0xfe, 0x11, 0xd3, 0x9c, 0x44, 0x82, 0x72,
+    0x16, 0x46, 0x3c, 0xd9, 0xa4, 0xac, 0xf4, 0xa9, 0x20, 0x69, 0xe1, 0x15, 0x02, 0xe7, 0xe2, 0x80,
+    0x13, 0xba, 0x62, 0x9e, 0x1c, 0x91, 0x1c, 0xd5, 0x70, 0x85, 0x43, 0x58, 0x7c, 0x8c, 0x41, 0x58,
+    0x5c, 0xc1, 0x23, 0x02, 0x71, 0xa6, 0x81, 0xa2, 0x86, 0x4a, 0x1f, 0xf2, 0x11, 0xba, 0xdc, 0x4b,
+    0x12, 0xd5, 0xdf, 0x3a, 0x83, 0xb4, 0xc8, 0x54, 0x90, 0x05, 0x11, 0x5b, 0x42, 0xd8, 0x11, 0xa6,
+    0xf2, 0xc5, 0x1a, 0xaa, 0x77, 0x36, 0x90, 0xfb, 0x0a, 0x07, 0x68, 0x80, 0x82, 0x2f, 0xc0, 0x7a,
+    0x98, 0xf0, 0x52, 0xce, 0xf8, 0xa1, 0x95, 0xf8, 0xc0, 0x98, 0x9c, 0xef, 0xde, 0x7e, 0xf3, 0x9a,
+    0x33, 0xee, 0x7d, 0x4f, 0x56, 0x9b, 0x04, 0xe7, 0xee, 0x6b, 0xc2, 0x12, 0xee, 0xbe, 0xe6, 0x0c,
+    0x47, 0xdc, 0x7d, 0xc6, 0x59, 0xc1, 0x13, 0x5c, 0xb8, 0xce, 0x2b, 0xba, 0x20, 0x39, 0x06, 0x49,
+    0x21, 0x40, 0x77, 0x5c, 0xe7, 0x19, 0xdf, 0xe4, 0x94, 0xe4, 0xe8, 0x86, 0x6c, 0x1d, 0xd7, 0x90,
+    0xab, 0x58, 0x92, 0x98, 0x6e, 0xd2, 0x83, 0x9d, 0x39, 0x4c, 0x82, 0x40, 0x03, 0x0b, 0x92, 0xd2,
+    0x05, 0x4f, 0xe2, 0x06, 0xf8, 0xdc, 0x80, 0x8f, 0x40, 0x17, 0x00, 0x5a, 0x7b, 0xa3, 0x83, 0xce,
+    0x1f, 0x8c, 0x95, 0xaa, 0x14, 0x2f, 0xb5, 0x52, 0x96, 0xc0, 0xbf, 0x94, 0xb0, 0x69, 0x33, 0x2b,
+    0x1c, 0x5a, 0xf8, 0xc9, 0xca, 0xc2, 0x1f, 0xf8, 0x83, 0xe1, 0x09, 0x7c, 0x9b, 0xfe, 0x2e, 0x69,
+    0xe0, 0xff, 0x1e, 0xfa, 0xa8, 0x85, 0x7f, 0x62, 0x3d, 0xc3, 0x6a, 0x3d, 0xe9, 0xce, 0xc3, 0x1b,
+    0xc1, 0x1b, 0x91, 0x16, 0x06, 0x74, 0x2e, 0xe4, 0x49, 0x3f, 0x27, 0x47, 0x4a, 0x3f, 0x5d, 0x78,
+    0x83, 0x0a, 0x51, 0xb9, 0xc1, 0x30, 0x30, 0x74, 0x84, 0x37, 0x3c, 0x95, 0x61, 0xa4, 0x79, 0x3d,
+    0x9e, 0x6b, 0xd1, 0x69, 0xc8, 0xa2, 0x86, 0x18, 0x6a, 0x06, 0x34, 0x3a, 0x02, 0x5d, 0x18, 0x46,
+    0xe3, 0xe3, 0xd0, 0x9e, 0x2e, 0xea, 0x51, 0x3d, 0xc3, 0x00, 0xce, 0xdb, 0x80, 0x9a, 0xcb, 0x65,
+    0x0b, 0x34, 0x54, 0x00, 0xbc, 0xf3, 0xb6, 0xde, 0xc5, 0x2e, 0x39, 0xc8, 0xbf, 0xa4, 0xdf, 0xb8,
+    0x0c, 0x14, 0x88, 0x32, 0x6f, 0xed, 0x15, 0x11, 0xf8, 0xf5, 0x83, 0xfc, 0xd0, 0x0a, 0x08, 0x82,
+    0xfb, 0xb5, 0xf1, 0x94, 0x7c, 0x23, 0xa4, 0xb0, 0x21, 0xe7, 0xd3, 0x6e, 0x52, 0x0f, 0x85, 0xc3,
+    0x6c, 0xa7, 0x2f, 0x3c, 0x76, 0xb6, 0x58, 0x4d, 0x50, 0xd7, 0x12, 0x40, 0x2a, 0x7d, 0x08, 0x79,
+    0x4b, 0x08, 0xfc, 0x2a, 0xa1, 0x39, 0x54, 0xdf, 0xa1, 0xfa, 0x2e, 0xfd, 0xcc, 0x1b, 0x1c, 0x4c,
+    0xa2, 0x5a, 0xe9, 0x21, 0xf3, 0xc6, 0x66, 0x70, 0xa0, 0x47, 0xce, 0xeb, 0x11, 0xbf, 0xc2, 0xba,
+    0x34, 0x63, 0x6a, 0xcf, 0xd9, 0xde, 0x1b, 0x56, 0x43, 0x96, 0x02, 0xab, 0x4c, 0xb8, 0xad, 0xa1,
+    0x6c, 0xe7, 0x8d, 0x0c, 0xba, 0x9d, 0x9e, 0x99, 0x09, 0x79, 0xf3, 0x9c, 0x64, 0x7b, 0x6b, 0x82,
+    0x95, 0x0b, 0x1e, 0x33, 0xb8, 0x30, 0x1c, 0xc6, 0x4d, 0x0e, 0x83, 0x63, 0xf2, 0x7a, 0x87, 0xc2,
+    0x42, 0xad, 0x6d, 0x42, 0x9e, 0x05, 0xed, 0x01, 0xe5, 0xdf, 0xd2, 0x0d, 0x1a, 0x07, 0x28, 0x87,
+    0x54, 0x3e, 0x68, 0x27, 0x81, 0x72, 0x58, 0x06, 0xc4, 0x71, 0x10, 0x1c, 0x5a, 0xa9, 0x76, 0x0d,
+    0x9c, 0xd4, 0xc0, 0xf3, 0xc5, 0xc5, 0xf0, 0x32, 0xb0, 0x81, 0xe7, 0x35, 0x70, 0xbc, 0x98, 0x4c,
+    0xce, 0x47, 0x36, 0xf0, 0xa2, 0x06, 0x8e, 0x2e, 0xc6, 0x83, 0xc9, 0xc0, 0x06, 0x5e, 0xd6, 0xc0,
+    0xc1, 0x72, 0x78, 0x35, 0xba, 0xb0, 0x81, 0x57, 0x16, 0x70, 0x30, 0xb8, 0x1c, 0x56, 0xc0, 0x2a,
+    0x8b, 0x6c, 0xa5, 0x8e, 0x06, 0x66, 0x2d, 0x27, 0x8e, 0x86, 0xe7, 0xc3, 0x73, 0x0d, 0xd3, 0x89,
+    0xa5, 0x0d, 0xbe, 0xba, 0xb8, 0x08, 0xce, 0x0d, 0x4f, 0x48, 0x5e, 0xac, 0xe5, 0x06, 0xe3, 0x8b,
+    0xcb, 0x49, 0xc5, 0xb4, 0xca, 0xcd, 0x0e, 0xad, 0x54, 0x4c, 0x67, 0x6f, 0x0d, 0x61, 0xe8, 0xfc,
+    0xad, 0x25, 0x12, 0x75, 0x97, 0x06, 0xe7, 0xd9, 0xbc, 0x5a, 0x0f, 0xb2, 0x1d, 0x82, 0x63, 0x12,
+    0x20, 0x99, 0xd9, 0x04, 0xae, 0xfc, 0x9f, 0x1f, 0x4c, 0xfa, 0x53, 0x59, 0x49, 0x50, 0x78, 0x26,
+    0x15, 0x3a, 0xbe, 0xcf, 0xbb, 0xe6, 0x7a, 0x6e, 0x65, 0x4c, 0xd6, 0xa5, 0xfe, 0x24, 0x5c, 0x81,
+    0xfa, 0x66, 0x59, 0xc9, 0xaa, 0xbd, 0xac, 0x20, 0xdb, 0xa1, 0xc1, 0x24, 0xdb, 0x21, 0x6f, 0x94,
+    0xed, 0x9a, 0x6b, 0x1b, 0xf4, 0xdd, 0x00, 0x8d, 0xb3, 0x1d, 0x3a, 0x07, 0xf0, 0xb0, 0x0d, 0xfe,
+    0xab, 0x96, 0xae, 0xdd, 0x8f, 0xc4, 0x1f, 0x6a, 0xc7, 0xf3, 0x58, 0xcd, 0x23, 0x40, 0x27, 0x97,
+    0x22, 0x3d, 0x5e, 0xff, 0x34, 0x4c, 0xea, 0xb0, 0x7f, 0xba, 0x4e, 0x12, 0xa0, 0x08, 0x27, 0x51,
+    0x0f, 0xb6, 0xff, 0xe5, 0x63, 0x94, 0xdb, 0xa4, 0x35, 0xcd, 0x0f, 0x93, 0xd0, 0x69, 0xb9, 0x1c,
+    0x49, 0xc3, 0x12, 0x54, 0x53, 0x2e, 0xad, 0xf4, 0xb5, 0x5d, 0x37, 0x32, 0x19, 0xac, 0x74, 0xcf,
+    0x14, 0xb2, 0x0d, 0x05, 0x29, 0x0e, 0xd6, 0x48, 0x96, 0xf3, 0x8c, 0xe4, 0x62, 0x1f, 0xb6, 0x6f,
+    0x17, 0xae, 0x9d, 0x0e, 0xbb, 0xea, 0xdf, 0x25, 0x4d, 0x12, 0xb7, 0x10, 0x39, 0xbf, 0x23, 0x53,
+    0x8b, 0x86, 0xa0, 0x29, 0xb0, 0x5d, 0x6e, 0x98, 0xce, 0xfe, 0x36, 0x0b, 0x1a, 0x79, 0x0b, 0xf2,
+    0x9e, 0x92, 0xbc, 0x17, 0xf8, 0x63, 0x69, 0x39, 0x43, 0x77, 0xd0, 0xb7, 0x27, 0xc5, 0x1b, 0x95,
+    0x01, 0x85, 0x83, 0x49, 0x90, 0x16, 0x2a, 0xbb, 0x04, 0x66, 0x85, 0x37, 0x38, 0xc8, 0xbf, 0x05,
+    0x49, 0xb3, 0x04, 0x0b, 0xe2, 0xa9, 0x64, 0xb2, 0x08, 0x73, 0x92, 0x11, 0x2c, 0x7a, 0x03, 0x37,
+    0xa5, 0x2c, 0xc5, 0xbb, 0x5e, 0xe0, 0x0e, 0x96, 0x39, 0x5c, 0x10, 0x22, 0x9e, 0x78, 0x45, 0x86,
+    0x99, 0x37, 0x3a, 0x54, 0x54, 0x36, 0x29, 0x83, 0x8c, 0x8e, 0xa1, 0xd1, 0x99, 0xfa, 0x4f, 0xe9,
+    0xaf, 0x30, 0xc4, 0x8f, 0x15, 0xce, 0x4c, 0xec, 0xd8, 0x7a, 0xa3, 0x83, 0xae, 0xc9, 0x55, 0xbe,
+    0x7a, 0xab, 0x92, 0x74, 0x9d, 0x61, 0x07, 0xc1, 0x17, 0xe5, 0x3f, 0x20, 0xfb, 0xc2, 0xa8, 0x07,
+    0x21, 0x52, 0x0d, 0x9f, 0x8f, 0x83, 0x6c, 0xd7, 0x3f, 0xf8, 0x45, 0xfa, 0x53, 0x78, 0x2a, 0x24,
+    0xc1, 0xb8, 0x74, 0x1a, 0xc3, 0x56, 0xf6, 0x72, 0x9c, 0xbb, 0x00, 0x7e, 0x79, 0x7d, 0xa6, 0xea,
+    0x8d, 0xba, 0xec, 0x28, 0x0b, 0x26, 0x3f, 0x8a, 0x7d, 0x46, 0x66, 0x0e, 0xdb, 0xa4, 0x0b, 0x92,
+    0x3b, 0x3f, 0xbb, 0xf6, 0x20, 0xd0, 0x76, 0x7e, 0x3e, 0x9c, 0x28, 0xb9, 0xc8, 0xca, 0x8c, 0x29,
+    0xfd, 0x78, 0x29, 0x7f, 0x6f, 0x43, 0x61, 0xde, 0x92, 0x92, 0x24, 0x9e, 0x36, 0xef, 0x20, 0x97,
+    0xd9, 0xae, 0x2e, 0x13, 0xa9, 0x3d, 0x48, 0x76, 0x6e, 0x41, 0x12, 0x12, 0x09, 0x17, 0xe6, 0xe1,
+    0x9c, 0x60, 0x7b, 0x2f, 0xe7, 0xd9, 0xae, 0x2a, 0x28, 0x99, 0xed, 0xc3, 0x69, 0xf9, 0x8c, 0xa6,
+    0x50, 0xc2, 0xc5, 0x4c, 0x4c, 0x05, 0xdf, 0x44, 0x6b, 0x0f, 0x2b, 0x93, 0x48, 0x31, 0xa3, 0xd9,
+    0x26, 0x91, 0x1a, 0x57, 0x75, 0x36, 0xf0, 0xa3, 0x45, 0x94, 0xf3, 0x24, 0xf1, 0x16, 0x64, 0x8d,
+    0xef, 0x29, 0xcf, 0xbd, 0x7d, 0x08, 0xd9, 0x38, 0xa6, 0xac, 0xf4, 0x35, 0x48, 0x7f, 0x93, 0xdc,
+    0x6c, 0xd7, 0x24, 0x13, 0x0a, 0x03, 0x38, 0x4b, 0x4e, 0xa5, 0x9f, 0xf2, 0x18, 0x27, 0x87, 0x8c,
+    0x2b, 0x03, 0x0b, 0x97, 0x74, 0x47, 0xe2, 0xa9, 0x0c, 0xd0, 0x53, 0x15, 0xd7, 0xa7, 0x3a, 0x92,
+    0x4f, 0xab, 0x08, 0x7d, 0x5c, 0xf8, 0x6a, 0x38, 0xbb, 0x49, 0x7f, 0x6a, 0x5f, 0x91, 0xa6, 0xed,
+    0x2b, 0x83, 0x8a, 0xbf, 0xd3, 0xe3, 0x3b, 0xc9, 0xf4, 0xbd, 0x47, 0x59, 0x4c, 0x76, 0xe1, 0x24,
+    0xd0, 0xcb, 0xaa, 0xe6, 0x1c, 0x5f, 0xe2, 0x65, 0xdc, 0x9e, 0x36, 0x6d, 0xa8, 0xa5, 0x20, 0x99,
+    0x2e, 0x28, 0xdb, 0xbb, 0x0a, 0xbe, 0x98, 0xd6, 0xa9, 0xdc, 0x38, 0x80, 0x62, 0xb2, 0x56, 0xf8,
+    0x40, 0x4d, 0xdc, 0xd5, 0x7e, 0x6c, 0x08, 0x7e, 0x7e, 0x28, 0xfd, 0xfc, 0x44, 0x39, 0xf2, 0x9e,
+    0x72, 0x6e, 0x67, 0x48, 0x3b, 0xfa, 0x4b, 0x08, 0x04, 0x80, 0xe5, 0x9d, 0x9f, 0x40, 0xa8, 0xd6,
+    0xce, 0xb3, 0xe3, 0xa4, 0x6d, 0xda, 0x92, 0x73, 0x7d, 0x62, 0xa6, 0x75, 0x22, 0xf9, 0x45, 0xe9,
+    0x93, 0x98, 0x0a, 0x8f, 0x46, 0x9c, 0x1d, 0x5a, 0x15, 0xc3, 0xaa, 0x08, 0x18, 0xf8, 0xe7, 0x96,
+    0x5b, 0x08, 0xf5, 0x30, 0x0a, 0xfc, 0x61, 0x61, 0xcd, 0xd6, 0x71, 0xd7, 0x54, 0x0e, 0xcb, 0x7f,
+    0xdc, 0x91, 0xfd, 0x32, 0xc7, 0x29, 0x29, 0x50, 0xb6, 0x49, 0x0a, 0x72, 0x08, 0xbe, 0x38, 0xd4,
+    0x55, 0x4d, 0xf9, 0x10, 0xd0, 0x1b, 0xf4, 0xa7, 0x75, 0xa9, 0xb1, 0x21, 0x19, 0xf5, 0x3f, 0xa9,
+    0xec, 0xd1, 0xd8, 0x1d, 0x5c, 0x5d, 0xb8, 0x57, 0x63, 0x37, 0xf0, 0xc7, 0xfd, 0x72, 0x72, 0x8a,
+    0x8e, 0x3f, 0xea, 0x5b, 0xeb, 0xbd, 0x38, 0xa6, 0x75, 0x5e, 0xc5, 0x49, 0x8b, 0x5a, 0xbf, 0x04,
+    0x09, 0xfc, 0xe9, 0x45, 0xf5, 0xcb, 0xd2, 0x2f, 0x04, 0x16, 0x9b, 0xc2, 0x53, 0x1b, 0xc5, 0x8c,
+    0xa6, 0xca, 0x73, 0xca, 0x6f, 0x34, 0xf0, 0x27, 0x05, 0x3a, 0xe9, 0x72, 0xcf, 0xdd, 0x41, 0x1f,
+    0x51, 0xb6, 0x84, 0x17, 0x13, 0x52, 0xbb, 0x99, 0x33, 0xf5, 0x1e, 0x03, 0xa7, 0x10, 0x45, 0x09,
+    0x2e, 0x8a, 0x99, 0x73, 0x54, 0x40, 0x42, 0x8d, 0xa2, 0x0f, 0xaa, 0x4b, 0x30, 0xc8, 0xbe, 0x37,
+    0xa0, 0xcc, 0x1b, 0x3b, 0xf3, 0xeb, 0x98, 0xde, 0x57, 0x84, 0xcc, 0x85, 0x03, 0xe9, 0xeb, 0x98,
+    0x7e, 0xfe, 0x21, 0x79, 0x85, 0x61, 0xe5, 0xb2, 0x08, 0xee, 0x2d, 0x80, 0x30, 0x68, 0x00, 0x47,
+    0xbb, 0x04, 0x99, 0xbb, 0x2b, 0x6a, 0x64, 0x94, 0x30, 0x63, 0xe8, 0x3c, 0xfe, 0x86, 0xb3, 0x1e,
+    0xcc, 0xaf, 0xb3, 0x06, 0xc1, 0x2a, 0x79, 0x43, 0xfa, 0x8a, 0xeb, 0xcc, 0xff, 0x45, 0x48, 0x06,
+    0x73, 0xf6, 0x7c, 0x93, 0xa3, 0x0c, 0xe8, 0x14, 0x68, 0x8d, 0xb3, 0x6c, 0x8f, 0x30, 0x8b, 0xd1,
+    0x9a, 0xe0, 0x44, 0xac, 0xf7, 0xd7, 0x67, 0x59, 0x73, 0x6f, 0xc2, 0x1b, 0x23, 0xab, 0x22, 0x82,
+    0xec, 0xca, 0x04, 0x82, 0x2c, 0x1f, 0xc1, 0xdd, 0x03, 0xd9, 0x15, 0x4c, 0x64, 0xd7, 0x7e, 0xb4,
+    0xa8, 0x68, 0x3c, 0x73, 0xb4, 0x46, 0x29, 0x8b, 0x69, 0x84, 0x05, 0xcf, 0x9d, 0x8a, 0xc9, 0xd6,
+    0x1b, 0xa1, 0xb5, 0x37, 0x6a, 0xcc, 0x43, 0x76, 0xb1, 0x13, 0xc1, 0x3d, 0x14, 0xd9, 0x16, 0xe1,
+    0xcc, 0xaf, 0xcf, 0x62, 0x7a, 0x3f, 0xbf, 0x96, 0x91, 0x0e, 0xa8, 0x6f, 0xb2, 0x18, 0x02, 0xa7,
+    0x42, 0x72, 0x1a, 0xb2, 0x28, 0x52, 0xd4, 0x4c, 0x89, 0x9d, 0xf9, 0x2b, 0x5c, 0x08, 0xa4, 0xa6,
+    0xc4, 0x21, 0xfa, 0xe7, 0xa6, 0x10, 0x88, 0xf1, 0xed, 0xb5, 0x0c, 0x9c, 0x15, 0xe9, 0x33, 0xa5,
+    0xc4, 0x7a, 0x03, 0x4a, 0x68, 0xb5, 0x7f, 0x36, 0x5c, 0x20, 0x02, 0x23, 0x2b, 0x98, 0x23, 0x19,
+    0x77, 0x51, 0xdb, 0x9f, 0x37, 0xcd, 0xc6, 0x36, 0x8a, 0x4c, 0xda, 0x84, 0x05, 0xb4, 0x2b, 0x57,
+    0x08, 0x68, 0xd5, 0xf5, 0x5a, 0x54, 0x57, 0xe7, 0x9c, 0xb6, 0xd6, 0xab, 0xb4, 0x1e, 0x59, 0x35,
+    0x14, 0x67, 0xfe, 0x8a, 0x63, 0x70, 0xb4, 0x4a, 0xe9, 0x28, 0xc6, 0x02, 0xfb, 0xbe, 0x2f, 0x35,
+    0xad, 0x37, 0x7a, 0xf4, 0x6f, 0xb5, 0xe3, 0x88, 0xb3, 0x25, 0xcd, 0xd3, 0xd7, 0xe0, 0x12, 0xcd,
+    0x6e, 0x53, 0xf5, 0x25, 0x4f, 0xd6, 0xcc, 0xa9, 0xa2, 0x05, 0x92, 0x81, 0xb8, 0x75, 0x32, 0xec,
+    0x30, 0x00, 0x46, 0x3f, 0x6a, 0xac, 0x36, 0x59, 0xa1, 0x46, 0x39, 0x07, 0x35, 0x2e, 0x4b, 0x60,
+    0xf7, 0x63, 0x67, 0xfe, 0x4c, 0x2d, 0xc1, 0xd8, 0xfc, 0xf5, 0xd9, 0x7a, 0xf4, 0xa0, 0xb1, 0x43,
+    0xbd, 0xc0, 0x99, 0x3f, 0xcd, 0x09, 0x58, 0x39, 0x2a, 0x36, 0xfa, 0x8f, 0x2d, 0xec, 0x5b, 0x70,
+    0xb4, 0x05, 0x1a, 0x48, 0xac, 0x69, 0xa1, 0x65, 0xc1, 0xf8, 0xf6, 0xab, 0xb6, 0xc9, 0x4b, 0x33,
+    0xb7, 0xea, 0x6b, 0xc8, 0x3c, 0x77, 0x38, 0xf3, 0x6b, 0x15, 0xff, 0x11, 0x67, 0x51, 0x42, 0xa3,
+    0xbb, 0x99, 0xb3, 0xa6, 0x31, 0x79, 0x66, 0x09, 0xa9, 0xd7, 0x37, 0x62, 0xaa, 0x0f, 0x47, 0xe3,
+    0xf6, 0x88, 0xac, 0x27, 0x08, 0x4b, 0x95, 0x48, 0x3a, 0x7b, 0xbb, 0xd2, 0xee, 0xcc, 0xd1, 0x33,
+    0xc8, 0x61, 0x12, 0x74, 0x7d, 0xa6, 0xd8, 0x1a, 0xf6, 0x96, 0x6a, 0xa4, 0x58, 0xbe, 0x96, 0xc3,
+    0x0f, 0x71, 0x96, 0xd1, 0xd6, 0x32, 0xa0, 0xd3, 0x6c, 0x2b, 0xd3, 0x71, 0xe6, 0x4a, 0xd4, 0xe8,
+    0x86, 0x6f, 0x2d, 0xce, 0x0f, 0xdb, 0x08, 0x3c, 0x64, 0xbf, 0x88, 0xa9, 0xf8, 0xff, 0x34, 0x92,
+    0xef, 0x09, 0xac, 0x42, 0x79, 0x47, 0x65, 0x20, 0x36, 0x03, 0x69, 0x14, 0xd7, 0x09, 0x5e, 0x10,
+    0x70, 0xb2, 0xf9, 0xcc, 0x61, 0x64, 0x2b, 0x51, 0x6f, 0x70, 0x4a, 0xcc, 0x8a, 0xd5, 0x59, 0xab,
+    0x1c, 0x86, 0x75, 0x80, 0x5a, 0xfa, 0x53, 0xee, 0xf8, 0x86, 0x6c, 0x11, 0x4c, 0x0f, 0xaf, 0xcf,
+    0x24, 0xe1, 0xf9, 0xb5, 0xcc, 0x1f, 0x91, 0x95, 0xae, 0x2a, 0xe9, 0x9c, 0x62, 0xa5, 0x32, 0x6e,
+    0x70, 0x9f, 0x23, 0xed, 0x3e, 0x65, 0xee, 0x83, 0x5a, 0x05, 0x7d, 0x5b, 0x4f, 0xe6, 0xba, 0x8d,
+    0xe4, 0xcd, 0xa7, 0x51, 0xa4, 0xd2, 0x43, 0xea, 0xe2, 0x68, 0x7f, 0x18, 0x85, 0xab, 0xb1, 0xd6,
+    0x13, 0x80, 0x83, 0xac, 0x07, 0xca, 0x99, 0xf3, 0x42, 0x7a, 0x22, 0x46, 0xb6, 0xb2, 0x35, 0xc1,
+    0x41, 0xb6, 0x9e, 0x3f, 0xf6, 0x68, 0xdc, 0xd8, 0xb6, 0xf1, 0x97, 0x9f, 0x0d, 0xe0, 0xfe, 0x89,
+    0x8f, 0xc6, 0x2d, 0xbe, 0x27, 0x8f, 0x9e, 0x8a, 0x22, 0xca, 0x69, 0x26, 0xe6, 0x11, 0x67, 0x85,
+    0x40, 0x4f, 0xdf, 0xbc, 0xfc, 0xe5, 0xc5, 0xcd, 0xf3, 0x37, 0xdf, 0xbd, 0xbc, 0x79, 0x8b, 0x66,
+    0xa8, 0x7b, 0x86, 0x33, 0x7a, 0xa6, 0xa2, 0x48, 0x77, 0xda, 0xa9, 0xee, 0x8e, 0x60, 0x93, 0x29,
+    0x16, 0xcf, 0xb1, 0x20, 0x3d, 0x41, 0x53, 0x52, 0x08, 0x9c, 0x66, 0x7d, 0x74, 0xe8, 0xd0, 0x25,
+    0xea, 0x7d, 0x66, 0x8d, 0xe4, 0x44, 0x6c, 0x72, 0x86, 0xba, 0x37, 0x1c, 0xe5, 0x24, 0xe2, 0x79,
+    0xdc, 0x9d, 0x76, 0x44, 0xbe, 0x47, 0x87, 0x8e, 0x86, 0x80, 0xf2, 0x9a, 0x64, 0xd0, 0xdf, 0xd1,
+    0x00, 0x6e, 0xd1, 0xbe, 0xe0, 0xaf, 0x38, 0xe4, 0x62, 0xb7, 0x02, 0x2c, 0xa3, 0xd7, 0x9f, 0x76,
+    0x4a, 0x14, 0x61, 0x11, 0xad, 0xeb, 0xd9, 0xdd, 0x97, 0xec, 0x1e, 0x43, 0x6d, 0x13, 0xa2, 0x62,
+    0x77, 0xda, 0x29, 0x3b, 0x65, 0x7b, 0x8d, 0x2f, 0xc1, 0x46, 0xee, 0x71, 0x02, 0x37, 0xc3, 0x8d,
+    0x20, 0x85, 0x59, 0xa5, 0xfe, 0x46, 0xbf, 0xfd, 0x86, 0x68, 0x71, 0x83, 0x6f, 0x0c, 0x42, 0xbd,
+    0xea, 0x1f, 0xd8, 0x1d, 0xe3, 0x5b, 0xd6, 0x9d, 0x56, 0xfc, 0xde, 0x3d, 0x39, 0x54, 0x68, 0xe8,
+    0x0c, 0x0d, 0xc6, 0x63, 0xb9, 0xcc, 0x6f, 0x20, 0xb5, 0xee, 0x0d, 0xfa, 0x25, 0x8a, 0xf1, 0xbe,
+    0x78, 0x07, 0xcb, 0x48, 0x88, 0x40, 0x19, 0x61, 0x10, 0xc3, 0xa4, 0x6b, 0x7a, 0xaa, 0x96, 0x34,
+    0x43, 0x6c, 0x93, 0x24, 0x53, 0x1b, 0x5c, 0xd9, 0x9b, 0x81, 0x99, 0xf5, 0x17, 0x6b, 0xbe, 0x6d,
+    0x38, 0x6a, 0x79, 0x59, 0x81, 0xf5, 0x9f, 0xa4, 0x2c, 0xa1, 0xd3, 0x4e, 0xcc, 0xa3, 0x4d, 0x4a,
+    0x98, 0xf0, 0x57, 0x44, 0xbc, 0x48, 0x08, 0xfc, 0xf9, 0xf5, 0xfe, 0x65, 0xdc, 0xeb, 0xda, 0x81,
+    0xb1, 0xdb, 0xf7, 0xa5, 0x9b, 0xf3, 0xb5, 0x97, 0x03, 0x4d, 0xc3, 0x49, 0xe9, 0x5a, 0xf3, 0x21,
+    0xf1, 0xf4, 0xa5, 0x0d, 0xbe, 0xa2, 0x85, 0xf0, 0x71, 0x1c, 0xf7, 0xba, 0xf5, 0x45, 0xa3, 0xdb,
+    0xff, 0x7d, 0x56, 0x96, 0xa3, 0xef, 0xf6, 0x7d, 0x7d, 0xca, 0xd0, 0x0c, 0xf5, 0xfa, 0x68, 0x36,
+    0xd7, 0x6a, 0x38, 0xb1, 0x95, 0xcf, 0x66, 0x4a, 0x14, 0xb0, 0x53, 0x19, 0xfe, 0x6e, 0xf8, 0xf6,
+    0x04, 0x1e, 0xd8, 0x43, 0xe7, 0x38, 0x98, 0x4d, 0x3b, 0xe5, 0xd4, 0xb6, 0x82, 0x63, 0x0c, 0x74,
+    0xf8, 0x78, 0x21, 0x81, 0xef, 0x7a, 0x44, 0x48, 0x39, 0x49, 0xf9, 0x3d, 0x69, 0xcb, 0xe9, 0x11,
+    0x43, 0x28, 0x9b, 0xea, 0x6e, 0x3a, 0x1f, 0xa9, 0x51, 0x17, 0x45, 0x9b, 0x1c, 0x6a, 0xf6, 0x00,
+    0xb3, 0x94, 0x6f, 0xd9, 0xcd, 0xef, 0x69, 0xbe, 0x11, 0xee, 0x3e, 0x8d, 0xea, 0x95, 0xb3, 0x50,
+    0xf1, 0x63, 0x86, 0x1e, 0xe6, 0x6c, 0x85, 0x12, 0x98, 0x26, 0x27, 0xf8, 0xf7, 0x38, 0xd9, 0x10,
+    0x34, 0xb3, 0x37, 0x56, 0x81, 0x54, 0x2d, 0xa3, 0xf7, 0x01, 0xc6, 0x55, 0x7b, 0xca, 0x93, 0xb6,
+    0xa5, 0x16, 0xc8, 0x88, 0x14, 0xa9, 0x94, 0x91, 0xe1, 0xec, 0x8b, 0x9c, 0xa6, 0xc0, 0x02, 0xec,
+    0x4f, 0x63, 0x80, 0x60, 0x55, 0x6e, 0x6d, 0xd6, 0xdb, 0x6b, 0x09, 0xda, 0xad, 0xa8, 0x19, 0xc3,
+    0x6b, 0x85, 0x0a, 0x69, 0x79, 0x8a, 0x0f, 0x67, 0x77, 0x64, 0xbf, 0xc9, 0x60, 0x3d, 0xc4, 0x32,
+    0x76, 0xe2, 0xdf, 0x91, 0x3d, 0x9a, 0xcd, 0x66, 0xa8, 0x2b, 0x43, 0x57, 0xf7, 0x43, 0x6c, 0xb1,
+    0xb1, 0x51, 0xb9, 0x4d, 0xe5, 0x0a, 0x09, 0xdc, 0x2a, 0xdb, 0x54, 0x8b, 0x08, 0x67, 0x44, 0x92,
+    0x3d, 0xbd, 0xc0, 0x13, 0x87, 0xa3, 0x85, 0xf4, 0xd8, 0x8a, 0x7e, 0xd7, 0x90, 0xfe, 0xcc, 0xf1,
+    0x38, 0x72, 0x84, 0xe5, 0x07, 0x1f, 0x53, 0x1c, 0xc7, 0x2f, 0xee, 0x09, 0x13, 0xc0, 0x84, 0x30,
+    0x92, 0xf7, 0xba, 0x52, 0x4e, 0x5d, 0xb7, 0x2d, 0x7e, 0x81, 0xf3, 0x15, 0x11, 0x3e, 0x8d, 0x95,
+    0xb8, 0x9a, 0x64, 0xb4, 0xd0, 0x8e, 0xdc, 0x49, 0xa7, 0xec, 0xff, 0x81, 0xc3, 0xf5, 0xb1, 0x6b,
+    0x69, 0xd1, 0x79, 0x44, 0x83, 0xfd, 0x69, 0x07, 0x17, 0x7b, 0x16, 0x21, 0xa3, 0x46, 0x65, 0xb9,
+    0xd5, 0x75, 0xe3, 0x69, 0xca, 0x37, 0x4c, 0x54, 0xde, 0x03, 0xcb, 0xaf, 0x7e, 0x1d, 0x33, 0x2d,
+    0x33, 0x3f, 0x89, 0x09, 0x3c, 0x1e, 0xa5, 0x6f, 0x22, 0xaa, 0x9e, 0x07, 0x41, 0xef, 0x34, 0xfd,
+    0x93, 0x98, 0x0f, 0xd2, 0x7f, 0x8e, 0x8b, 0xf5, 0x82, 0xe3, 0x3c, 0xee, 0x59, 0xd4, 0x96, 0x44,
+    0x44, 0x6b, 0x49, 0xac, 0x50, 0xdb, 0x97, 0xa1, 0x53, 0x7e, 0xbf, 0x10, 0x78, 0xd5, 0x8c, 0xa8,
+    0x72, 0xf8, 0x39, 0x16, 0x18, 0xcd, 0xd0, 0x8f, 0x3f, 0x57, 0x5e, 0xea, 0xcd, 0x77, 0xaf, 0x5e,
+    0xfd, 0xf2, 0xf2, 0xe6, 0xed, 0x8b, 0xef, 0xff, 0xed, 0xe9, 0xab, 0x5f, 0x5e, 0xdf, 0xa2, 0x19,
+    0x3a, 0x97, 0x0d, 0x96, 0x6a, 0x12, 0x4f, 0x92, 0xb7, 0x34, 0x25, 0x79, 0x83, 0x54, 0x42, 0xef,
+    0xc9, 0x0f, 0x72, 0x55, 0x05, 0x9a, 0xa1, 0x25, 0x4e, 0x0a, 0x62, 0x47, 0x66, 0x68, 0x89, 0x78,
+    0xa3, 0xca, 0x9a, 0x3d, 0x93, 0x50, 0x18, 0x4a, 0xfd, 0x06, 0xd1, 0x82, 0xd4, 0x72, 0xb0, 0x76,
+    0xe3, 0x1e, 0xad, 0xab, 0xdf, 0x0c, 0x07, 0x82, 0x67, 0x36, 0x8b, 0x28, 0x21, 0x38, 0x37, 0x84,
+    0x6a, 0x5e, 0xd3, 0xce, 0xf1, 0x0e, 0x6c, 0x32, 0x9b, 0x05, 0xe4, 0x77, 0x0b, 0x52, 0xaf, 0x73,
+    0x4b, 0x59, 0xcc, 0xb7, 0xbe, 0xb4, 0xd2, 0x5b, 0xbe, 0xc9, 0x23, 0xe9, 0xfd, 0x9a, 0x7b, 0xaa,
+    0x32, 0x1e, 0xa0, 0xa5, 0xa4, 0x48, 0x00, 0x1d, 0x84, 0x01, 0x19, 0x9b, 0x35, 0xb7, 0xa7, 0x52,
+    0x44, 0x05, 0x86, 0xe3, 0xac, 0xfe, 0xf2, 0x39, 0x83, 0xf3, 0x6d, 0x79, 0xe4, 0xa6, 0x48, 0x45,
+    0xbe, 0x21, 0xd3, 0x4e, 0x63, 0x93, 0xd3, 0x4e, 0x5b, 0xd9, 0x16, 0x31, 0x92, 0xe7, 0x3c, 0x7f,
+    0x90, 0x9a, 0x56, 0x50, 0x7b, 0x0f, 0x35, 0x81, 0xe3, 0x53, 0x29, 0x8d, 0xc5, 0x3e, 0x95, 0x6a,
+    0x9b, 0x07, 0xa4, 0x6d, 0xd5, 0xf7, 0x7d, 0x75, 0xe1, 0x2e, 0xd1, 0x0c, 0xfd, 0xf3, 0xf6, 0xbb,
+    0x1b, 0x3f, 0x83, 0x9e, 0xe8, 0x1e, 0xf1, 0xa1, 0x1a, 0x01, 0x62, 0x37, 0xd6, 0xf6, 0xa3, 0x9c,
+    0xf2, 0x33, 0x9a, 0x29, 0x0b, 0xac, 0xec, 0x2e, 0xc2, 0x79, 0xfc, 0x48, 0x70, 0x7c, 0x27, 0x91,
+    0xbd, 0x27, 0x07, 0x39, 0xbb, 0x7c, 0xa7, 0x03, 0x12, 0xcc, 0x92, 0xfa, 0xc6, 0x79, 0xec, 0xf3,
+    0x8d, 0x20, 0xf9, 0xb7, 0x6f, 0x5f, 0xbf, 0x82, 0x68, 0x99, 0x93, 0xea, 0x5c, 0x3d, 0x83, 0x43,
+    0x22, 0xa7, 0xbb, 0x6a, 0xb9, 0x75, 0x40, 0x80, 0x83, 0xc3, 0x62, 0x92, 0xdb, 0x47, 0x26, 0xc5,
+    0xf9, 0xdd, 0x33, 0xce, 0x18, 0x89, 0x04, 0x89, 0xe5, 0xd0, 0xa9, 0x43, 0x98, 0x93, 0x65, 0x4e,
+    0x8a, 0xf5, 0x53, 0xe8, 0xa0, 0x7e, 0xb6, 0xc6, 0x6c, 0x45, 0x7a, 0x39, 0x29, 0x32, 0xce, 0x0a,
+    0x52, 0x99, 0x8e, 0x25, 0xf4, 0x2a, 0x49, 0x9e, 0xd6, 0x72, 0x8b, 0xa5, 0xa8, 0xf0, 0x16, 0x53,
+    0x81, 0xaa, 0x99, 0xfe, 0xaf, 0x05, 0x67, 0x52, 0xb5, 0x3c, 0x47, 0x3d, 0x38, 0x59, 0x58, 0xc0,
+    0x8b, 0x11, 0x78, 0xf9, 0x60, 0x6a, 0x3e, 0xae, 0xd1, 0xb0, 0xfe, 0xfa, 0xf2, 0xcb, 0xbe, 0x51,
+    0x87, 0xaa, 0x8d, 0x19, 0xb2, 0xd2, 0x40, 0x7a, 0xef, 0xa4, 0xc5, 0x45, 0x3c, 0x4d, 0x31, 0x8b,
+    0x8b, 0xb3, 0x27, 0x07, 0x1a, 0x97, 0xef, 0x5c, 0x74, 0x40, 0x11, 0x8e, 0xd6, 0x24, 0x84, 0x30,
+    0x04, 0x6d, 0x6d, 0x39, 0xe9, 0xa2, 0x52, 0x4b, 0x55, 0xd1, 0xf1, 0xf9, 0x1d, 0xfa, 0xdb, 0xdf,
+    0x50, 0x4f, 0x11, 0xd3, 0x63, 0x6a, 0x85, 0x7d, 0xbf, 0x62, 0x05, 0xce, 0x18, 0x9a, 0xa1, 0x29,
+    0x89, 0xbb, 0x7d, 0xb4, 0xc8, 0x09, 0xbe, 0x9b, 0x76, 0xd4, 0x0c, 0x30, 0xfd, 0x37, 0x39, 0x4f,
+    0x69, 0x41, 0x7a, 0x20, 0x1c, 0x9e, 0xdc, 0x2b, 0xeb, 0x29, 0x88, 0x80, 0x13, 0xc8, 0x37, 0xa2,
+    0x1a, 0x76, 0xd1, 0x70, 0x12, 0xf4, 0x95, 0x9c, 0xeb, 0xa5, 0xdb, 0x5a, 0xb1, 0x04, 0x6f, 0x2b,
+    0xcc, 0x6c, 0xdd, 0xd4, 0xe0, 0x1e, 0x4b, 0xb0, 0xda, 0xf5, 0xbd, 0xae, 0xde, 0xef, 0x67, 0x66,
+    0xa4, 0x8f, 0xc4, 0x3a, 0xe7, 0x5b, 0x75, 0x6c, 0xe1, 0x10, 0xf5, 0xba, 0xcf, 0x0c, 0x65, 0xc6,
+    0x05, 0x5a, 0xc2, 0xf5, 0x51, 0xe7, 0x74, 0x6a, 0xd8, 0xa7, 0x8c, 0x19, 0xb3, 0xab, 0xcd, 0xdc,
+    0x4f, 0x71, 0xd6, 0x6b, 0x9a, 0x1d, 0xec, 0xfd, 0x51, 0xbb, 0xec, 0xfb, 0xbf, 0x72, 0xca, 0x7a,
+    0xdd, 0x6e, 0x1f, 0xee, 0x59, 0xef, 0x3a, 0xf6, 0xd5, 0xbc, 0x7e, 0x0f, 0x44, 0x47, 0x85, 0xc5,
+    0xce, 0xef, 0x55, 0x16, 0x4d, 0x8f, 0x6a, 0xa3, 0xb6, 0xd8, 0x69, 0x55, 0xd9, 0xea, 0x86, 0x83,
+    0x66, 0x79, 0xf1, 0x86, 0x57, 0xe5, 0x64, 0xb9, 0x7b, 0xa8, 0xa7, 0x75, 0xd4, 0x6d, 0xb8, 0xfa,
+    0xcf, 0xbb, 0x86, 0x8a, 0x5a, 0x27, 0xc8, 0x24, 0x8b, 0x6f, 0xab, 0x4b, 0x6b, 0xcf, 0xca, 0x89,
+    0x75, 0xad, 0xf8, 0x31, 0xb5, 0xb5, 0xeb, 0xca, 0x95, 0xda, 0xcc, 0x80, 0x3c, 0x71, 0xd5, 0xc7,
+    0x89, 0x0c, 0xaa, 0x6e, 0xe5, 0x55, 0x69, 0xf5, 0x31, 0xa6, 0x4c, 0xda, 0xed, 0x8a, 0x74, 0x57,
+    0x65, 0x0f, 0xed, 0x63, 0xdf, 0xb0, 0x4b, 0x74, 0xd0, 0xb7, 0x73, 0xb5, 0x17, 0x55, 0x4d, 0x2e,
+    0x8c, 0x15, 0xc8, 0x88, 0xfb, 0x15, 0x3a, 0xa0, 0xee, 0xcb, 0xa5, 0x77, 0xc3, 0x19, 0xf1, 0x5e,
+    0xc3, 0x7d, 0xbc, 0x1b, 0xda, 0xf0, 0x12, 0x85, 0xe8, 0x50, 0x56, 0xe2, 0xa8, 0x1c, 0x41, 0xeb,
+    0x08, 0xdb, 0x65, 0x06, 0x38, 0xb9, 0x9a, 0x93, 0xfb, 0xc8, 0x11, 0x36, 0x2e, 0xc5, 0x3a, 0xa8,
+    0xa3, 0x60, 0x0c, 0x6b, 0x3e, 0x72, 0x70, 0x75, 0xf0, 0x92, 0x87, 0xc1, 0x4c, 0xe5, 0x77, 0x27,
+    0x8e, 0xc3, 0x37, 0x98, 0x26, 0x24, 0x86, 0x62, 0xab, 0x5c, 0x9b, 0xde, 0x4b, 0x7d, 0xcb, 0xd1,
+    0x96, 0xf2, 0xa0, 0x6b, 0x93, 0x2c, 0x9e, 0xe6, 0x39, 0xde, 0xfb, 0xb4, 0x90, 0xff, 0x55, 0x67,
+    0x00, 0x2a, 0x09, 0x47, 0xcc, 0xac, 0x82, 0x05, 0xd6, 0x15, 0x8a, 0x6e, 0x23, 0x98, 0x18, 0x61,
+    0x4f, 0x8f, 0x3c, 0x79, 0x23, 0xed, 0x31, 0xcb, 0xd0, 0xa2, 0x03, 0x1b, 0xeb, 0x75, 0x5f, 0xbc,
+    0xc5, 0x2b, 0xa0, 0x77, 0xec, 0xf2, 0x75, 0xe9, 0xa4, 0x27, 0x03, 0xa9, 0xbc, 0x47, 0x1e, 0x27,
+    0x51, 0x7f, 0xd2, 0xf1, 0xfc, 0xc5, 0x07, 0xa0, 0x61, 0xd9, 0x8f, 0x1d, 0x01, 0xeb, 0xa4, 0x28,
+    0x83, 0xb0, 0x9c, 0xe3, 0xe1, 0x01, 0xb7, 0xf7, 0x09, 0x5d, 0x95, 0x62, 0xff, 0xa8, 0x9f, 0xd2,
+    0x4d, 0x53, 0x4d, 0x27, 0x25, 0x2d, 0x06, 0x25, 0x47, 0x2f, 0x21, 0xca, 0x5b, 0x1d, 0x13, 0x98,
+    0xd4, 0x4f, 0x67, 0x08, 0xba, 0x23, 0x9d, 0xf9, 0x9b, 0x84, 0xe0, 0x82, 0xa0, 0x68, 0x4d, 0xa2,
+    0x3b, 0xf5, 0x88, 0x16, 0x29, 0x9b, 0x80, 0x83, 0x0f, 0x4f, 0x68, 0x70, 0xd8, 0xf1, 0x0a, 0x53,
+    0xf6, 0x90, 0x07, 0x3c, 0xe1, 0x30, 0x4c, 0x49, 0xc6, 0x94, 0xa3, 0x6c, 0x97, 0xf1, 0xc0, 0x79,
+    0x7f, 0xf7, 0xe4, 0x60, 0x1f, 0xf9, 0xf2, 0x4c, 0x52, 0xf1, 0x18, 0xdf, 0x42, 0xe0, 0xee, 0xa4,
+    0x44, 0xac, 0x79, 0x1c, 0xa2, 0xee, 0x9b, 0xef, 0x6e, 0xdf, 0x76, 0xdd, 0x8e, 0xb6, 0xe9, 0x10,
+    0x5c, 0xcd, 0x33, 0x55, 0x66, 0xf7, 0xde, 0xee, 0x33, 0xd2, 0x0d, 0x75, 0x6c, 0x8e, 0xe4, 0xd3,
+    0xea, 0x19, 0x1c, 0xc1, 0x2e, 0x2a, 0xdd, 0x0e, 0x5c, 0x34, 0x43, 0x95, 0xa6, 0x15, 0xb2, 0x5c,
+    0x48, 0x97, 0xfb, 0xde, 0x41, 0x09, 0xed, 0xa5, 0x7c, 0xe3, 0x57, 0x01, 0x09, 0x95, 0xfd, 0x4e,
+    0xe5, 0x50, 0x3e, 0xd8, 0x2d, 0xa8, 0x37, 0x18, 0x95, 0x30, 0xf6, 0xab, 0x5c, 0xe0, 0xb1, 0x74,
+    0xc9, 0xae, 0x54, 0xe2, 0x84, 0xe4, 0xe2, 0x01, 0x6a, 0x3e, 0xd2, 0x1a, 0x32, 0x7a, 0xf0, 0x1f,
+    0xf0, 0xd2, 0xbf, 0x77, 0x69, 0xfb, 0x48, 0x2d, 0xa8, 0xd9, 0x2d, 0x15, 0xfc, 0xf0, 0x7f, 0xaa,
+    0x01, 0x17, 0xf1, 0xf7, 0x6f, 0x48, 0x5e, 0x5d, 0x26, 0x43, 0xbd, 0x83, 0x8f, 0x52, 0x8c, 0x92,
+    0x8a, 0xa6, 0xf0, 0x09, 0x54, 0xd3, 0xa0, 0xf7, 0x51, 0xca, 0x79, 0xe8, 0x6e, 0xfc, 0x31, 0xca,
+    0xa1, 0x9a, 0xd6, 0x5f, 0xac, 0x9e, 0x8a, 0xed, 0x73, 0xbc, 0x2f, 0x42, 0xb9, 0x81, 0x3f, 0xa3,
+    0x9b, 0x8a, 0xda, 0xa7, 0xd3, 0x4e, 0x45, 0xf1, 0xa3, 0xf4, 0x23, 0x0b, 0x7b, 0x7a, 0xa3, 0x4c,
+    0xd7, 0xfd, 0x3e, 0x46, 0x37, 0x30, 0xf7, 0x2f, 0xd6, 0x0b, 0xb0, 0x0c, 0xe5, 0xbf, 0x7f, 0x46,
+    0x1f, 0x4c, 0x57, 0x62, 0x3f, 0x8d, 0x2e, 0x80, 0xda, 0x23, 0x7a, 0x30, 0x1a, 0x78, 0xf4, 0x8e,
+    0x60, 0xea, 0x27, 0x32, 0xc2, 0xfd, 0xf6, 0x1b, 0x52, 0x7f, 0xf9, 0x4a, 0x3f, 0xd5, 0x5b, 0x8c,
+    0xf5, 0x08, 0xd3, 0x69, 0xb6, 0x37, 0x98, 0x2b, 0xb4, 0x63, 0xf5, 0xc9, 0xa8, 0x67, 0xb2, 0xfa,
+    0x47, 0x3f, 0xc8, 0x74, 0xd9, 0xa2, 0x56, 0x9f, 0x7b, 0x2b, 0x82, 0x67, 0xde, 0x18, 0x15, 0x29,
+    0x74, 0x0c, 0xb6, 0x00, 0x8d, 0x97, 0x44, 0xfd, 0x03, 0x14, 0x64, 0xfd, 0x72, 0x46, 0xbf, 0xeb,
+    0x1e, 0xcf, 0x69, 0xf4, 0x9f, 0x98, 0x1f, 0x40, 0x02, 0xe6, 0x7a, 0xd8, 0x08, 0xe2, 0xb0, 0xca,
+    0xd4, 0xf4, 0x24, 0x3e, 0xf8, 0x86, 0xac, 0x1b, 0x6c, 0x06, 0xce, 0xfc, 0xc9, 0xa1, 0x96, 0x54,
+    0x79, 0x7d, 0xb6, 0x1e, 0xce, 0x3b, 0xfa, 0x4d, 0xb1, 0x63, 0xde, 0x34, 0x8f, 0x9f, 0x15, 0x2a,
+    0x71, 0xb9, 0xa8, 0x6b, 0x13, 0xf0, 0x73, 0x22, 0x1f, 0x57, 0x7b, 0x67, 0xdd, 0xb3, 0x95, 0x8b,
+    0x9c, 0x9f, 0x7e, 0xea, 0x3a, 0xfd, 0xb2, 0xdb, 0x77, 0x3a, 0x7a, 0x8d, 0xa6, 0xcb, 0x0b, 0x65,
+    0xde, 0x00, 0x35, 0xda, 0xd6, 0xf5, 0xc3, 0x63, 0xa3, 0xb3, 0xc1, 0xe9, 0xcc, 0x3b, 0xff, 0xf3,
+    0xdf, 0xff, 0xd5, 0x31, 0x4f, 0x8f, 0x26, 0xbf, 0x68, 0x0b, 0xa8, 0xfa, 0x79, 0x12, 0x32, 0xbf,
+    0x31, 0x02, 0xe1, 0xc8, 0x36, 0x99, 0xa3, 0x96, 0x89, 0x46, 0x92, 0x23, 0x85, 0xf0, 0x66, 0x93,
+    0x66, 0x48, 0xef, 0x09, 0x7d, 0x89, 0x06, 0xa5, 0x6e, 0x89, 0xe9, 0x54, 0x9b, 0xcb, 0x36, 0x69,
+    0xf6, 0xfd, 0x86, 0x31, 0xc8, 0xa2, 0xbe, 0x42, 0xdd, 0x63, 0xc2, 0xa6, 0x05, 0xe5, 0xc4, 0x4b,
+    0xba, 0x33, 0xaf, 0x22, 0x95, 0x6c, 0x40, 0x91, 0x94, 0xbb, 0x28, 0x44, 0xdd, 0x6e, 0xd9, 0x60,
+    0x70, 0x2b, 0xe0, 0x3c, 0xc8, 0xe2, 0x01, 0x9c, 0x2c, 0xca, 0x56, 0xdd, 0xd3, 0xcc, 0xac, 0x2b,
+    0xe9, 0x03, 0xec, 0xe4, 0x6c, 0xb8, 0x1b, 0x20, 0x8c, 0x80, 0x34, 0x2a, 0x12, 0x2e, 0x5a, 0xac,
+    0x9b, 0xa9, 0x9a, 0x2d, 0x51, 0xf3, 0x63, 0x55, 0x54, 0xff, 0xba, 0x14, 0x1a, 0xc0, 0xec, 0x67,
+    0xe2, 0x87, 0x2c, 0xd5, 0x28, 0xc2, 0xfc, 0xc2, 0x17, 0xb0, 0x54, 0x17, 0xc2, 0xe3, 0x9d, 0x5a,
+    0xaa, 0xff, 0x42, 0xa5, 0x26, 0xa8, 0xc7, 0xdf, 0xf7, 0x4d, 0x93, 0xc1, 0x31, 0x97, 0xc6, 0x11,
+    0x90, 0xef, 0x25, 0x9d, 0x46, 0x1b, 0x6d, 0xa7, 0x10, 0x24, 0x9b, 0x39, 0x81, 0x3f, 0x70, 0x3a,
+    0xf2, 0xc1, 0x66, 0xe6, 0x54, 0x92, 0x6e, 0xa4, 0x0e, 0xa5, 0xb1, 0x4c, 0xf5, 0x2b, 0xb0, 0xaa,
+    0x25, 0xc1, 0xda, 0x68, 0xdd, 0xae, 0x60, 0x9a, 0x11, 0x1c, 0x38, 0x1a, 0xd2, 0xd5, 0x55, 0x0d,
+    0x58, 0x76, 0x56, 0x55, 0x9f, 0x0d, 0x59, 0xed, 0xfb, 0x26, 0xe1, 0x58, 0xf4, 0xa0, 0xfb, 0x46,
+    0x3d, 0x1d, 0xf5, 0xfb, 0x60, 0xd5, 0x0f, 0x0b, 0xff, 0x53, 0x48, 0x11, 0x94, 0x5f, 0xa5, 0x11,
+    0xa8, 0x27, 0x13, 0x88, 0x4f, 0x21, 0xcc, 0x89, 0x25, 0x4c, 0xe5, 0x7f, 0xfd, 0x2a, 0x92, 0xbe,
+    0x7e, 0xf8, 0x45, 0xfb, 0x53, 0x8a, 0xd8, 0xe4, 0x46, 0x1f, 0x23, 0xe4, 0x53, 0x6e, 0xad, 0xf1,
+    0x52, 0x53, 0x11, 0xad, 0xfd, 0xd5, 0xd6, 0x74, 0xe5, 0x99, 0x56, 0x89, 0xa3, 0xfe, 0x08, 0xa4,
+    0x7e, 0xb4, 0x6b, 0xff, 0x8e, 0xd7, 0x6e, 0xb3, 0xb0, 0x5b, 0x6a, 0xe0, 0x07, 0x45, 0xaa, 0x7d,
+    0xd0, 0xda, 0xfd, 0x51, 0xd3, 0x3e, 0x2c, 0xdd, 0x34, 0x23, 0x3d, 0xee, 0xfb, 0xaa, 0x9f, 0x8a,
+    0x22, 0xf8, 0x39, 0x91, 0x0c, 0x07, 0xa3, 0x76, 0x0f, 0xe0, 0x43, 0x21, 0x40, 0x37, 0xf5, 0x8c,
+    0xa0, 0x8d, 0x08, 0x02, 0x4b, 0xdd, 0x5e, 0xf9, 0x2d, 0x85, 0xb2, 0xc9, 0x5e, 0x76, 0x14, 0x9d,
+    0xf4, 0x0b, 0x23, 0x07, 0x3c, 0xa3, 0xb6, 0x80, 0xad, 0x9e, 0xa6, 0x67, 0x41, 0xf0, 0xfd, 0xf1,
+    0xe7, 0xbe, 0x2a, 0xf4, 0xc9, 0xca, 0xb9, 0x8b, 0xa8, 0x2c, 0xf2, 0xbd, 0xfb, 0xd0, 0x50, 0xa8,
+    0xc3, 0x5c, 0xb5, 0x81, 0x27, 0x07, 0x2a, 0x9d, 0x62, 0x00, 0xce, 0xb0, 0x19, 0xc2, 0x2c, 0xd9,
+    0x4a, 0xaf, 0xd6, 0xf0, 0xf1, 0xdd, 0xb2, 0x0a, 0x01, 0xf3, 0x27, 0x07, 0xab, 0xd9, 0x44, 0x2e,
+    0xca, 0xaf, 0x1b, 0x4c, 0x8c, 0xb3, 0x6f, 0x38, 0x5a, 0xf3, 0x0b, 0x50, 0x08, 0x91, 0x6a, 0x8a,
+    0xce, 0xe9, 0xed, 0x66, 0x0d, 0xfe, 0xde, 0x4c, 0xd6, 0x37, 0xde, 0xba, 0x5a, 0x79, 0xe4, 0x61,
+    0x1f, 0x29, 0x0e, 0x1e, 0x95, 0x02, 0x8f, 0xab, 0xd7, 0x0f, 0xd6, 0x41, 0x1a, 0x2d, 0xa0, 0xdd,
+    0x46, 0xb1, 0x5a, 0x3f, 0xca, 0x40, 0x89, 0x1a, 0x44, 0xa3, 0xb3, 0x49, 0x28, 0x4d, 0x34, 0x3b,
+    0x41, 0x9f, 0x1c, 0x4c, 0x0f, 0x4d, 0xdd, 0x33, 0x03, 0xab, 0xa9, 0xfa, 0x66, 0x4a, 0x7d, 0x93,
+    0x6f, 0x55, 0xa0, 0xad, 0x97, 0xa1, 0xe9, 0xf5, 0x99, 0x6e, 0x02, 0xba, 0x3e, 0x83, 0x84, 0x14,
+    0x1a, 0x49, 0xe1, 0xff, 0x22, 0xe6, 0x7f, 0x01, 0xe0, 0x36, 0x65, 0xd9, 0x32, 0x46, 0x00, 0x00,
+};
+
+#endif
@@ -0,0 +1,400 @@
+// journal.cpp
+#include "water_my_plants.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+// Append-only log of every completed watering. Records are fixed-size and
+// go into numbered segment files of JOURNAL_SEGMENT_RECORDS each; an index
+// of the segments' time ranges is kept in RAM for seeks. Only the newest
+// segment is ever appended to, so a power cut can at worst leave a torn
+// record at its end, which journalBegin() cuts off.
+
+#define JOURNAL_DIR "/journal"
+#define JOURNAL_SEGMENT_RECORDS 256   // 4 KB per segment
+#define JOURNAL_MAX_SEGMENTS 128      // 512 KB, ~32k waterings
+#define JOURNAL_RETENTION_DAYS (5 * 365)
+#define JOURNAL_QUEUE_MIN 32          // records posted but not yet written
+
+static_assert(sizeof(JournalRecord) == 16, "journal records are 16 bytes on flash");
+
+struct JournalSegment {
+    uint32_t id;
+    uint32_t first;   // timestamp of the first record
+    uint32_t last;    // timestamp of the last record
+    uint32_t count;
+};
+
+// Oldest first. Appends and retention run on the service task, readers on
+// the web server task; the lock only covers the index, not file I/O.
+static std::vector<JournalSegment> segments;
+static std::mutex segmentsLock;
+// Set after a failed append so the next one starts a fresh segment
+static bool sealTail = false;
+
+// Finished waterings on their way from the control task to flash.
+// Single-producer, single-consumer; counts run forever like the command
+// queue's. Room for every pump to finish twice before the service task
+// gets round to it.
+static JournalRecord* pending = nullptr;
+static uint32_t pendingSize = 0;                // power of two
+static std::atomic<uint32_t> pendingHead(0);    // control task only
+static std::atomic<uint32_t> pendingTail(0);    // service task only
+
+static void segmentPath(uint32_t id, const char* ext, char* out, size_t len) {
+    snprintf(out, len, JOURNAL_DIR "/%08lx.%s", (unsigned long)id, ext);
+}
+
+// CRC-8 (polynomial 0x07) over the record with its crc byte zeroed
+static uint8_t recordCrc(const JournalRecord& record) {
+    JournalRecord copy = record;
+    copy.crc = 0;
+    const uint8_t* p = (const uint8_t*)&copy;
+    uint8_t crc = 0;
+    for (size_t i = 0; i < sizeof(copy); i++) {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
+
+static bool readRecord(File& file, uint32_t index, JournalRecord& record) {
+    return file.seek(index * sizeof(JournalRecord)) &&
+           file.read((uint8_t*)&record, sizeof(record)) == sizeof(record) &&
+           record.crc == recordCrc(record);
+}
+
+// Replaces segment id with records [0, count) of it, minus those older than
+// keepFrom. Written to a .tmp file first; journalBegin() finishes or drops
+// a rewrite that was cut short. Returns the number of records kept.
+static uint32_t rewriteSegment(uint32_t id, uint32_t count, uint32_t keepFrom) {
+    char path[40], tmpPath[40];
+    segmentPath(id, "bin", path, sizeof(path));
+    segmentPath(id, "tmp", tmpPath, sizeof(tmpPath));
+    File in = SPIFFS.open(path, FILE_READ);
+    File out = SPIFFS.open(tmpPath, FILE_WRITE);
+    uint32_t kept = 0;
+    JournalRecord record;
+    for (uint32_t i = 0; i < count && in && out; i++) {
+        if (!readRecord(in, i, record)) break;
+        if (record.timestamp < keepFrom) continue;
+        if (out.write((const uint8_t*)&record, sizeof(record)) != sizeof(record)) break;
+        kept++;
+    }
+    in.close();
+    out.close();
+    SPIFFS.remove(path);
+    SPIFFS.rename(tmpPath, path);
+    return kept;
+}
+
+// Reads a segment's size and time range, repairing a torn tail
+static bool loadSegment(uint32_t id, JournalSegment& segment) {
+    char path[40];
+    segmentPath(id, "bin", path, sizeof(path));
+    File file = SPIFFS.open(path, FILE_READ);
+    if (!file) return false;
+    size_t size = file.size();
+    uint32_t count = size / sizeof(JournalRecord);
+
+    JournalRecord first, last;
+    bool intact = size % sizeof(JournalRecord) == 0 && count > 0 && readRecord(file, count - 1, last);
+    if (!intact) {
+        // Keep the records up to the first bad one
+        uint32_t valid = 0;
+        while (valid < count && readRecord(file, valid, last)) valid++;
+        file.close();
+        LOG_WARN("Journal segment %08lx: dropping %u torn bytes", (unsigned long)id,
+                 (unsigned)(size - valid * sizeof(JournalRecord)));
+        count = rewriteSegment(id, valid, 0);
+        if (count == 0) {
+            SPIFFS.remove(path);
+            return false;
+        }
+        file = SPIFFS.open(path, FILE_READ);
+        if (!file || !readRecord(file, count - 1, last)) return false;
+    }
+    if (!readRecord(file, 0, first)) return false;
+    segment = {id, first.timestamp, last.timestamp, count};
+    return true;
+}
+
+void journalBegin() {
+    if (!pending) {
+        pendingSize = JOURNAL_QUEUE_MIN;
+        while (pendingSize < 2 * (uint32_t)numPumps) pendingSize *= 2;
+        pending = new JournalRecord[pendingSize];
+    }
+
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> pendingRewrites;
+    File dir = SPIFFS.open(JOURNAL_DIR);
+    if (dir && dir.isDirectory()) {
+        for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+            const char* name = f.name();
+            unsigned long id;
+            char ext[4];
+            if (sscanf(name, "%8lx.%3s", &id, ext) != 2) continue;
+            if (!strcmp(ext, "bin")) ids.push_back(id);
+            else if (!strcmp(ext, "tmp")) pendingRewrites.push_back(id);
+        }
+    }
+    dir.close();
+
+    // A .tmp next to its .bin was cut short before the swap: the .bin is
+    // intact. A .tmp on its own is complete: finish the rename.
+    for (uint32_t id : pendingRewrites) {
+        char path[40], tmpPath[40];
+        segmentPath(id, "bin", path, sizeof(path));
+        segmentPath(id, "tmp", tmpPath, sizeof(tmpPath));
+        if (std::find(ids.begin(), ids.end(), id) != ids.end()) {
+            SPIFFS.remove(tmpPath);
+        } else if (SPIFFS.rename(tmpPath, path)) {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<JournalSegment> loaded;
+    for (uint32_t id : ids) {
+        JournalSegment segment;
+        if (loadSegment(id, segment)) loaded.push_back(segment);
+    }
+
+    std::lock_guard<std::mutex> lock(segmentsLock);
+    segments.swap(loaded);
+    size_t records = 0;
+    for (const JournalSegment& s : segments) records += s.count;
+    LOG_INFO("Journal: %u waterings in %u segments", (unsigned)records, (unsigned)segments.size());
+}
+
+// Drops whole segments past the size cap or the retention age, and
+// compacts the oldest segment once most of it has expired
+static void applyRetention(uint32_t now) {
+    uint32_t keepFrom = now > JOURNAL_RETENTION_DAYS * 86400UL ? now - JOURNAL_RETENTION_DAYS * 86400UL : 0;
+    char path[40];
+    for (;;) {
+        JournalSegment oldest;
+        bool drop;
+        {
+            std::lock_guard<std::mutex> lock(segmentsLock);
+            if (segments.size() < 2) return;  // never touch the one being appended to
+            oldest = segments.front();
+            drop = segments.size() > JOURNAL_MAX_SEGMENTS || oldest.last < keepFrom;
+            if (drop) {
+                segments.erase(segments.begin());
+            } else if (oldest.first >= keepFrom) {
+                return;
+            }
+        }
+        segmentPath(oldest.id, "bin", path, sizeof(path));
+        if (!drop) break;
+        SPIFFS.remove(path);
+    }
+
+    // The oldest segment is partly expired: worth a rewrite once more than
+    // half of it is dead weight, otherwise the next roll-over looks again
+    JournalSegment oldest;
+    {
+        std::lock_guard<std::mutex> lock(segmentsLock);
+        oldest = segments.front();
+    }
+    File file = SPIFFS.open(path, FILE_READ);
+    JournalRecord middle;
+    bool mostlyExpired = file && readRecord(file, oldest.count / 2, middle) && middle.timestamp < keepFrom;
+    file.close();
+    if (!mostlyExpired) return;
+
+    uint32_t kept = rewriteSegment(oldest.id, oldest.count, keepFrom);
+    JournalSegment compacted;
+    bool loaded = kept > 0 && loadSegment(oldest.id, compacted);
+    if (!loaded) SPIFFS.remove(path);
+    std::lock_guard<std::mutex> lock(segmentsLock);
+    if (loaded) {
+        segments.front() = compacted;
+    } else {
+        segments.erase(segments.begin());
+    }
+}
+
+bool journalAppend(int plant, time_t timestamp, float amount, uint32_t durationMs, uint8_t source) {
+    JournalRecord record;
+    record.timestamp = (uint32_t)timestamp;
+    record.plant = (uint16_t)plant;
+    record.source = source;
+    record.amount = amount;
+    record.durationMs = durationMs;
+    record.crc = recordCrc(record);
+
+    bool rolled = false;
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(segmentsLock);
+        if (segments.empty() || segments.back().count >= JOURNAL_SEGMENT_RECORDS || sealTail) {
+            uint32_t next = segments.empty() ? 1 : segments.back().id + 1;
+            segments.push_back({next, record.timestamp, record.timestamp, 0});
+            rolled = true;
+            sealTail = false;
+        }
+        id = segments.back().id;
+    }
+
+    char path[40];
+    segmentPath(id, "bin", path, sizeof(path));
+    File file = SPIFFS.open(path, FILE_APPEND);
+    size_t written = file ? file.write((const uint8_t*)&record, sizeof(record)) : 0;
+    file.close();
+
+    {
+        std::lock_guard<std::mutex> lock(segmentsLock);
+        JournalSegment& tail = segments.back();
+        if (written == sizeof(record)) {
+            if (tail.count == 0) tail.first = record.timestamp;
+            tail.last = record.timestamp;
+            tail.count++;
+        } else if (tail.count == 0) {
+            segments.pop_back();
+        } else {
+            // Whatever made it to flash is cut off at the next boot; carry
+            // on in a fresh segment so later records aren't behind it
+            sealTail = true;
+        }
+    }
+    if (rolled) applyRetention(record.timestamp);
+    if (written != sizeof(record)) {
+        LOG_ERROR("Journal append failed");
+        return false;
+    }
+    return true;
+}
+
+// Hands a watering to the service task, which appends it on its next pass;
+// called from the control task so a slow flash write can't delay a pump
+bool journalPost(int plant, time_t timestamp, float amount, uint32_t durationMs, uint8_t source) {
+    uint32_t head = pendingHead.load(std::memory_order_relaxed);
+    if (!pending || head - pendingTail.load(std::memory_order_acquire) >= pendingSize) {
+        LOG_ERROR("Journal queue full, watering not journaled");
+        return false;
+    }
+    JournalRecord& record = pending[head & (pendingSize - 1)];
+    record.timestamp = (uint32_t)timestamp;
+    record.plant = (uint16_t)plant;
+    record.source = source;
+    record.amount = amount;
+    record.durationMs = durationMs;
+    pendingHead.store(head + 1, std::memory_order_release);
+    wakeServiceTask();
+    return true;
+}
+
+// Appends everything posted so far; called from the service task
+void journalFlush() {
+    uint32_t tail = pendingTail.load(std::memory_order_relaxed);
+    uint32_t head = pendingHead.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        const JournalRecord& record = pending[tail & (pendingSize - 1)];
+        journalAppend(record.plant, record.timestamp, record.amount, record.durationMs, record.source);
+        pendingTail.store(tail + 1, std::memory_order_release);
+    }
+}
+
+// Positions reader at the first record at or after from
+void journalSeek(JournalReader& reader, time_t from) {
+    reader.file.close();
+    reader.record = 0;
+    uint32_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(segmentsLock);
+        auto it = std::find_if(segments.begin(), segments.end(),
+                               [from](const JournalSegment& s) { return (time_t)s.last >= from; });
+        if (it == segments.end()) {
+            // Past the end: picks up whatever gets appended next
+            reader.segment = segments.empty() ? 1 : segments.back().id;
+            reader.record = segments.empty() ? 0 : segments.back().count;
+            return;
+        }
+        reader.segment = it->id;
+        if ((time_t)it->first >= from) return;
+        count = it->count;
+    }
+
+    // Binary search within the segment for the first record >= from
+    char path[40];
+    segmentPath(reader.segment, "bin", path, sizeof(path));
+    File file = SPIFFS.open(path, FILE_READ);
+    uint32_t lo = 0, hi = count;
+    JournalRecord record;
+    while (file && lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (readRecord(file, mid, record) && (time_t)record.timestamp < from) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    reader.record = lo;
+}
+
+// Reads the record at reader's position and advances it; false once there
+// are no more. Segments dropped by retention meanwhile are skipped.
+bool journalNext(JournalReader& reader, JournalRecord& record) {
+    for (;;) {
+        if (!reader.file) {
+            uint32_t count;
+            bool newest;
+            {
+                std::lock_guard<std::mutex> lock(segmentsLock);
+                auto it = std::find_if(segments.begin(), segments.end(),
+                                       [&reader](const JournalSegment& s) { return s.id >= reader.segment; });
+                if (it == segments.end()) return false;
+                if (it->id != reader.segment) {
+                    reader.segment = it->id;
+                    reader.record = 0;
+                }
+                count = it->count;
+                newest = it + 1 == segments.end();
+            }
+            if (reader.record >= count) {
+                if (newest) return false;
+                reader.segment++;
+                reader.record = 0;
+                continue;
+            }
+            char path[40];
+            segmentPath(reader.segment, "bin", path, sizeof(path));
+            reader.file = SPIFFS.open(path, FILE_READ);
+            reader.end = count;
+            if (!reader.file || !reader.file.seek(reader.record * sizeof(JournalRecord))) {
+                reader.file.close();
+                reader.segment++;
+                reader.record = 0;
+                continue;
+            }
+        }
+        if (reader.record >= reader.end) {
+            // End of what the index said; look again, the segment may have grown
+            reader.file.close();
+            continue;
+        }
+        if (reader.file.read((uint8_t*)&record, sizeof(record)) != sizeof(record) || record.crc != recordCrc(record)) {
+            reader.file.close();
+            reader.segment++;
+            reader.record = 0;
+            continue;
+        }
+        reader.record++;
+        return true;
+    }
+}
+
+size_t journalRecordCount() {
+    std::lock_guard<std::mutex> lock(segmentsLock);
+    size_t records = 0;
+    for (const JournalSegment& s : segments) records += s.count;
+    return records;
+}
+
+size_t journalSegmentCount() {
+    std::lock_guard<std::mutex> lock(segmentsLock);
+    return segments.size();
+}
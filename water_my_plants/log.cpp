@@ -0,0 +1,186 @@
+// log.cpp
+#include "water_my_plants.h"
+
+// Deferred logging. A Serial line at 115200 baud takes about 87 us per
+// character, so printing from the control loop held it for milliseconds.
+// Posting only copies the message into a ring; the log task, at the
+// lowest priority, formats and prints it when nothing else wants the CPU.
+//
+// The ring is a bounded multi-producer queue (Vyukov): a producer claims a
+// position with one compare-and-swap, fills the slot and publishes it by
+// advancing the slot's sequence number. A full ring drops the message and
+// counts it. Only the log task consumes.
+
+#define LOG_TASK_STACK 3072
+#define LOG_TASK_PRIORITY 1
+#define LOG_LINE_MAX 256
+
+static_assert((LOG_RING_SLOTS & (LOG_RING_SLOTS - 1)) == 0, "LOG_RING_SLOTS must be a power of two");
+
+// A slot's sequence is position when free for that position, position + 1
+// once filled. Stored less the slot's index, so zeroed slots start free.
+struct LogSlot {
+    std::atomic<uint32_t> sequence;
+    LogRecord record;
+};
+
+static LogSlot ring[LOG_RING_SLOTS];
+static std::atomic<uint32_t> head(0);           // next position to claim
+static uint32_t tail = 0;                       // next to print; log task only
+static std::atomic<uint32_t> dropped(0);
+static uint32_t reportedDropped = 0;            // log task only
+// Set by the first post after the log task starts a drain, so a burst of
+// posts costs one wake
+static std::atomic<bool> drainPending(false);
+static TaskHandle_t logTask = nullptr;
+
+static uint32_t loadSequence(uint32_t index) {
+    return ring[index].sequence.load(std::memory_order_acquire) + index;
+}
+
+static void storeSequence(uint32_t index, uint32_t sequence) {
+    ring[index].sequence.store(sequence - index, std::memory_order_release);
+}
+
+static void logTaskLoop(void*) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        drainPending = false;
+        logDrain();
+    }
+}
+
+// Starts the log task; messages posted before it wait in the ring
+void logBegin() {
+    if (logTask) return;
+    if (xTaskCreatePinnedToCore(logTaskLoop, "log", LOG_TASK_STACK, nullptr, LOG_TASK_PRIORITY,
+                                &logTask, PRO_CPU_NUM) == pdPASS) {
+        xTaskNotifyGive(logTask);
+    }
+}
+
+void logPush(const LogRecord& record) {
+    uint32_t position = head.load(std::memory_order_relaxed);
+    uint32_t index;
+    for (;;) {
+        index = position & (LOG_RING_SLOTS - 1);
+        int32_t lag = (int32_t)(loadSequence(index) - position);
+        if (lag == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (lag < 0) {
+            // Still holds a message from a lap ago: the ring is full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+    LogRecord& slot = ring[index].record;
+    memcpy(&slot, &record, offsetof(LogRecord, text) + record.textUsed);
+    slot.text[LOG_TEXT_MAX - 1] = '\0';
+    storeSequence(index, position + 1);
+    if (logTask && !drainPending.exchange(true)) xTaskNotifyGive(logTask);
+}
+
+uint32_t logDroppedCount() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+// Formats one record into line, printf-style. Each conversion is handed
+// to snprintf on its own with the stored bits cast back to its type;
+// integer length modifiers are replaced by ll since every integer was
+// widened to 64 bits when posted.
+static size_t formatRecord(const LogRecord& record, char* line, size_t size) {
+    size_t used = 0;
+    uint8_t arg = 0;
+    auto append = [&](int n) {
+        if (n > 0) used = min(used + (size_t)n, size - 1);
+    };
+    for (const char* p = record.format; *p && used < size - 1; p++) {
+        if (*p != '%') {
+            line[used++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            line[used++] = '%';
+            p++;
+            continue;
+        }
+        char spec[24] = "%";
+        size_t specLen = 1;
+        const char* q = p + 1;
+        while (*q && strchr("-+ #0123456789.", *q) && specLen < sizeof(spec) - 4) spec[specLen++] = *q++;
+        while (*q && strchr("hlLqjzt", *q)) q++;
+        char conversion = *q;
+        if (!conversion) break;
+        p = q;
+
+        uint64_t bits = arg < record.argCount ? record.args[arg] : 0;
+        bool present = arg++ < record.argCount;
+        char* out = line + used;
+        size_t room = size - used;
+        if (!present) {
+            append(snprintf(out, room, "?"));
+        } else if (strchr("di", conversion)) {
+            memcpy(spec + specLen, "lld", 4);
+            append(snprintf(out, room, spec, (long long)bits));
+        } else if (strchr("uoxX", conversion)) {
+            spec[specLen++] = 'l';
+            spec[specLen++] = 'l';
+            spec[specLen++] = conversion;
+            append(snprintf(out, room, spec, (unsigned long long)bits));
+        } else if (strchr("fFeEgGaA", conversion)) {
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            spec[specLen++] = conversion;
+            append(snprintf(out, room, spec, value));
+        } else if (conversion == 's') {
+            spec[specLen++] = 's';
+            append(snprintf(out, room, spec, record.text + min((size_t)bits, (size_t)LOG_TEXT_MAX - 1)));
+        } else if (conversion == 'c') {
+            spec[specLen++] = 'c';
+            append(snprintf(out, room, spec, (int)bits));
+        } else if (conversion == 'p') {
+            spec[specLen++] = 'p';
+            append(snprintf(out, room, spec, (void*)(uintptr_t)bits));
+        }
+    }
+    line[used] = '\0';
+    return used;
+}
+
+static void printLine(uint32_t timestamp, const char* text, size_t len) {
+    if (timestamp) {
+        // Local time of the post, not of the print
+        time_t when = timestamp;
+        struct tm timeinfo;
+        localtime_r(&when, &timeinfo);
+        char stamp[24];
+        size_t stampLen = strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S ", &timeinfo);
+        Serial.write((const uint8_t*)stamp, stampLen);
+    }
+    Serial.write((const uint8_t*)text, len);
+    Serial.write((const uint8_t*)"\n", 1);
+}
+
+// Prints everything posted so far. Called by the log task; anything else
+// calling it must not run at the same time.
+void logDrain() {
+    char line[LOG_LINE_MAX];
+    for (;;) {
+        uint32_t index = tail & (LOG_RING_SLOTS - 1);
+        if (loadSequence(index) != tail + 1) break;
+        size_t len = formatRecord(ring[index].record, line, sizeof(line));
+        uint32_t timestamp = ring[index].record.timestamp;
+        storeSequence(index, tail + LOG_RING_SLOTS);
+        tail++;
+        // The slot is free again before the slow part
+        printLine(timestamp, line, len);
+    }
+    uint32_t lost = dropped.load(std::memory_order_relaxed);
+    if (lost != reportedDropped) {
+        int len = snprintf(line, sizeof(line), "Log: %u messages dropped", (unsigned)(lost - reportedDropped));
+        printLine(0, line, len);
+        reportedDropped = lost;
+    }
+}
@@ -0,0 +1,320 @@
+// metrics.cpp
+#include "water_my_plants.h"
+#include <stdarg.h>
+
+// Counters and latency histograms for GET /metrics, in the Prometheus text
+// format. Recording is a handful of relaxed atomic adds and may happen on
+// any task; everything is rendered on request, one family at a time, so
+// the page costs no more RAM however many pumps there are.
+
+// Upper bounds of the histogram buckets, in microseconds and as printed
+// in seconds; the last bucket is +Inf
+static const uint32_t BUCKET_BOUNDS_US[HISTOGRAM_BUCKETS - 1] = {
+    10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+    100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000};
+static const char* const BUCKET_LABELS[HISTOGRAM_BUCKETS] = {
+    "0.00001", "0.000025", "0.00005", "0.0001", "0.00025", "0.0005", "0.001", "0.0025", "0.005", "0.01",
+    "0.025", "0.05", "0.1", "0.25", "0.5", "1", "2.5", "5", "10", "+Inf"};
+
+struct Histogram {
+    std::atomic<uint32_t> buckets[HISTOGRAM_BUCKETS];
+    std::atomic<uint32_t> count;
+    std::atomic<uint64_t> sumMicros;
+};
+
+struct RouteMetrics {
+    const char* uri;
+    const char* method;
+    Histogram latency;
+};
+
+// Running totals of one pump; started and target are only touched by
+// whichever task is switching the pump at the time
+struct PumpMetrics {
+    int64_t startedMicros;
+    int64_t targetMicros;
+    std::atomic<uint32_t> onMillis;
+    std::atomic<uint32_t> doses;
+    std::atomic<int32_t> lastErrorMicros;
+};
+
+static Histogram histograms[HISTOGRAM_COUNT];
+static std::atomic<uint32_t> counters[COUNTER_COUNT];
+static RouteMetrics routes[METRICS_MAX_ROUTES];
+static int routeCount = 0;
+static PumpMetrics* pumpMetrics = nullptr;
+
+// SNTP (re)start awaiting its first sync, in millis()
+static std::atomic<bool> sntpPending(false);
+static std::atomic<uint32_t> sntpStartedMillis(0);
+
+static void observe(Histogram& histogram, int64_t micros) {
+    uint32_t us = micros < 0 ? 0 : micros > UINT32_MAX ? UINT32_MAX : (uint32_t)micros;
+    int bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && us > BUCKET_BOUNDS_US[bucket]) bucket++;
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sumMicros.fetch_add(us, std::memory_order_relaxed);
+}
+
+void metricsBegin() {
+    if (!pumpMetrics) pumpMetrics = new PumpMetrics[numPumps]();
+}
+
+void metricsCount(MetricCounter counter) {
+    counters[counter].fetch_add(1, std::memory_order_relaxed);
+}
+
+void metricsObserve(MetricHistogram histogram, int64_t micros) {
+    observe(histograms[histogram], micros);
+}
+
+static const char* methodName(WebRequestMethod method) {
+    switch (method) {
+        case HTTP_GET: return "GET";
+        case HTTP_POST: return "POST";
+        case HTTP_PUT: return "PUT";
+        case HTTP_DELETE: return "DELETE";
+        case HTTP_PATCH: return "PATCH";
+        default: return "OTHER";
+    }
+}
+
+// Registers a route for request metrics while the server is set up;
+// -1 once the table is full, which metricsRequest() ignores
+int metricsRoute(const char* uri, WebRequestMethod method) {
+    if (routeCount == METRICS_MAX_ROUTES) return -1;
+    routes[routeCount].uri = uri;
+    routes[routeCount].method = methodName(method);
+    return routeCount++;
+}
+
+void metricsRequest(int route, int64_t micros) {
+    if (route >= 0) observe(routes[route].latency, micros);
+}
+
+void metricsSntpStarted() {
+    sntpStartedMillis = millis();
+    sntpPending = true;
+}
+
+// From the SNTP callback: the first sync after a (re)start is its latency
+void metricsTimeSynced() {
+    if (sntpPending.exchange(false)) {
+        metricsObserve(HISTOGRAM_NTP_SYNC, (int64_t)(uint32_t)(millis() - sntpStartedMillis.load()) * 1000);
+    }
+}
+
+// The pump's outputs have just switched on for a dose of targetMicros
+void metricsPumpStarted(int pumpIndex, int64_t targetMicros) {
+    if (!pumpMetrics) return;
+    pumpMetrics[pumpIndex].startedMicros = esp_timer_get_time();
+    pumpMetrics[pumpIndex].targetMicros = targetMicros;
+}
+
+// ...and off again
+void metricsPumpStopped(int pumpIndex) {
+    if (!pumpMetrics) return;
+    PumpMetrics& metrics = pumpMetrics[pumpIndex];
+    int64_t onMicros = esp_timer_get_time() - metrics.startedMicros;
+    int64_t error = onMicros - metrics.targetMicros;
+    metrics.onMillis.fetch_add((uint32_t)(onMicros / 1000), std::memory_order_relaxed);
+    metrics.doses.fetch_add(1, std::memory_order_relaxed);
+    metrics.lastErrorMicros = (int32_t)constrain(error, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+    metricsObserve(HISTOGRAM_DOSE_ERROR, llabs(error));
+}
+
+// Bounded printf writer for one record
+struct TextOut {
+    char* p;
+    char* end;
+
+    void printf(const char* format, ...) {
+        if (p >= end) return;
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(p, end - p, format, args);
+        va_end(args);
+        if (n > 0) p += min((size_t)n, (size_t)(end - p - 1));
+    }
+
+    void family(const char* name, const char* type, const char* help) {
+        printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+};
+
+// Buckets, sum and count of one histogram; labels are "" or a list
+// ending in a comma, e.g. route="/",
+static void writeHistogram(TextOut& out, const char* name, const char* labels, const Histogram& histogram) {
+    uint32_t cumulative = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        cumulative += histogram.buckets[b].load(std::memory_order_relaxed);
+        out.printf("%s_bucket{%sle=\"%s\"} %u\n", name, labels, BUCKET_LABELS[b], (unsigned)cumulative);
+    }
+    size_t labelsLen = strlen(labels);
+    // The labels without the trailing comma, in braces, or nothing
+    char plain[128] = "";
+    if (labelsLen > 0 && labelsLen < sizeof(plain) - 1) {
+        snprintf(plain, sizeof(plain), "{%.*s}", (int)labelsLen - 1, labels);
+    }
+    out.printf("%s_sum%s %.6f\n", name, plain, histogram.sumMicros.load(std::memory_order_relaxed) / 1e6);
+    out.printf("%s_count%s %u\n", name, plain, (unsigned)cumulative);
+}
+
+enum MetricsFamily {
+    FAMILY_SYSTEM,
+    FAMILY_NETWORK,
+    FAMILY_NTP_HISTOGRAM,
+    FAMILY_STORAGE,
+    FAMILY_LOOP_HISTOGRAMS,
+    FAMILY_HTTP,
+    FAMILY_PUMP_ON,
+    FAMILY_PUMP_DOSES,
+    FAMILY_PUMP_ERROR,
+    FAMILY_DOSE_HISTOGRAM,
+    FAMILY_END
+};
+
+// Renders the next record: a few gauges and counters, one histogram, or
+// one pump's sample. METRICS_RECORD_MAX fits the longest route histogram.
+static size_t renderMetricsRecord(MetricsCursor& cursor) {
+    TextOut out = {cursor.record, cursor.record + sizeof(cursor.record)};
+    int item = cursor.item++;
+    switch (cursor.family) {
+        case FAMILY_SYSTEM:
+            out.family("wmp_uptime_seconds", "gauge", "Time since boot");
+            out.printf("wmp_uptime_seconds %.3f\n", esp_timer_get_time() / 1e6);
+            out.family("wmp_heap_free_bytes", "gauge", "Free heap");
+            out.printf("wmp_heap_free_bytes %u\n", (unsigned)ESP.getFreeHeap());
+            out.family("wmp_heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+            out.printf("wmp_heap_min_free_bytes %u\n", (unsigned)ESP.getMinFreeHeap());
+            out.family("wmp_heap_largest_free_block_bytes", "gauge",
+                       "Largest allocatable block; well below free heap means fragmentation");
+            out.printf("wmp_heap_largest_free_block_bytes %u\n", (unsigned)ESP.getMaxAllocHeap());
+            out.family("wmp_task_stack_free_bytes", "gauge", "Stack a task has never used");
+            out.printf("wmp_task_stack_free_bytes{task=\"control\"} %u\n", (unsigned)controlTaskStackFree());
+            out.printf("wmp_task_stack_free_bytes{task=\"service\"} %u\n", (unsigned)serviceTaskStackFree());
+            out.family("wmp_log_dropped_total", "counter", "Log messages dropped with the log ring full");
+            out.printf("wmp_log_dropped_total %u\n", (unsigned)logDroppedCount());
+            out.family("wmp_state_version", "counter", "Changes visible through /api/plants");
+            out.printf("wmp_state_version %u\n", (unsigned)stateVersion.load());
+            cursor.family++;
+            cursor.item = 0;
+            break;
+        case FAMILY_NETWORK:
+            out.family("wmp_wifi_connected", "gauge", "1 while Wi-Fi has an IP address");
+            out.printf("wmp_wifi_connected %d\n", WiFi.status() == WL_CONNECTED ? 1 : 0);
+            out.family("wmp_wifi_connects_total", "counter", "Wi-Fi connections made");
+            out.printf("wmp_wifi_connects_total %u\n", (unsigned)counters[COUNTER_WIFI_CONNECTS].load());
+            out.family("wmp_wifi_disconnects_total", "counter", "Wi-Fi connections lost");
+            out.printf("wmp_wifi_disconnects_total %u\n", (unsigned)counters[COUNTER_WIFI_DISCONNECTS].load());
+            out.family("wmp_wifi_connect_failures_total", "counter", "Wi-Fi connection attempts that failed or timed out");
+            out.printf("wmp_wifi_connect_failures_total %u\n", (unsigned)counters[COUNTER_WIFI_CONNECT_FAILURES].load());
+            out.family("wmp_ntp_syncs_total", "counter", "SNTP syncs received");
+            out.printf("wmp_ntp_syncs_total %u\n", (unsigned)timeSyncCount());
+            out.family("wmp_ntp_restarts_total", "counter", "SNTP restarts after it went quiet");
+            out.printf("wmp_ntp_restarts_total %u\n", (unsigned)counters[COUNTER_NTP_RESTARTS].load());
+            out.family("wmp_time_drift_ppb", "gauge", "Measured oscillator drift, positive is fast");
+            out.printf("wmp_time_drift_ppb %d\n", (int)timeDriftPpb());
+            out.family("wmp_time_last_sync_error_seconds", "gauge", "How far off the time base was at the last sync");
+            out.printf("wmp_time_last_sync_error_seconds %.6f\n", timeLastSyncErrorMicros() / 1e6);
+            cursor.family++;
+            cursor.item = 0;
+            break;
+        case FAMILY_NTP_HISTOGRAM:
+            out.family("wmp_ntp_sync_latency_seconds", "histogram", "Time from starting SNTP to its first sync");
+            writeHistogram(out, "wmp_ntp_sync_latency_seconds", "", histograms[HISTOGRAM_NTP_SYNC]);
+            cursor.family++;
+            cursor.item = 0;
+            break;
+        case FAMILY_STORAGE:
+            out.family("wmp_eeprom_commit_seconds", "histogram", "EEPROM.commit() duration");
+            writeHistogram(out, "wmp_eeprom_commit_seconds", "", histograms[HISTOGRAM_EEPROM_COMMIT]);
+            out.family("wmp_eeprom_commit_failures_total", "counter", "EEPROM.commit() calls that failed");
+            out.printf("wmp_eeprom_commit_failures_total %u\n", (unsigned)counters[COUNTER_EEPROM_COMMIT_FAILURES].load());
+            out.family("wmp_journal_records", "gauge", "Waterings in the journal");
+            out.printf("wmp_journal_records %u\n", (unsigned)journalRecordCount());
+            cursor.family++;
+            cursor.item = 0;
+            break;
+        case FAMILY_LOOP_HISTOGRAMS:
+            if (item == 0) {
+                out.family("wmp_loop_pass_seconds", "histogram", "One pass of a task's loop, sleep excluded");
+            }
+            writeHistogram(out, "wmp_loop_pass_seconds", item == 0 ? "task=\"control\"," : "task=\"service\",",
+                           histograms[item == 0 ? HISTOGRAM_CONTROL_PASS : HISTOGRAM_SERVICE_PASS]);
+            if (item == 1) {
+                cursor.family++;
+                cursor.item = 0;
+            }
+            break;
+        case FAMILY_HTTP:
+            if (item < routeCount) {
+                if (item == 0) {
+                    out.family("wmp_http_request_seconds", "histogram",
+                               "Time in the route handler; streamed bodies are rendered after it returns");
+                }
+                char labels[96];
+                snprintf(labels, sizeof(labels), "route=\"%s\",method=\"%s\",", routes[item].uri, routes[item].method);
+                writeHistogram(out, "wmp_http_request_seconds", labels, routes[item].latency);
+            }
+            if (item + 1 >= routeCount) {
+                cursor.family++;
+                cursor.item = 0;
+            }
+            break;
+        case FAMILY_PUMP_ON:
+        case FAMILY_PUMP_DOSES:
+        case FAMILY_PUMP_ERROR:
+            if (item < numPumps && pumpMetrics) {
+                const PumpMetrics& metrics = pumpMetrics[item];
+                if (cursor.family == FAMILY_PUMP_ON) {
+                    if (item == 0) out.family("wmp_pump_on_seconds_total", "counter", "Time each pump has run");
+                    out.printf("wmp_pump_on_seconds_total{pump=\"%d\"} %.3f\n", pumps[item].number,
+                               metrics.onMillis.load() / 1e3);
+                } else if (cursor.family == FAMILY_PUMP_DOSES) {
+                    if (item == 0) out.family("wmp_pump_doses_total", "counter", "Doses each pump has delivered");
+                    out.printf("wmp_pump_doses_total{pump=\"%d\"} %u\n", pumps[item].number,
+                               (unsigned)metrics.doses.load());
+                } else {
+                    if (item == 0) {
+                        out.family("wmp_pump_last_dose_error_seconds", "gauge",
+                                   "Measured minus intended on-time of each pump's last dose");
+                    }
+                    out.printf("wmp_pump_last_dose_error_seconds{pump=\"%d\"} %.6f\n", pumps[item].number,
+                               metrics.lastErrorMicros.load() / 1e6);
+                }
+            }
+            if (item + 1 >= numPumps || !pumpMetrics) {
+                cursor.family++;
+                cursor.item = 0;
+            }
+            break;
+        case FAMILY_DOSE_HISTOGRAM:
+            out.family("wmp_pump_dose_error_seconds", "histogram", "Absolute dose timing error, all pumps");
+            writeHistogram(out, "wmp_pump_dose_error_seconds", "", histograms[HISTOGRAM_DOSE_ERROR]);
+            cursor.family++;
+            cursor.item = 0;
+            break;
+        default:
+            return 0;
+    }
+    return out.p - cursor.record;
+}
+
+size_t fillMetrics(MetricsCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.offset == cursor.length) {
+            if (cursor.family >= FAMILY_END) break;
+            cursor.length = renderMetricsRecord(cursor);
+            cursor.offset = 0;
+            continue;
+        }
+        size_t n = min(cursor.length - cursor.offset, maxLen - written);
+        memcpy(buffer + written, cursor.record + cursor.offset, n);
+        cursor.offset += n;
+        written += n;
+    }
+    return written;
+}
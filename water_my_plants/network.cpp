@@ -1,58 +1,163 @@
 // network.cpp
 #include "water_my_plants.h"
+#include <limits.h>
 
-bool syncTime() {
+// Wi-Fi and NTP connection manager. WiFi events only record what happened
+// and wake the service task; checkNetwork() acts on them there without ever
+// blocking, and pumps are run by the control task either way.
+
+#define WIFI_CONNECT_TIMEOUT_MS 20000
+#define WIFI_BACKOFF_MIN_MS 1000
+#define WIFI_BACKOFF_MAX_MS 300000
+// SNTP resyncs hourly by itself; restart it if it has gone quiet this long
+#define NTP_STALE_MS (2UL * 3600000)
+#define NTP_BACKOFF_MIN_MS 60000
+#define NTP_BACKOFF_MAX_MS 3600000
+
+enum WifiState {
+    WIFI_STATE_CONNECTING,
+    WIFI_STATE_CONNECTED,
+    WIFI_STATE_BACKOFF
+};
+
+// Set from the WiFi event task
+static std::atomic<bool> linkUp(false);
+static std::atomic<uint32_t> linkChanges(0);
+
+// Only touched by the service task
+static WifiState wifiState = WIFI_STATE_BACKOFF;
+static unsigned long wifiStateSince = 0;
+static unsigned long wifiBackoffMs = 0;
+static uint32_t seenLinkChanges = 0;
+
+static bool sntpStarted = false;
+static unsigned long ntpSince = 0;    // last sync or SNTP restart
+static unsigned long ntpPeriod = 0;   // how long to wait from there
+static unsigned long ntpBackoffMs = NTP_BACKOFF_MIN_MS;
+static uint32_t seenSyncs = 0;
+
+static void onWiFiEvent(WiFiEvent_t event) {
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        linkUp = true;
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED || event == ARDUINO_EVENT_WIFI_STA_LOST_IP) {
+        linkUp = false;
+    } else {
+        return;
+    }
+    linkChanges.fetch_add(1);
+    wakeServiceTask();
+}
+
+static void setWifiState(WifiState state, unsigned long now) {
+    wifiState = state;
+    wifiStateSince = now;
+}
+
+static void startConnect(unsigned long now) {
+    LOG_INFO("Connecting to WiFi...");
+    WiFi.begin(ssid, password);
+    setWifiState(WIFI_STATE_CONNECTING, now);
+}
+
+static void backOff(unsigned long now) {
+    wifiBackoffMs = wifiBackoffMs == 0 ? WIFI_BACKOFF_MIN_MS : min(wifiBackoffMs * 2, (unsigned long)WIFI_BACKOFF_MAX_MS);
+    LOG_INFO("WiFi retry in %lu s", wifiBackoffMs / 1000);
+    setWifiState(WIFI_STATE_BACKOFF, now);
+}
+
+static void startSntp(unsigned long now, unsigned long period) {
     configTime(gmtOffset_sec, daylightOffset_sec, ntpServer, ntpServer1, ntpServer2);
-    
-    struct tm timeinfo;
-    int retries = 0;
-    const int maxRetries = 10;
-    
-    while (!getLocalTime(&timeinfo) && retries < maxRetries) {
-        Serial.println("Waiting for time sync...");
-        retries++;
-        delay(1000);
+    metricsSntpStarted();
+    traceRecord(TRACE_NTP_START, 0, sntpStarted, 0);
+    sntpStarted = true;
+    ntpSince = now;
+    ntpPeriod = period;
+}
+
+static void onConnected(unsigned long now) {
+    LOG_INFO("WiFi connected, IP address: %s", WiFi.localIP().toString().c_str());
+    setWifiState(WIFI_STATE_CONNECTED, now);
+    metricsCount(COUNTER_WIFI_CONNECTS);
+    traceRecord(TRACE_WIFI, 0, TRACE_WIFI_CONNECTED, (uint32_t)(int32_t)WiFi.RSSI());
+    wifiBackoffMs = 0;
+    if (!sntpStarted) startSntp(now, NTP_BACKOFF_MIN_MS);
+}
+
+// Milliseconds until a deadline `period` after `since`
+static unsigned long millisLeft(unsigned long now, unsigned long since, unsigned long period) {
+    unsigned long elapsed = now - since;
+    return elapsed >= period ? 0 : period - elapsed;
+}
+
+// Keeps SNTP alive: restarts it when no sync has arrived for NTP_STALE_MS,
+// then again with exponential backoff while it keeps failing. Returns ms
+// until the next check.
+static unsigned long checkTimeSync(unsigned long now) {
+    uint32_t syncs = timeSyncCount();
+    if (syncs != seenSyncs) {
+        seenSyncs = syncs;
+        ntpSince = now;
+        ntpPeriod = NTP_STALE_MS;
+        ntpBackoffMs = NTP_BACKOFF_MIN_MS;
     }
-    
-    if (retries < maxRetries) {
-        char timeStr[30];
-        strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-        Serial.printf("Time synchronized: %s\n", timeStr);
-        return true;
+    if (!sntpStarted || wifiState != WIFI_STATE_CONNECTED) return ULONG_MAX;
+
+    if (millisLeft(now, ntpSince, ntpPeriod) == 0) {
+        LOG_WARN("No NTP response - restarting SNTP");
+        metricsCount(COUNTER_NTP_RESTARTS);
+        ntpBackoffMs = min(ntpBackoffMs * 2, (unsigned long)NTP_BACKOFF_MAX_MS);
+        startSntp(now, ntpBackoffMs);
     }
-    
-    Serial.println("Time sync failed!");
-    return false;
+    return millisLeft(now, ntpSince, ntpPeriod);
 }
 
 void setupWiFi() {
-    Serial.println("Connecting to WiFi...");
-    WiFi.begin(ssid, password);
-    
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
+    WiFi.setAutoReconnect(false);  // reconnects are paced by checkNetwork()
+    WiFi.onEvent(onWiFiEvent);
+    startConnect(millis());
+}
+
+// Advances the connection state machine; returns how long the service task
+// may sleep before calling it again (events wake it sooner)
+unsigned long checkNetwork() {
+    unsigned long now = millis();
+
+    uint32_t changes = linkChanges.load();
+    if (changes != seenLinkChanges) {
+        seenLinkChanges = changes;
+        if (linkUp) {
+            if (wifiState != WIFI_STATE_CONNECTED) onConnected(now);
+        } else if (wifiState != WIFI_STATE_BACKOFF) {
+            bool wasConnected = wifiState == WIFI_STATE_CONNECTED;
+            LOG_WARN("%s", wasConnected ? "WiFi disconnected" : "WiFi connection failed");
+            metricsCount(wasConnected ? COUNTER_WIFI_DISCONNECTS : COUNTER_WIFI_CONNECT_FAILURES);
+            traceRecord(TRACE_WIFI, 0, wasConnected ? TRACE_WIFI_DISCONNECTED : TRACE_WIFI_CONNECT_FAILED, 0);
+            backOff(now);
+        }
     }
-    
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\nWiFi connected");
-        Serial.print("IP address: ");
-        Serial.println(WiFi.localIP());
-        
-        configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
-        
-        if (syncTime()) {
-            struct tm timeinfo;
-            if(getLocalTime(&timeinfo)){
-                Serial.print("Current time: ");
-                Serial.println(&timeinfo, "%A, %B %d %Y %H:%M:%S");
+
+    unsigned long wait = ULONG_MAX;
+    switch (wifiState) {
+        case WIFI_STATE_CONNECTING:
+            wait = millisLeft(now, wifiStateSince, WIFI_CONNECT_TIMEOUT_MS);
+            if (wait == 0) {
+                LOG_WARN("WiFi connection timed out");
+                metricsCount(COUNTER_WIFI_CONNECT_FAILURES);
+                traceRecord(TRACE_WIFI, 0, TRACE_WIFI_TIMED_OUT, 0);
+                backOff(now);
+                WiFi.disconnect();
+                wait = wifiBackoffMs;
             }
-        } else {
-            Serial.println("Failed to sync time after multiple attempts");
-        }
-    } else {
-        Serial.println("\nWiFi connection failed");
+            break;
+        case WIFI_STATE_BACKOFF:
+            wait = millisLeft(now, wifiStateSince, wifiBackoffMs);
+            if (wait == 0) {
+                startConnect(now);
+                wait = WIFI_CONNECT_TIMEOUT_MS;
+            }
+            break;
+        case WIFI_STATE_CONNECTED:
+            break;
     }
-}
\ No newline at end of file
+    return min(wait, checkTimeSync(now));
+}
@@ -0,0 +1,147 @@
+// plant_cbor.cpp
+#include "water_my_plants.h"
+
+// /api/plants as CBOR (RFC 8949) for machine clients, rendered one plant at
+// a time like the JSON body. Everything is a positional array, so there
+// are no keys on the wire, and amounts go out as integer hundredths of an
+// ounce, so there is no decimal formatting either. Fields are only ever
+// appended; client/plant_cbor.h decodes it and skips what it doesn't know.
+//
+//   [schema, stateVersion, now, [plant, ...]]
+//   plant:   [name, centiOzPerWatering, intervalMinutes, pumpState,
+//             waitingSince, needsWatering, history, usage]
+//   history: [[timestamp, centiOz], ...]       newest first
+//   usage:   [[waterings, centiOz, meanIntervalMinutes], ...]
+//                                              24h, 7d, 30d, lifetime
+//
+// pumpState is 0 idle, 1 waiting, 2 running; waitingSince and
+// meanIntervalMinutes are 0 when they don't apply. A non-finite amount is
+// null. now is when the body was rendered; usage is as of the start of
+// that hour, like the JSON body.
+
+#define CBOR_UNSIGNED 0
+#define CBOR_NEGATIVE 1
+#define CBOR_TEXT 3
+#define CBOR_ARRAY 4
+#define CBOR_FALSE 0xf4
+#define CBOR_TRUE 0xf5
+#define CBOR_NULL 0xf6
+
+// Bounded writer for one record
+struct CborOut {
+    uint8_t* p;
+    uint8_t* end;
+
+    void byte(uint8_t b) {
+        if (p < end) *p++ = b;
+    }
+
+    // Major type and argument in the shortest form
+    void head(uint8_t major, uint64_t value) {
+        major <<= 5;
+        if (value < 24) {
+            byte(major | value);
+            return;
+        }
+        int bytes = value <= 0xff ? 1 : value <= 0xffff ? 2 : value <= 0xffffffffULL ? 4 : 8;
+        byte(major | (bytes == 1 ? 24 : bytes == 2 ? 25 : bytes == 4 ? 26 : 27));
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) byte(value >> shift);
+    }
+
+    void integer(int64_t value) {
+        if (value < 0) {
+            head(CBOR_NEGATIVE, (uint64_t)(-1 - value));
+        } else {
+            head(CBOR_UNSIGNED, value);
+        }
+    }
+
+    // Same rounding as the JSON body's two decimals. Past the range the
+    // JSON body switches to an exponent for, hundredths may not fit an
+    // int64_t, so those are null too.
+    void centi(float value) {
+        if (isnan(value) || isinf(value) || fabsf(value) >= 1e15f) {
+            byte(CBOR_NULL);
+            return;
+        }
+        integer(llround((double)value * 100.0));
+    }
+
+    void text(const char* s, size_t maxLen) {
+        size_t len = strnlen(s, maxLen);
+        head(CBOR_TEXT, len);
+        for (size_t i = 0; i < len; i++) byte(s[i]);
+    }
+
+    void boolean(bool value) {
+        byte(value ? CBOR_TRUE : CBOR_FALSE);
+    }
+};
+
+static void writeUsage(CborOut& out, const UsageTotals& totals) {
+    out.head(CBOR_ARRAY, 3);
+    out.integer(totals.waterings);
+    out.centi(totals.oz);
+    out.integer(totals.waterings ? totals.meanIntervalMinutes : 0);
+}
+
+static void writePlant(CborOut& out, int i, time_t usageAsOf) {
+    PlantSnapshot plant;
+    if (!readPlantSnapshot(i, plant)) {
+        // Keeps the array the advertised length
+        out.byte(CBOR_NULL);
+        return;
+    }
+    out.head(CBOR_ARRAY, 8);
+    out.text(plant.name, sizeof(plant.name));
+    out.centi(plant.ozPerWatering);
+    out.integer(plant.intervalMinutes);
+    out.integer(plant.pumpRunning ? 2 : plant.waitingSince ? 1 : 0);
+    out.integer(plant.pumpRunning ? 0 : plant.waitingSince);
+    out.boolean(plant.needsWatering);
+
+    out.head(CBOR_ARRAY, WATERING_HISTORY_SIZE);
+    for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
+        out.head(CBOR_ARRAY, 2);
+        out.integer(plant.history[j].timestamp);
+        out.centi(plant.history[j].amount);
+    }
+
+    out.head(CBOR_ARRAY, 4);
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_24H, usageAsOf));
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_7D, usageAsOf));
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_30D, usageAsOf));
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_LIFETIME, usageAsOf));
+}
+
+// Renders plant i, preceded by the envelope for the first one
+static size_t renderPlantRecord(int i, uint8_t* buf, size_t size) {
+    CborOut out = {buf, buf + size};
+    time_t now = timeNow();
+    if (i == 0) {
+        out.head(CBOR_ARRAY, 4);
+        out.integer(PLANT_CBOR_SCHEMA);
+        out.integer(stateVersion.load());
+        out.integer(now);
+        out.head(CBOR_ARRAY, numPumps);
+    }
+    if (i < numPumps) writePlant(out, i, rollupAsOf(now));
+    return out.p - buf;
+}
+
+size_t fillPlantDataCbor(PlantCborCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    int records = numPumps > 0 ? numPumps : 1;
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.offset == cursor.length) {
+            if (cursor.next >= records) break;
+            cursor.length = renderPlantRecord(cursor.next++, cursor.record, sizeof(cursor.record));
+            cursor.offset = 0;
+        }
+        size_t n = min(cursor.length - cursor.offset, maxLen - written);
+        memcpy(buffer + written, cursor.record + cursor.offset, n);
+        cursor.offset += n;
+        written += n;
+    }
+    return written;
+}
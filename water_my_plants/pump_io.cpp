@@ -0,0 +1,124 @@
+// pump_io.cpp
+#include "water_my_plants.h"
+#include <mutex>
+
+// Pump driver inputs, on the ESP32's own GPIO or on MCP23017 I2C expanders.
+// Expander pins are staged in a copy of each chip's output latches and sent
+// by flushPumpOutputs(), one transaction per chip that changed, so
+// switching a rack of pumps costs a few bus writes rather than one per pin.
+// Native pins switch as soon as they are set.
+
+#define MCP23017_IODIRA 0x00    // IOCON.BANK = 0, the power-on layout
+#define MCP23017_OLATA 0x14
+
+struct ExpanderOutputs {
+    std::atomic<uint16_t> latch;    // staged levels, GPB in the high byte
+    uint16_t written;               // last sent to the chip
+    bool inSync;                    // the chip is known to hold written
+};
+
+static ExpanderOutputs* expanderOutputs = nullptr;
+// Starts come from the control task and stops from the esp_timer task
+static std::mutex busLock;
+
+static bool isExpanderPin(int pin) {
+    return pin & EXPANDER_PIN_FLAG;
+}
+
+static int expanderIndex(int pin) {
+    return (pin >> 4) & 0xff;
+}
+
+// Writes a register pair, A then B, in one transaction
+static bool writeRegisterPair(const PumpExpander& expander, uint8_t reg, uint16_t value) {
+    expander.bus->beginTransmission(expander.address);
+    expander.bus->write(reg);
+    expander.bus->write((uint8_t)(value & 0xff));
+    expander.bus->write((uint8_t)(value >> 8));
+    return expander.bus->endTransmission() == 0;
+}
+
+static void setPumpOutput(int pin, uint8_t level) {
+    if (!isExpanderPin(pin)) {
+        digitalWrite(pin, level);
+        return;
+    }
+    std::atomic<uint16_t>& latch = expanderOutputs[expanderIndex(pin)].latch;
+    uint16_t bit = 1 << (pin & 0x0f);
+    if (level) {
+        latch.fetch_or(bit);
+    } else {
+        latch.fetch_and((uint16_t)~bit);
+    }
+}
+
+static bool validPin(int pump, int pin) {
+    if (!isExpanderPin(pin) || expanderIndex(pin) < numPumpExpanders) return true;
+    LOG_ERROR("Pump %d: pin %#x is on expander %d, which isn't configured",
+              pump, pin, expanderIndex(pin));
+    return false;
+}
+
+// Checks the pump table against the expander table, then drives every
+// pump input low. Latches go to zero before the pins become outputs, since
+// an expander keeps its state across an ESP32 reset.
+bool pumpsBegin() {
+    bool ok = true;
+    for (int i = 0; i < numPumps; i++) {
+        ok &= validPin(pumps[i].number, pumps[i].in1);
+        ok &= validPin(pumps[i].number, pumps[i].in2);
+    }
+    if (!ok) return false;
+
+    if (!expanderOutputs && numPumpExpanders > 0) {
+        expanderOutputs = new ExpanderOutputs[numPumpExpanders];
+    }
+    for (int e = 0; e < numPumpExpanders; e++) {
+        bool begun = false;
+        for (int j = 0; j < e; j++) begun |= pumpExpanders[j].bus == pumpExpanders[e].bus;
+        if (!begun) pumpExpanders[e].bus->begin();
+        expanderOutputs[e].latch = 0;
+        expanderOutputs[e].inSync = false;
+    }
+
+    for (int i = 0; i < numPumps; i++) {
+        if (!isExpanderPin(pumps[i].in1)) pinMode(pumps[i].in1, OUTPUT);
+        if (!isExpanderPin(pumps[i].in2)) pinMode(pumps[i].in2, OUTPUT);
+        pumpOff(pumps[i]);
+    }
+    flushPumpOutputs();
+
+    std::lock_guard<std::mutex> lock(busLock);
+    for (int e = 0; e < numPumpExpanders; e++) {
+        if (!writeRegisterPair(pumpExpanders[e], MCP23017_IODIRA, 0x0000)) {
+            LOG_ERROR("Pump expander %d (0x%02x) is not responding", e, pumpExpanders[e].address);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Sends the staged levels of every expander that changed since the last
+// flush. A chip that failed to take a write is sent again next time.
+void flushPumpOutputs() {
+    std::lock_guard<std::mutex> lock(busLock);
+    for (int e = 0; e < numPumpExpanders; e++) {
+        ExpanderOutputs& outputs = expanderOutputs[e];
+        uint16_t latch = outputs.latch.load();
+        if (outputs.inSync && latch == outputs.written) continue;
+        outputs.inSync = writeRegisterPair(pumpExpanders[e], MCP23017_OLATA, latch);
+        outputs.written = latch;
+    }
+}
+
+void pumpOn(Pump& pump) {
+    setPumpOutput(pump.in1, HIGH);
+    setPumpOutput(pump.in2, LOW);
+    traceRecord(TRACE_PUMP_ON, (uint16_t)(&pump - pumps), 0, pump.runDuration);
+}
+
+void pumpOff(Pump& pump) {
+    setPumpOutput(pump.in1, LOW);
+    setPumpOutput(pump.in2, LOW);
+    traceRecord(TRACE_PUMP_OFF, (uint16_t)(&pump - pumps), 0, 0);
+}
@@ -0,0 +1,324 @@
+// registry.cpp
+#include "water_my_plants.h"
+#include <stdlib.h>
+#include <new>
+
+// The zone table: how many pumps there are and how each one is wired. It
+// is read once at boot from /pumps.cfg on SPIFFS, or taken from the
+// defaults in config.cpp if there is none, and everything kept per pump is
+// sized from numPumps after that. A board with more zones only needs a new
+// table and a restart, not a new build.
+//
+// /pumps.cfg is plain text, one entry per line, '#' to the end of a line
+// is a comment:
+//
+//     expander 0 0x20     # bus (0 = Wire, 1 = Wire1), address 0x20-0x27
+//     pump 33 23          # in1 in2 [weight]: pump 1 on GPIO 33 and 23
+//     pump x0.0 x0.1 2    # pump 2 on pins 0 and 1 of the first expander
+//
+// Pins are GPIO numbers (0-33; 34-39 are inputs only) or x<expander>.<pin>,
+// pin 0-15 (GPA0-7, then GPB0-7), for an expander listed above the line.
+// Pump n waters plant n; plants past config.cpp's list start as "Zone n".
+//
+// A table from the file may list at most maxPumps() pumps, so that its
+// zones fit the EEPROM and heap budgets; the built-in table is taken to
+// fit the board it was built for.
+
+#define PUMP_CONFIG_LINE_MAX 96
+
+// Heap a zone takes beyond its plant, pump and snapshot: its metrics,
+// schedule heap entries, journal queue slots and flags
+#define ZONE_HEAP_ALLOWANCE 160
+
+const int SIZE_PER_PLANT =
+    32 +                   // name[32]
+    sizeof(float) +        // ozPerWatering
+    sizeof(int) +          // intervalMinutes
+    sizeof(int) +          // currentHistoryIndex
+    sizeof(bool) +         // needsWatering
+    3 +                    // padding to align to 4 bytes
+    (WATERING_HISTORY_SIZE * (sizeof(time_t) + sizeof(float))) + // wateringHistory
+    sizeof(PlantRollup);   // rollup
+
+Plant* plants = nullptr;
+Pump* pumps = nullptr;
+ZoneState zones = {};
+int numPumps = 0;
+const PumpExpander* pumpExpanders = nullptr;
+int numPumpExpanders = 0;
+int eepromSize = 0;
+
+// Whether the active table came from /pumps.cfg, for GET /api/config/pumps
+static bool tableFromFile = false;
+
+// Most pumps a table from /pumps.cfg may list on this board
+int maxPumps() {
+    const size_t heapPerZone = sizeof(Plant) + sizeof(Pump) + sizeof(PlantSnapshot) + 2 * sizeof(bool) +
+                               sizeof(time_t) + ZONE_HEAP_ALLOWANCE;
+    int byEeprom = (ZONE_EEPROM_BUDGET - (int)sizeof(uint32_t)) / SIZE_PER_PLANT;
+    int byHeap = (int)(ZONE_HEAP_BUDGET / heapPerZone);
+    return byEeprom < byHeap ? byEeprom : byHeap;
+}
+
+// Reads the next line into buf, without its newline; false at the end of
+// the file. A line that doesn't fit sets tooLong and is skipped past.
+static bool readLine(File& file, char* buf, size_t size, bool& tooLong) {
+    size_t length = 0;
+    tooLong = false;
+    int c = file.read();
+    if (c < 0) return false;
+    for (; c >= 0 && c != '\n'; c = file.read()) {
+        if (length + 1 < size) {
+            buf[length++] = (char)c;
+        } else {
+            tooLong = true;
+        }
+    }
+    if (length > 0 && buf[length - 1] == '\r') length--;
+    buf[length] = '\0';
+    return true;
+}
+
+// A whole word as a number in [min, max]; decimal, or hex with 0x
+static bool parseNumber(const char* word, long min, long max, long& value) {
+    char* end;
+    value = strtol(word, &end, 0);
+    return end != word && *end == '\0' && value >= min && value <= max;
+}
+
+// A GPIO number or x<expander>.<pin>; the problem, or nullptr if none
+static const char* parsePin(char* word, int expanderCount, int& pin) {
+    if (word[0] != 'x') {
+        long gpio;
+        if (!parseNumber(word, 0, 33, gpio)) return "Invalid GPIO (0-33)";
+        pin = (int)gpio;
+        return nullptr;
+    }
+    char* dot = strchr(word, '.');
+    if (!dot) return "Invalid expander pin (x<expander>.<pin>)";
+    *dot = '\0';
+    long expander, number;
+    bool valid = parseNumber(word + 1, 0, MAX_PUMP_EXPANDERS - 1, expander) && parseNumber(dot + 1, 0, 15, number);
+    *dot = '.';
+    if (!valid) return "Invalid expander pin (x<expander>.<pin>)";
+    if (expander >= expanderCount) return "Expander not listed above";
+    pin = EXPANDER_PIN((int)expander, (int)number);
+    return nullptr;
+}
+
+// Reads a zone table from the start of file. Expanders always go into
+// expanders, which holds MAX_PUMP_EXPANDERS; pumps are only counted unless
+// wiring is given, with room for as many as a first pass counted.
+static PumpConfigCheck parsePumpConfig(File& file, PumpExpander* expanders, PumpWiring* wiring) {
+    PumpConfigCheck check = {0, 0, 0, nullptr};
+    char line[PUMP_CONFIG_LINE_MAX];
+    bool tooLong;
+    while (readLine(file, line, sizeof(line), tooLong)) {
+        check.line++;
+        if (tooLong) {
+            check.error = "Line too long";
+            return check;
+        }
+        if (char* comment = strchr(line, '#')) *comment = '\0';
+
+        char* words[5];
+        int count = 0;
+        char* save;
+        for (char* word = strtok_r(line, " \t", &save); word; word = strtok_r(nullptr, " \t", &save)) {
+            if (count == 5) break;
+            words[count++] = word;
+        }
+        if (count == 0) continue;
+
+        if (strcmp(words[0], "expander") == 0) {
+            long bus, address;
+            if (count != 3) {
+                check.error = "Expected: expander <bus> <address>";
+            } else if (!parseNumber(words[1], 0, 1, bus)) {
+                check.error = "Invalid bus (0 or 1)";
+            } else if (!parseNumber(words[2], 0x20, 0x27, address)) {
+                check.error = "Invalid address (0x20-0x27)";
+            } else {
+                TwoWire* wire = bus ? &Wire1 : &Wire;
+                for (int e = 0; e < check.expanders && !check.error; e++) {
+                    if (expanders[e].bus == wire && expanders[e].address == address) check.error = "Duplicate expander";
+                }
+                if (!check.error) expanders[check.expanders++] = {wire, (uint8_t)address};
+            }
+        } else if (strcmp(words[0], "pump") == 0) {
+            PumpWiring pump = {0, 0, 1};
+            long weight = 1;
+            if (count != 3 && count != 4) {
+                check.error = "Expected: pump <in1> <in2> [weight]";
+            } else if (check.pumps == maxPumps()) {
+                check.error = "Too many pumps for this board";
+            } else if (!(check.error = parsePin(words[1], check.expanders, pump.in1)) &&
+                       !(check.error = parsePin(words[2], check.expanders, pump.in2))) {
+                if (count == 4 && !parseNumber(words[3], 0, 255, weight)) {
+                    check.error = "Invalid weight (0-255)";
+                } else if (pump.in1 == pump.in2) {
+                    check.error = "in1 and in2 are the same pin";
+                } else {
+                    pump.weight = (uint8_t)weight;
+                    if (wiring) wiring[check.pumps] = pump;
+                    check.pumps++;
+                }
+            }
+        } else {
+            check.error = "Unknown entry (expander or pump)";
+        }
+        if (check.error) return check;
+    }
+    if (check.pumps == 0) check.error = "No pumps listed";
+    return check;
+}
+
+// Checks the zone table at path without applying it
+PumpConfigCheck checkPumpConfig(const char* path) {
+    PumpExpander expanders[MAX_PUMP_EXPANDERS];
+    File file = SPIFFS.open(path, "r");
+    if (!file) return {0, 0, 0, "Cannot read the table"};
+    PumpConfigCheck check = parsePumpConfig(file, expanders, nullptr);
+    file.close();
+    return check;
+}
+
+static void freeZones() {
+    delete[] plants;
+    delete[] pumps;
+    delete[] zones.running;
+    delete[] zones.needsWatering;
+    delete[] zones.waitingSince;
+    plants = nullptr;
+    pumps = nullptr;
+    zones = {};
+}
+
+// Allocates plants[], pumps[] and zones for count pumps and opens an
+// EEPROM image to match; false, with nothing left allocated, if either
+// fails
+static bool allocateZones(int count) {
+    plants = new (std::nothrow) Plant[count]();
+    pumps = new (std::nothrow) Pump[count]();
+    zones.running = new (std::nothrow) bool[count]();
+    zones.needsWatering = new (std::nothrow) bool[count]();
+    zones.waitingSince = new (std::nothrow) time_t[count]();
+    int size = sizeof(uint32_t) + count * SIZE_PER_PLANT;
+    if (!plants || !pumps || !zones.running || !zones.needsWatering || !zones.waitingSince || !EEPROM.begin(size)) {
+        freeZones();
+        return false;
+    }
+    numPumps = count;
+    eepromSize = size;
+    return true;
+}
+
+// Wires pumps[] from the table and gives each plant its defaults
+static void fillZones(const PumpWiring* wiring) {
+    for (int i = 0; i < numPumps; i++) {
+        Plant& plant = plants[i];
+        if (i < NUM_DEFAULT_PLANTS) {
+            strncpy(plant.name, defaultPlants[i].name, sizeof(plant.name) - 1);
+            plant.ozPerWatering = defaultPlants[i].ozPerWatering;
+            plant.intervalMinutes = defaultPlants[i].intervalMinutes;
+        } else {
+            snprintf(plant.name, sizeof(plant.name), "Zone %d", i + 1);
+        }
+
+        Pump& pump = pumps[i];
+        pump.in1 = wiring[i].in1;
+        pump.in2 = wiring[i].in2;
+        pump.number = i + 1;
+        pump.plant = &plant;
+        pump.weight = wiring[i].weight;
+    }
+}
+
+// Sizes and fills plants[], pumps[] and zones, and opens the EEPROM image.
+// Runs before anything else that allocates per pump, and only once: the
+// table applies until restart. A table that doesn't parse, or doesn't fit
+// in memory after all, is reported and the defaults used instead, so the
+// pumps still come up, if with the wrong wiring.
+bool pumpRegistryBegin() {
+    if (pumps) return true;
+
+    static PumpExpander fileExpanders[MAX_PUMP_EXPANDERS];
+
+    // Mounted without formatting: an empty partition just means no table
+    if (SPIFFS.begin(false) && SPIFFS.exists(PUMP_CONFIG_PATH)) {
+        File file = SPIFFS.open(PUMP_CONFIG_PATH, "r");
+        PumpConfigCheck check = parsePumpConfig(file, fileExpanders, nullptr);
+        PumpWiring* wiring = nullptr;
+        if (check.error) {
+            LOG_ERROR("%s line %d: %s - using the built-in zone table", PUMP_CONFIG_PATH, check.line, check.error);
+        } else if (!(wiring = new (std::nothrow) PumpWiring[check.pumps]) || !allocateZones(check.pumps)) {
+            LOG_ERROR("%s: no room for %d pumps - using the built-in zone table", PUMP_CONFIG_PATH, check.pumps);
+        } else {
+            file.seek(0);
+            parsePumpConfig(file, fileExpanders, wiring);
+            fillZones(wiring);
+            pumpExpanders = fileExpanders;
+            numPumpExpanders = check.expanders;
+            tableFromFile = true;
+        }
+        delete[] wiring;
+        file.close();
+    }
+
+    if (!tableFromFile) {
+        if (!allocateZones(NUM_DEFAULT_PUMPS)) return false;
+        fillZones(defaultPumps);
+        pumpExpanders = defaultPumpExpanders;
+        numPumpExpanders = NUM_DEFAULT_PUMP_EXPANDERS;
+    }
+    LOG_INFO("Zone table: %d pumps, %d expanders, from %s", numPumps, numPumpExpanders,
+             tableFromFile ? PUMP_CONFIG_PATH : "the built-in table");
+    return true;
+}
+
+// Writes pin as the table has it
+static void formatPin(int pin, char* buf, size_t size) {
+    if (pin & EXPANDER_PIN_FLAG) {
+        snprintf(buf, size, "x%d.%d", (pin >> 4) & 0xff, pin & 0x0f);
+    } else {
+        snprintf(buf, size, "%d", pin);
+    }
+}
+
+// Renders line k of the active table: a heading, the expanders, then the
+// pumps in order
+static size_t renderPumpConfigLine(int k, char* buf, size_t size) {
+    if (k == 0) {
+        return snprintf(buf, size, "# %d pumps, from %s; up to %d fit\n", numPumps,
+                        tableFromFile ? PUMP_CONFIG_PATH : "the built-in table", maxPumps());
+    }
+    k--;
+    if (k < numPumpExpanders) {
+        const PumpExpander& expander = pumpExpanders[k];
+        return snprintf(buf, size, "expander %d 0x%02x\n", expander.bus == &Wire1 ? 1 : 0, expander.address);
+    }
+    const Pump& pump = pumps[k - numPumpExpanders];
+    char in1[12], in2[12];
+    formatPin(pump.in1, in1, sizeof(in1));
+    formatPin(pump.in2, in2, sizeof(in2));
+    return snprintf(buf, size, "pump %s %s %d\n", in1, in2, pump.weight);
+}
+
+// Body of GET /api/config/pumps: the table in effect, in the format of
+// /pumps.cfg, so it can be edited and sent back
+size_t fillPumpConfig(PumpConfigCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    int lines = 1 + numPumpExpanders + numPumps;
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.offset == cursor.length) {
+            if (cursor.next >= lines) break;
+            cursor.length = renderPumpConfigLine(cursor.next++, cursor.record, sizeof(cursor.record));
+            cursor.offset = 0;
+        }
+        size_t n = min(cursor.length - cursor.offset, maxLen - written);
+        memcpy(buffer + written, cursor.record + cursor.offset, n);
+        cursor.offset += n;
+        written += n;
+    }
+    return written;
+}
@@ -0,0 +1,141 @@
+// request_body.cpp
+#include "water_my_plants.h"
+
+// JSON request bodies. AsyncWebServer hands a body over one TCP segment
+// at a time; each route's segments are collected into a buffer from a
+// fixed pool, sized when the routes are registered, and the route only
+// sees a complete, parsed document. Each buffer has its own document,
+// allocated with it, so a request never touches the heap. All of it runs
+// on the AsyncTCP task.
+
+#define BODY_SMALL_MAX 256      // single-field settings
+#define BODY_SMALL_BUFFERS 4    // one per connection AsyncTCP keeps open
+#define BODY_LARGE_BUFFERS 1    // bulk edits take turns
+
+// Parsed size of a body; even the tersest member ("a":1,) costs a 16-byte
+// slot plus its key. Enough even if the strings are copied, though on the
+// device they stay in the buffer.
+#define BODY_JSON_CAPACITY(length) ((length) * 3 + 256)
+
+struct BodyBuffer {
+    AsyncWebServerRequest* owner;   // nullptr while free
+    size_t size;
+    size_t length;                  // received so far
+    char* data;                     // size + 1 bytes, NUL-terminated
+    DynamicJsonDocument* doc;       // parsed body; its strings point into data
+};
+
+static BodyBuffer pool[BODY_SMALL_BUFFERS + BODY_LARGE_BUFFERS];
+static const int POOL_SIZE = sizeof(pool) / sizeof(pool[0]);
+static size_t largeMax = 0;         // biggest limit of any route
+
+static BodyBuffer* findBuffer(AsyncWebServerRequest* request) {
+    for (BodyBuffer& buffer : pool) {
+        if (buffer.owner == request) return &buffer;
+    }
+    return nullptr;
+}
+
+static void releaseBuffer(AsyncWebServerRequest* request) {
+    if (BodyBuffer* buffer = findBuffer(request)) buffer->owner = nullptr;
+}
+
+// Smallest free buffer that holds total bytes
+static BodyBuffer* acquireBuffer(AsyncWebServerRequest* request, size_t total) {
+    BodyBuffer* best = nullptr;
+    for (BodyBuffer& buffer : pool) {
+        if (buffer.owner || !buffer.data || buffer.size < total) continue;
+        if (!best || buffer.size < best->size) best = &buffer;
+    }
+    if (!best) return nullptr;
+    best->owner = request;
+    best->length = 0;
+    best->data[0] = '\0';
+    // Freed with the connection too, in case the rest of the body never comes
+    request->onDisconnect([request]() { releaseBuffer(request); });
+    return best;
+}
+
+// Allocates the pool once every route has said how big its bodies get
+void requestBodyBegin() {
+    for (int i = 0; i < POOL_SIZE; i++) {
+        if (pool[i].data) continue;
+        pool[i].size = i < BODY_SMALL_BUFFERS ? BODY_SMALL_MAX : largeMax;
+        if (pool[i].size == 0) continue;
+        pool[i].data = new char[pool[i].size + 1];
+        pool[i].doc = new DynamicJsonDocument(BODY_JSON_CAPACITY(pool[i].size));
+        pool[i].owner = nullptr;
+    }
+}
+
+size_t requestBodyBuffersFree() {
+    size_t free = 0;
+    for (const BodyBuffer& buffer : pool) {
+        if (buffer.data && !buffer.owner) free++;
+    }
+    return free;
+}
+
+static void collectBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total,
+                        size_t maxBody) {
+    if (total > maxBody) return;
+    BodyBuffer* buffer = index == 0 ? acquireBuffer(request, total) : findBuffer(request);
+    // A segment out of order means one went missing; the length check in
+    // finishBody() turns that into a 400
+    if (!buffer || index != buffer->length || index + len > buffer->size) return;
+    memcpy(buffer->data + index, data, len);
+    buffer->length += len;
+    buffer->data[buffer->length] = '\0';
+}
+
+static void finishBody(AsyncWebServerRequest* request, size_t maxBody, const JsonBodyHandler& handler) {
+    size_t total = request->contentLength();
+    if (total > maxBody) {
+        request->send(413, "application/json", "{\"error\":\"Request body too large\"}");
+        return;
+    }
+    BodyBuffer* buffer = findBuffer(request);
+    if (!buffer && total > 0) {
+        AsyncWebServerResponse* response = request->beginResponse(503, "application/json", "{\"error\":\"Server busy\"}");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
+    }
+    if (!buffer || buffer->length != total) {
+        releaseBuffer(request);
+        request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
+        return;
+    }
+
+    // Parsed in place: ArduinoJson leaves the strings of a mutable input
+    // in it, so the buffer is only released once the handler is done
+    DeserializationError error = deserializeJson(*buffer->doc, buffer->data, buffer->length);
+    if (error) {
+        releaseBuffer(request);
+        request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
+        return;
+    }
+    handler(request, *buffer->doc);
+    releaseBuffer(request);
+}
+
+// Registers a route whose handler gets the body parsed as JSON. Bodies over
+// maxBody get a 413, and a 503 with Retry-After when no buffer is free.
+// Requests are timed for /metrics.
+void onJsonBody(const char* uri, WebRequestMethod method, size_t maxBody, JsonBodyHandler handler) {
+    if (maxBody > BODY_SMALL_MAX && maxBody > largeMax) largeMax = maxBody;
+    int route = metricsRoute(uri, method);
+    server.on(
+        uri,
+        method,
+        [maxBody, handler, route](AsyncWebServerRequest* request) {
+            // Parsing and the handler; the body arrived before this
+            int64_t start = esp_timer_get_time();
+            finishBody(request, maxBody, handler);
+            metricsRequest(route, esp_timer_get_time() - start);
+        },
+        nullptr,
+        [maxBody](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            collectBody(request, data, len, index, total, maxBody);
+        });
+}
@@ -0,0 +1,184 @@
+// rollup.cpp
+#include "water_my_plants.h"
+
+// Per-plant usage over rolling windows. Each window is a ring of slots
+// plus a running sum; a watering advances the rings to its hour and day
+// and adds itself, so the cost per watering is bounded by the ring sizes
+// however long the plant has been running, and usually a single slot.
+
+#define SECONDS_PER_HOUR 3600UL
+#define SECONDS_PER_DAY 86400UL
+
+// Adds to a slot field and returns how much fit, so the running sums
+// never hold more than the slots they are later reduced by
+static uint32_t addToSlot(uint16_t& field, uint32_t amount) {
+    uint32_t room = UINT16_MAX - field;
+    if (amount > room) amount = room;
+    field += amount;
+    return amount;
+}
+
+// Moves the hourly ring forward to hour, dropping the hours that leave it
+static void advanceHours(PlantRollup& r, uint32_t hour) {
+    if (hour <= r.hour) return;
+    if (hour - r.hour >= ROLLUP_HOURS) {
+        memset(r.hourSlots, 0, sizeof(r.hourSlots));
+        r.dayWaterings = 0;
+        r.dayCentiOz = 0;
+    } else {
+        for (uint32_t h = r.hour + 1; h <= hour; h++) {
+            RollupSlot& slot = r.hourSlots[h % ROLLUP_HOURS];
+            r.dayWaterings -= slot.waterings;
+            r.dayCentiOz -= slot.centiOz;
+            slot = RollupSlot();
+        }
+    }
+    r.hour = hour;
+}
+
+// Moves the daily ring forward to day. A day leaves the 7-day sum a week
+// later, but its slot is only reused after 30.
+static void advanceDays(PlantRollup& r, uint32_t day) {
+    if (day <= r.day) return;
+    if (day - r.day >= ROLLUP_DAYS) {
+        memset(r.daySlots, 0, sizeof(r.daySlots));
+        r.weekWaterings = 0;
+        r.weekCentiOz = 0;
+        r.monthWaterings = 0;
+        r.monthCentiOz = 0;
+    } else {
+        for (uint32_t d = r.day + 1; d <= day; d++) {
+            const RollupSlot& weekOld = r.daySlots[(d + ROLLUP_DAYS - 7) % ROLLUP_DAYS];
+            r.weekWaterings -= weekOld.waterings;
+            r.weekCentiOz -= weekOld.centiOz;
+            RollupSlot& slot = r.daySlots[d % ROLLUP_DAYS];
+            r.monthWaterings -= slot.waterings;
+            r.monthCentiOz -= slot.centiOz;
+            slot = RollupSlot();
+        }
+    }
+    r.day = day;
+}
+
+void rollupAdd(PlantRollup& r, time_t timestamp, float oz) {
+    if (timestamp <= 0) return;
+    uint32_t t = (uint32_t)timestamp;
+    uint32_t cents = oz > 0 ? (uint32_t)lroundf(oz * 100) : 0;
+
+    r.lifetimeWaterings++;
+    r.lifetimeCentiOz += cents;
+    if (r.firstWatered == 0 || t < r.firstWatered) r.firstWatered = t;
+
+    uint32_t hour = t / SECONDS_PER_HOUR;
+    uint32_t day = t / SECONDS_PER_DAY;
+    advanceHours(r, hour);
+    advanceDays(r, day);
+
+    // A watering older than the newest slot (the clock was stepped back)
+    // still counts if its slot is in the ring
+    if (r.hour - hour < ROLLUP_HOURS) {
+        RollupSlot& slot = r.hourSlots[hour % ROLLUP_HOURS];
+        r.dayWaterings += addToSlot(slot.waterings, 1);
+        r.dayCentiOz += addToSlot(slot.centiOz, cents);
+    }
+    if (r.day - day < ROLLUP_DAYS) {
+        RollupSlot& slot = r.daySlots[day % ROLLUP_DAYS];
+        uint32_t waterings = addToSlot(slot.waterings, 1);
+        uint32_t added = addToSlot(slot.centiOz, cents);
+        r.monthWaterings += waterings;
+        r.monthCentiOz += added;
+        if (r.day - day < 7) {
+            r.weekWaterings += waterings;
+            r.weekCentiOz += added;
+        }
+    }
+}
+
+void rollupReset(PlantRollup& r) {
+    r = PlantRollup();
+}
+
+// Whether a rollup read back from flash is self-consistent
+bool rollupValid(const PlantRollup& r) {
+    return r.dayWaterings <= r.lifetimeWaterings && r.weekWaterings <= r.monthWaterings &&
+           r.monthWaterings <= r.lifetimeWaterings && (r.lifetimeWaterings == 0 || r.firstWatered != 0);
+}
+
+// Takes the slots that aged out between newest and now off a window's
+// sums; window is the number of slots it spans
+static void expire(const RollupSlot* slots, uint32_t ring, uint32_t window, uint32_t newest, uint32_t now,
+                   uint32_t& waterings, uint32_t& cents) {
+    if (now <= newest) return;
+    uint32_t gone = now - newest < window ? now - newest : window;
+    for (uint32_t k = 0; k < gone; k++) {
+        const RollupSlot& slot = slots[(newest - window + 1 + k) % ring];
+        waterings -= slot.waterings;
+        cents -= slot.centiOz;
+    }
+}
+
+// When usage is reported as of: the start of the current hour, the
+// resolution of the 24 h window, so the totals only change when a
+// watering finishes or the hour turns. /api/plants puts the hour in its
+// ETag for that reason.
+time_t rollupAsOf(time_t now) {
+    return now > 0 ? now - now % SECONDS_PER_HOUR : now;
+}
+
+// Totals for one window as of now, without touching the rollup: a web
+// request can read it while the control loop adds to it
+UsageTotals rollupWindow(const PlantRollup& r, RollupWindow window, time_t now) {
+    uint32_t waterings, cents, span;
+    uint32_t hour = now > 0 ? (uint32_t)now / SECONDS_PER_HOUR : 0;
+    uint32_t day = now > 0 ? (uint32_t)now / SECONDS_PER_DAY : 0;
+    switch (window) {
+        case ROLLUP_24H:
+            waterings = r.dayWaterings;
+            cents = r.dayCentiOz;
+            expire(r.hourSlots, ROLLUP_HOURS, ROLLUP_HOURS, r.hour, hour, waterings, cents);
+            span = ROLLUP_HOURS * SECONDS_PER_HOUR;
+            break;
+        case ROLLUP_7D:
+            waterings = r.weekWaterings;
+            cents = r.weekCentiOz;
+            expire(r.daySlots, ROLLUP_DAYS, 7, r.day, day, waterings, cents);
+            span = 7 * SECONDS_PER_DAY;
+            break;
+        case ROLLUP_30D:
+            waterings = r.monthWaterings;
+            cents = r.monthCentiOz;
+            expire(r.daySlots, ROLLUP_DAYS, ROLLUP_DAYS, r.day, day, waterings, cents);
+            span = ROLLUP_DAYS * SECONDS_PER_DAY;
+            break;
+        default:
+            waterings = r.lifetimeWaterings;
+            cents = r.lifetimeCentiOz;
+            span = UINT32_MAX;
+            break;
+    }
+
+    // Time the window has been watched for, shared out over its waterings
+    uint32_t watched = r.firstWatered && now > (time_t)r.firstWatered ? (uint32_t)(now - r.firstWatered) : 0;
+    if (watched > span) watched = span;
+    UsageTotals totals;
+    totals.waterings = waterings;
+    totals.oz = cents / 100.0f;
+    totals.meanIntervalMinutes = waterings ? watched / waterings / 60 : 0;
+    return totals;
+}
+
+// Recomputes every plant's rollup from the journal; used when the stored
+// records predate rollups
+void rebuildRollups() {
+    for (int i = 0; i < numPumps; i++) rollupReset(plants[i].rollup);
+    JournalReader reader;
+    journalSeek(reader, 0);
+    JournalRecord record;
+    size_t replayed = 0;
+    while (journalNext(reader, record)) {
+        if (record.plant >= numPumps) continue;
+        rollupAdd(plants[record.plant].rollup, record.timestamp, record.amount);
+        replayed++;
+    }
+    LOG_INFO("Rebuilt usage totals from %u journaled waterings", (unsigned)replayed);
+}
@@ -0,0 +1,212 @@
+// scheduler.cpp
+#include "water_my_plants.h"
+#include <limits.h>
+#include <vector>
+
+// Binary min-heap of (deadline, id) with O(log n) update and removal by id
+struct DeadlineHeap {
+    std::vector<int> heap;          // ids in heap order
+    std::vector<int> position;      // id -> index in heap, -1 if absent
+    std::vector<int64_t> deadline;  // id -> deadline
+
+    void resize(int ids) {
+        heap.clear();
+        position.assign(ids, -1);
+        deadline.assign(ids, 0);
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    int top() const {
+        return heap[0];
+    }
+
+    int64_t topDeadline() const {
+        return deadline[heap[0]];
+    }
+
+    void set(int id, int64_t at) {
+        deadline[id] = at;
+        if (position[id] < 0) {
+            position[id] = heap.size();
+            heap.push_back(id);
+        }
+        siftUp(position[id]);
+        siftDown(position[id]);
+    }
+
+    bool contains(int id) const {
+        return position[id] >= 0;
+    }
+
+    void remove(int id) {
+        int i = position[id];
+        if (i < 0) return;
+        int last = heap.back();
+        heap.pop_back();
+        position[id] = -1;
+        if (last == id) return;
+        heap[i] = last;
+        position[last] = i;
+        siftUp(i);
+        siftDown(position[last]);
+    }
+
+    void siftUp(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (deadline[heap[parent]] <= deadline[heap[i]]) break;
+            swap(i, parent);
+            i = parent;
+        }
+    }
+
+    void siftDown(int i) {
+        int n = heap.size();
+        for (;;) {
+            int smallest = i;
+            int left = 2 * i + 1;
+            int right = left + 1;
+            if (left < n && deadline[heap[left]] < deadline[heap[smallest]]) smallest = left;
+            if (right < n && deadline[heap[right]] < deadline[heap[smallest]]) smallest = right;
+            if (smallest == i) break;
+            swap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    void swap(int a, int b) {
+        int id = heap[a];
+        heap[a] = heap[b];
+        heap[b] = id;
+        position[heap[a]] = a;
+        position[heap[b]] = b;
+    }
+};
+
+// One bit per plant or pump, set from any task and drained by the control
+// loop in index order
+struct AtomicBitset {
+    std::atomic<uint32_t>* words = nullptr;
+    int count = 0;
+    int cursor = 0;
+
+    void resize(int bits) {
+        count = (bits + 31) / 32;
+        words = new std::atomic<uint32_t>[count];
+        for (int w = 0; w < count; w++) words[w] = 0;
+        cursor = 0;
+    }
+
+    bool set(int bit) {
+        if (!words || bit < 0 || bit >= count * 32) return false;
+        words[bit / 32].fetch_or(1u << (bit % 32));
+        return true;
+    }
+
+    int take() {
+        if (!words) return -1;
+        for (; cursor < count; cursor++) {
+            uint32_t bits = words[cursor].load();
+            if (bits) {
+                int bit = __builtin_ctz(bits);
+                words[cursor].fetch_and(~(1u << bit));
+                return cursor * 32 + bit;
+            }
+        }
+        // Start over on the next drain; bits set meanwhile are picked up then
+        cursor = 0;
+        return -1;
+    }
+};
+
+static DeadlineHeap dueHeap;        // plant index -> next watering (time_t)
+static DeadlineHeap startHeap;      // pump index -> start queue key (waitingKey())
+static AtomicBitset rescheduled;    // plants whose schedule must be re-read
+static AtomicBitset stoppedPumps;   // pumps switched off by their stop timer
+
+void schedulerBegin() {
+    dueHeap.resize(numPumps);
+    startHeap.resize(numPumps);
+    rescheduled.resize(numPumps);
+    stoppedPumps.resize(numPumps);
+    rescheduleAllPlants();
+}
+
+void reschedulePlant(int plantIndex) {
+    if (plantIndex >= numPumps) return;
+    if (rescheduled.set(plantIndex)) wakeControlTask();
+}
+
+void rescheduleAllPlants() {
+    for (int i = 0; i < numPumps; i++) reschedulePlant(i);
+}
+
+int takeRescheduledPlant() {
+    return rescheduled.take();
+}
+
+void setPlantDue(int plantIndex, time_t due) {
+    dueHeap.set(plantIndex, due);
+}
+
+void clearPlantDue(int plantIndex) {
+    dueHeap.remove(plantIndex);
+}
+
+// Takes a plant whose watering was due by now, along with when it was due
+int takeDuePlant(time_t now, time_t& due) {
+    if (dueHeap.empty() || dueHeap.topDeadline() > now) return -1;
+    int plantIndex = dueHeap.top();
+    due = dueHeap.topDeadline();
+    dueHeap.remove(plantIndex);
+    return plantIndex;
+}
+
+// Start queue order: longest overdue first, then lowest pump index, so the
+// order is the same however the plants arrived
+static int64_t waitingKey(int pumpIndex, time_t since) {
+    return (int64_t)since * 65536 + pumpIndex;
+}
+
+// Queues pump i to start once the power budget allows; a pump already
+// waiting keeps its place
+void queuePumpStart(int pumpIndex, time_t since) {
+    if (startHeap.contains(pumpIndex)) return;
+    startHeap.set(pumpIndex, waitingKey(pumpIndex, since));
+}
+
+void removeWaitingPump(int pumpIndex) {
+    startHeap.remove(pumpIndex);
+}
+
+bool pumpWaiting(int pumpIndex) {
+    return startHeap.contains(pumpIndex);
+}
+
+// The pump at the head of the start queue, left queued; -1 if none
+int nextWaitingPump() {
+    return startHeap.empty() ? -1 : startHeap.top();
+}
+
+size_t waitingPumpCount() {
+    return startHeap.heap.size();
+}
+
+// Called from a pump's stop timer once the pump is off
+void markPumpStopped(int pumpIndex) {
+    if (stoppedPumps.set(pumpIndex)) wakeControlTask();
+}
+
+int takeStoppedPump() {
+    return stoppedPumps.take();
+}
+
+unsigned long millisUntilNextDeadline(time_t now) {
+    if (dueHeap.empty()) return ULONG_MAX;
+    int64_t wait = (dueHeap.topDeadline() - now) * 1000;
+    if (wait < 0) return 0;
+    return (uint64_t)wait > ULONG_MAX ? ULONG_MAX : (unsigned long)wait;
+}
@@ -0,0 +1,63 @@
+// snapshot.cpp
+#include "water_my_plants.h"
+
+// Copies of plant state for readers on other tasks (web server, event
+// pushes). The control loop owns plants[] and pumps[] and republishes a
+// plant after each change; readers copy a plant's snapshot under its
+// sequence lock and retry if the control loop rewrote it meanwhile.
+// Neither side ever blocks the other.
+
+struct SnapshotSlot {
+    std::atomic<uint32_t> sequence;     // odd while being written
+    PlantSnapshot plant;
+};
+
+static SnapshotSlot* slots = nullptr;
+
+// Called by the control loop only
+void publishPlantSnapshot(int plantIndex) {
+    if (!slots || plantIndex < 0 || plantIndex >= numPumps) return;
+    const Plant& plant = plants[plantIndex];
+    SnapshotSlot& slot = slots[plantIndex];
+
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    PlantSnapshot& s = slot.plant;
+    memcpy(s.name, plant.name, sizeof(s.name));
+    s.name[sizeof(s.name) - 1] = '\0';
+    s.ozPerWatering = plant.ozPerWatering;
+    s.intervalMinutes = plant.intervalMinutes;
+    s.needsWatering = zones.needsWatering[plantIndex];
+    s.pumpRunning = zones.running[plantIndex];
+    s.waitingSince = zones.waitingSince[plantIndex];
+    for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
+        int historyIndex = (plant.currentHistoryIndex - 1 - j + 2 * WATERING_HISTORY_SIZE) % WATERING_HISTORY_SIZE;
+        s.history[j] = plant.wateringHistory[historyIndex];
+    }
+    s.rollup = plant.rollup;
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void snapshotsBegin() {
+    if (!slots) {
+        slots = new SnapshotSlot[numPumps];
+        for (int i = 0; i < numPumps; i++) slots[i].sequence = 0;
+    }
+    for (int i = 0; i < numPumps; i++) publishPlantSnapshot(i);
+}
+
+// Copies plant i's latest snapshot; safe from any task
+bool readPlantSnapshot(int plantIndex, PlantSnapshot& out) {
+    if (!slots || plantIndex < 0 || plantIndex >= numPumps) return false;
+    const SnapshotSlot& slot = slots[plantIndex];
+    for (;;) {
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;   // mid-write; the writer finishes in microseconds
+        memcpy(&out, &slot.plant, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+}
@@ -1,72 +1,190 @@
 // storage.cpp
 #include "water_my_plants.h"
+#include <limits.h>
 
 // Define a magic number to verify EEPROM data validity
-#define EEPROM_MAGIC_NUMBER 0xABCD1234
+#define EEPROM_MAGIC_NUMBER 0xABCD1235
+// Records written before usage rollups were added: the same fields
+// without the rollup. Loaded once, then rewritten in the current layout.
+#define EEPROM_MAGIC_NUMBER_V1 0xABCD1234
+#define SIZE_PER_PLANT_V1 (SIZE_PER_PLANT - (int)sizeof(PlantRollup))
+
+// Plants changed since the last commit; set from any task
+static std::atomic<bool>* dirtyPlants = nullptr;
+static std::atomic<bool> anyDirty(false);
+static std::atomic<unsigned long> firstDirtyMillis(0);
+// Set by requestCommit() to skip the rest of the commit window
+static std::atomic<bool> commitRequested(false);
+// Whether the EEPROM image holds a full set of records behind the magic
+// number; until it does, the first commit writes every plant
+static bool imageValid = false;
+
+// Offset of plant i's record; records are recordSize bytes apart
+static int plantRecordAddr(int plantIndex, int recordSize = SIZE_PER_PLANT) {
+    return sizeof(uint32_t) + plantIndex * recordSize;
+}
 
-void saveWateringTimes() {
-    int addr = 0;
+// Plant i as of its latest snapshot, so the service task can write it
+// while the control task goes on changing plants[]. Before snapshots are
+// set up, at boot, plants[] is read directly.
+static void readPlantForCommit(int plantIndex, PlantSnapshot& out) {
+    if (readPlantSnapshot(plantIndex, out)) return;
+    const Plant& plant = plants[plantIndex];
+    memcpy(out.name, plant.name, sizeof(out.name));
+    out.ozPerWatering = plant.ozPerWatering;
+    out.intervalMinutes = plant.intervalMinutes;
+    out.needsWatering = zones.needsWatering[plantIndex];
+    for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
+        int historyIndex = (plant.currentHistoryIndex - 1 - j + 2 * WATERING_HISTORY_SIZE) % WATERING_HISTORY_SIZE;
+        out.history[j] = plant.wateringHistory[historyIndex];
+    }
+    out.rollup = plant.rollup;
+}
 
-    // Write magic number
-    uint32_t magicNumber = EEPROM_MAGIC_NUMBER;
-    EEPROM.put(addr, magicNumber);
-    addr += sizeof(uint32_t);
+// EEPROM.commit(), timed and counted for /metrics and the flight recorder
+static bool commitEeprom() {
+    int64_t start = esp_timer_get_time();
+    bool ok = EEPROM.commit();
+    int64_t micros = esp_timer_get_time() - start;
+    metricsObserve(HISTOGRAM_EEPROM_COMMIT, micros);
+    traceRecord(TRACE_EEPROM_COMMIT, 0, ok, (uint32_t)micros);
+    if (!ok) metricsCount(COUNTER_EEPROM_COMMIT_FAILURES);
+    return ok;
+}
 
-    for (int i = 0; i < NUM_PUMPS; i++) {
-        // Save name[32]
-        EEPROM.put(addr, plants[i].name);
-        addr += 32;
+// Copies one plant into the EEPROM image (RAM only, no commit). History
+// is stored oldest first from slot 0, so the next watering goes to slot 0.
+static void writePlantRecord(int plantIndex) {
+    PlantSnapshot plant;
+    readPlantForCommit(plantIndex, plant);
+    int addr = plantRecordAddr(plantIndex);
+
+    // Save name[32]
+    EEPROM.put(addr, plant.name);
+    addr += 32;
+
+    // Save ozPerWatering
+    EEPROM.put(addr, plant.ozPerWatering);
+    addr += sizeof(float);
+
+    // Save intervalMinutes
+    EEPROM.put(addr, plant.intervalMinutes);
+    addr += sizeof(int);
+
+    // Save currentHistoryIndex
+    int currentHistoryIndex = 0;
+    EEPROM.put(addr, currentHistoryIndex);
+    addr += sizeof(int);
 
-        // Save ozPerWatering
-        EEPROM.put(addr, plants[i].ozPerWatering);
+    // Save needsWatering
+    EEPROM.put(addr, plant.needsWatering);
+    addr += sizeof(bool);
+
+    // Padding to align to 4 bytes
+    addr += 3;  // Skip 3 bytes for alignment
+
+    // Save wateringHistory
+    for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
+        const WateringEvent& event = plant.history[WATERING_HISTORY_SIZE - 1 - j];
+        EEPROM.put(addr, event.timestamp);
+        addr += sizeof(time_t);
+        EEPROM.put(addr, event.amount);
         addr += sizeof(float);
+    }
 
-        // Save intervalMinutes
-        EEPROM.put(addr, plants[i].intervalMinutes);
-        addr += sizeof(int);
+    // Save rollup
+    EEPROM.put(addr, plant.rollup);
+}
 
-        // Save currentHistoryIndex
-        EEPROM.put(addr, plants[i].currentHistoryIndex);
-        addr += sizeof(int);
+// Writes every plant and commits right away
+void saveWateringTimes() {
+    uint32_t magicNumber = EEPROM_MAGIC_NUMBER;
+    EEPROM.put(0, magicNumber);
+    for (int i = 0; i < numPumps; i++) {
+        if (dirtyPlants) dirtyPlants[i] = false;
+        writePlantRecord(i);
+    }
+    anyDirty = false;
+    imageValid = true;
+    commitEeprom();
+}
 
-        // Save needsWatering
-        EEPROM.put(addr, plants[i].needsWatering);
-        addr += sizeof(bool);
+// Queues plant i for the next commit. Safe from any task: the record is
+// written by the service task, at most EEPROM_COMMIT_WINDOW_MS later.
+void markPlantDirty(int plantIndex) {
+    if (!dirtyPlants || plantIndex < 0 || plantIndex >= numPumps) return;
+    dirtyPlants[plantIndex] = true;
+    if (!anyDirty.exchange(true)) {
+        firstDirtyMillis = millis();
+        wakeServiceTask();
+    }
+}
 
-        // Padding to align to 4 bytes
-        addr += 3;  // Skip 3 bytes for alignment
+// Has the service task commit the dirty plants on its next pass rather
+// than at the end of the window; used once a watering finishes
+void requestCommit() {
+    commitRequested = true;
+    wakeServiceTask();
+}
 
-        // Save wateringHistory
-        for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
-            EEPROM.put(addr, plants[i].wateringHistory[j].timestamp);
-            addr += sizeof(time_t);
-            EEPROM.put(addr, plants[i].wateringHistory[j].amount);
-            addr += sizeof(float);
-        }
+// Writes the dirty records and commits them in one flash write, once the
+// oldest change is EEPROM_COMMIT_WINDOW_MS old, or right away with force
+// or after requestCommit(). Returns how long the service task may sleep
+// before calling it again.
+unsigned long commitDirtyPlants(bool force) {
+    if (commitRequested.exchange(false)) force = true;
+    if (!anyDirty) return ULONG_MAX;
+    unsigned long age = millis() - firstDirtyMillis;
+    if (!force && age < EEPROM_COMMIT_WINDOW_MS) return EEPROM_COMMIT_WINDOW_MS - age;
+
+    // Cleared before the records are read, so a change made meanwhile is
+    // picked up by the next commit rather than lost
+    anyDirty = false;
+    if (!imageValid) {
+        saveWateringTimes();
+        return ULONG_MAX;
     }
-    EEPROM.commit();
+    for (int i = 0; i < numPumps; i++) {
+        if (dirtyPlants[i].exchange(false)) writePlantRecord(i);
+    }
+    if (!commitEeprom()) LOG_ERROR("EEPROM commit failed");
+    return ULONG_MAX;
 }
 
 void loadWateringTimes() {
-    int addr = 0;
-    time_t currentTime;
-    time(&currentTime);
+    if (!dirtyPlants) {
+        dirtyPlants = new std::atomic<bool>[numPumps];
+        for (int i = 0; i < numPumps; i++) dirtyPlants[i] = false;
+    }
+
+    time_t currentTime = time(nullptr);
 
     // Read magic number to verify data validity
-    uint32_t magicNumber;
-    EEPROM.get(addr, magicNumber);
-    addr += sizeof(uint32_t);
+    uint32_t magicNumber = 0;
+    EEPROM.get(0, magicNumber);
 
-    if (magicNumber != EEPROM_MAGIC_NUMBER) {
-        Serial.println("No valid data in EEPROM, using default plant settings");
+    bool legacy = magicNumber == EEPROM_MAGIC_NUMBER_V1;
+    if (magicNumber != EEPROM_MAGIC_NUMBER && !legacy) {
+        LOG_INFO("No valid data in EEPROM, using default plant settings");
+        rebuildRollups();
         return;
     }
+    // A legacy image is rewritten in full by the first commit
+    imageValid = !legacy;
+
+    for (int i = 0; i < numPumps; i++) {
+        int addr = plantRecordAddr(i, legacy ? SIZE_PER_PLANT_V1 : SIZE_PER_PLANT);
 
-    for (int i = 0; i < NUM_PUMPS; i++) {
         // Load name[32]
         char loadedName[32];
         EEPROM.get(addr, loadedName);
         addr += 32;
+        // Past the end of the image before the zone table grew: keep the
+        // defaults and have them written
+        if (loadedName[0] == '\0' || (uint8_t)loadedName[0] == 0xFF) {
+            markPlantDirty(i);
+            continue;
+        }
         strncpy(plants[i].name, loadedName, 32);
 
         // Load ozPerWatering
@@ -82,7 +200,7 @@ void loadWateringTimes() {
         addr += sizeof(int);
 
         // Load needsWatering
-        EEPROM.get(addr, plants[i].needsWatering);
+        EEPROM.get(addr, zones.needsWatering[i]);
         addr += sizeof(bool);
 
         // Padding to align to 4 bytes
@@ -91,15 +209,16 @@ void loadWateringTimes() {
         // Load wateringHistory
         bool validHistory = true;
         for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
-            time_t timestamp;
+            time_t timestamp = 0;
             EEPROM.get(addr, timestamp);
             addr += sizeof(time_t);
             float amount;
             EEPROM.get(addr, amount);
             addr += sizeof(float);
 
-            // Validate the loaded data
-            if (timestamp > currentTime || timestamp < 0 || amount < 0 || amount > 100) {
+            // Validate the loaded data. Before the first NTP sync the clock
+            // only counts seconds since boot, so there's no upper bound yet.
+            if ((timeValid() && timestamp > currentTime) || timestamp < 0 || amount < 0 || amount > MAX_OZ_PER_WATERING) {
                 validHistory = false;
                 break;
             }
@@ -107,6 +226,7 @@ void loadWateringTimes() {
             plants[i].wateringHistory[j].timestamp = timestamp;
             plants[i].wateringHistory[j].amount = amount;
         }
+        addr = plantRecordAddr(i) + SIZE_PER_PLANT_V1;
 
         if (!validHistory) {
             plants[i].currentHistoryIndex = 0;
@@ -115,7 +235,23 @@ void loadWateringTimes() {
                 plants[i].wateringHistory[j].amount = 0;
             }
         }
+
+        // Load rollup
+        if (!legacy) {
+            EEPROM.get(addr, plants[i].rollup);
+            if (!rollupValid(plants[i].rollup)) {
+                LOG_WARN("Discarding inconsistent usage totals for %s", plants[i].name);
+                rollupReset(plants[i].rollup);
+            }
+        }
+    }
+    if (legacy) {
+        LOG_INFO("Upgrading EEPROM records to add usage totals");
+        rebuildRollups();
+        for (int i = 0; i < numPumps; i++) markPlantDirty(i);
     }
+    markStateChanged();
+    rescheduleAllPlants();
 }
 
 void resetEEPROM() {
@@ -127,7 +263,7 @@ void resetEEPROM() {
     addr += sizeof(uint32_t);
 
     // Clear plant data
-    for (int i = 0; i < NUM_PUMPS; i++) {
+    for (int i = 0; i < numPumps; i++) {
         // Clear name
         char emptyName[32] = {0};
         EEPROM.put(addr, emptyName);
@@ -164,61 +300,36 @@ void resetEEPROM() {
             EEPROM.put(addr, zeroFloat);
             addr += sizeof(float);
         }
+
+        // Zero rollup
+        PlantRollup emptyRollup = {};
+        EEPROM.put(addr, emptyRollup);
+        addr += sizeof(PlantRollup);
     }
-    if (EEPROM.commit()) {
-        Serial.println("EEPROM successfully reset");
+    imageValid = false;
+    if (commitEeprom()) {
+        LOG_INFO("EEPROM successfully reset");
     } else {
-        Serial.println("EEPROM reset failed");
+        LOG_ERROR("EEPROM reset failed");
     }
 }
 
 void resetPlantHistory(int plantIndex) {
-    if (plantIndex < 0 || plantIndex >= NUM_PUMPS) {
-        Serial.println("Invalid plant index");
+    if (plantIndex < 0 || plantIndex >= numPumps) {
+        LOG_WARN("Invalid plant index");
         return;
     }
 
-    // Calculate the starting address of the plant's data in EEPROM
-    int addr = sizeof(uint32_t) + plantIndex * SIZE_PER_PLANT;
-
-    // Skip to currentHistoryIndex
-    addr += 32 + sizeof(float) + sizeof(int);  // Skip name, ozPerWatering, intervalMinutes
-
-    // Reset currentHistoryIndex
-    int zeroInt = 0;
-    EEPROM.put(addr, zeroInt);
-    addr += sizeof(int);
-
-    // Reset needsWatering
-    bool falseBool = false;
-    EEPROM.put(addr, falseBool);
-    addr += sizeof(bool);
-
-    // Skip padding
-    addr += 3;
-
-    // Reset wateringHistory
-    for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
-        time_t zeroTime = 0;
-        EEPROM.put(addr, zeroTime);
-        addr += sizeof(time_t);
-
-        float zeroAmount = 0.0;
-        EEPROM.put(addr, zeroAmount);
-        addr += sizeof(float);
-    }
-
-    // Update the plant structure in RAM
     plants[plantIndex].currentHistoryIndex = 0;
-    plants[plantIndex].needsWatering = false;
+    if (zones.needsWatering[plantIndex]) traceRecord(TRACE_NEEDS_WATERING, plantIndex, 0, 0);
+    zones.needsWatering[plantIndex] = false;
     for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
         plants[plantIndex].wateringHistory[j].timestamp = 0;
         plants[plantIndex].wateringHistory[j].amount = 0;
     }
+    rollupReset(plants[plantIndex].rollup);
 
-    if (EEPROM.commit()) {
-        Serial.printf("Successfully reset watering history for %s\n", plants[plantIndex].name);
-    } else {
-        Serial.printf("Failed to reset watering history for %s\n", plants[plantIndex].name);
-    }
+    markPlantChanged(plantIndex);
+    markPlantDirty(plantIndex);
+    LOG_INFO("Reset watering history for %s", plants[plantIndex].name);
 }
@@ -0,0 +1,58 @@
+// tasks.cpp
+#include "water_my_plants.h"
+
+// Watering control runs in its own task on APP_CPU, above AsyncTCP, so
+// pump starts don't wait behind web requests. Wi-Fi/NTP upkeep, EEPROM
+// commits and journal writes, which can block on the radio or on flash,
+// run in a low-priority service task on PRO_CPU next to the Wi-Fi stack.
+
+#define CONTROL_TASK_STACK 6144     // bytes
+#define CONTROL_TASK_PRIORITY 5     // AsyncTCP runs at 3
+#define SERVICE_TASK_STACK 8192
+#define SERVICE_TASK_PRIORITY 2
+
+static TaskHandle_t controlTask = nullptr;
+static TaskHandle_t serviceTask = nullptr;
+
+bool startTasks(TaskFunction_t controlLoop, TaskFunction_t serviceLoop) {
+    if (xTaskCreatePinnedToCore(controlLoop, "control", CONTROL_TASK_STACK, nullptr, CONTROL_TASK_PRIORITY,
+                                &controlTask, APP_CPU_NUM) != pdPASS) {
+        return false;
+    }
+    return xTaskCreatePinnedToCore(serviceLoop, "service", SERVICE_TASK_STACK, nullptr, SERVICE_TASK_PRIORITY,
+                                   &serviceTask, PRO_CPU_NUM) == pdPASS;
+}
+
+// Ends the control task's current waitForWork() early, e.g. on a command
+void wakeControlTask() {
+    if (controlTask) xTaskNotifyGive(controlTask);
+}
+
+// Same for the service task, e.g. on a network event or a dirty plant
+void wakeServiceTask() {
+    if (serviceTask) xTaskNotifyGive(serviceTask);
+}
+
+// Blocks the calling task for up to maxMillis, or until it is woken
+void waitForWork(unsigned long maxMillis) {
+    if (maxMillis == 0) return;
+    TickType_t ticks = pdMS_TO_TICKS(min(maxMillis, (unsigned long)(portMAX_DELAY / 2)));
+    ulTaskNotifyTake(pdTRUE, ticks);
+}
+
+// Logs how close each task has come to overflowing its stack
+void reportTaskStacks() {
+    if (!controlTask || !serviceTask) return;
+    LOG_INFO("Stack never used: control %u B, service %u B, %s %u B",
+             (unsigned)uxTaskGetStackHighWaterMark(controlTask),
+             (unsigned)uxTaskGetStackHighWaterMark(serviceTask),
+             pcTaskGetName(nullptr), (unsigned)uxTaskGetStackHighWaterMark(nullptr));
+}
+
+UBaseType_t controlTaskStackFree() {
+    return controlTask ? uxTaskGetStackHighWaterMark(controlTask) : 0;
+}
+
+UBaseType_t serviceTaskStackFree() {
+    return serviceTask ? uxTaskGetStackHighWaterMark(serviceTask) : 0;
+}
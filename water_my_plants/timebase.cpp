@@ -0,0 +1,100 @@
+// timebase.cpp
+#include "water_my_plants.h"
+#include <esp_sntp.h>
+#include <esp_timer.h>
+
+// Syncs closer together than this are too short to measure drift on
+#define DRIFT_MIN_INTERVAL_US (10LL * 60 * 1000000)
+// A sync further off than this is a clock step, not drift
+#define DRIFT_MAX_STEP_US (2LL * 1000000)
+// Crystal drift beyond this is a measurement error
+#define DRIFT_MAX_PPB 500000
+
+// UTC at one esp_timer reading, and how fast esp_timer runs against UTC
+// (positive is fast)
+struct TimeAnchor {
+    int64_t utcMicros;
+    int64_t timerMicros;
+    int32_t driftPpb;
+};
+
+// Written only from the SNTP callback into the slot readers aren't using;
+// syncs are far enough apart that a reader never sees a slot rewritten
+static TimeAnchor anchors[2];
+static std::atomic<int> currentAnchor(-1);
+static std::atomic<uint32_t> syncCount(0);
+static std::atomic<int32_t> lastSyncErrorMicros(0);
+
+static int64_t utcMicrosAt(const TimeAnchor& a, int64_t timerMicros) {
+    int64_t elapsed = timerMicros - a.timerMicros;
+    return a.utcMicros + elapsed - elapsed * a.driftPpb / 1000000000;
+}
+
+static void onTimeSync(struct timeval* tv) {
+    int64_t timerMicros = esp_timer_get_time();
+    TimeAnchor next;
+    next.utcMicros = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+    next.timerMicros = timerMicros;
+    next.driftPpb = 0;
+
+    int slot = currentAnchor.load();
+    if (slot >= 0) {
+        // What we would have said now vs. what NTP says: the remaining rate
+        // error since the last sync, folded into the estimate
+        const TimeAnchor& prev = anchors[slot];
+        int64_t error = next.utcMicros - utcMicrosAt(prev, timerMicros);
+        int64_t elapsed = timerMicros - prev.timerMicros;
+        lastSyncErrorMicros = (int32_t)constrain(error, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+        if (llabs(error) > DRIFT_MAX_STEP_US) {
+            next.driftPpb = 0;
+        } else if (elapsed < DRIFT_MIN_INTERVAL_US) {
+            next.driftPpb = prev.driftPpb;
+        } else {
+            int64_t measured = -error * 1000000000 / elapsed;
+            // First measurement taken as is, later ones averaged in
+            int64_t ppb = prev.driftPpb == 0 ? measured : prev.driftPpb + measured / 4;
+            next.driftPpb = (int32_t)constrain(ppb, (int64_t)-DRIFT_MAX_PPB, (int64_t)DRIFT_MAX_PPB);
+        }
+    }
+
+    anchors[slot < 0 ? 0 : 1 - slot] = next;
+    currentAnchor = slot < 0 ? 0 : 1 - slot;
+    syncCount.fetch_add(1);
+    metricsTimeSynced();
+    traceRecord(TRACE_TIME_SYNC, (uint16_t)(tv->tv_usec / 1000), 0, (uint32_t)tv->tv_sec);
+    // Plants could not be scheduled until now
+    if (slot < 0) rescheduleAllPlants();
+}
+
+void timeBaseBegin() {
+    sntp_set_time_sync_notification_cb(onTimeSync);
+}
+
+bool timeValid() {
+    return currentAnchor.load() >= 0;
+}
+
+// UTC in microseconds; 0 before the first sync
+int64_t timeNowMicros() {
+    int slot = currentAnchor.load();
+    if (slot < 0) return 0;
+    return utcMicrosAt(anchors[slot], esp_timer_get_time());
+}
+
+time_t timeNow() {
+    return (time_t)(timeNowMicros() / 1000000);
+}
+
+uint32_t timeSyncCount() {
+    return syncCount.load();
+}
+
+int32_t timeDriftPpb() {
+    int slot = currentAnchor.load();
+    return slot < 0 ? 0 : anchors[slot].driftPpb;
+}
+
+// How far off the time base was when the last sync corrected it
+int32_t timeLastSyncErrorMicros() {
+    return lastSyncErrorMicros.load();
+}
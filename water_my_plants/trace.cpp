@@ -0,0 +1,178 @@
+// trace.cpp
+#include "water_my_plants.h"
+#include <esp_attr.h>
+#include <esp_system.h>
+
+// Flight recorder: the last TRACE_EVENTS control events in a ring that a
+// soft reset (panic, watchdog, ESP.restart()) leaves alone, so after an
+// overwatering or a crash GET /api/trace still shows what led up to it.
+// client/wmp_trace.cpp turns a download into a timeline.
+//
+// Recording claims a position with one atomic add and fills a 16-byte
+// slot. Each slot's check word is invalidated first and set to match the
+// position last, so a reader or the next boot can tell a finished event
+// from one that was cut short or overwritten while being read.
+//
+// GET /api/trace, all little-endian:
+//
+//   header, 32 bytes
+//     0   "WMPT"
+//     4   u16   format version, 1
+//     6   u16   event size, 16
+//     8   u32   boot count (1 on the first boot after power-on)
+//     12  u32   position of the oldest event kept
+//     16  i64   esp_timer time now, us since this boot
+//     24  u32   UTC seconds now, 0 if not synced
+//     28  u16   milliseconds of that
+//     30  u16   0
+//
+//   then oldest first, one per event still intact:
+//     0   u32   esp_timer time, low 32 bits (us since that event's boot)
+//     4   u16   esp_timer time, high 16 bits
+//     6   u8    TraceType
+//     7   u8    detail
+//     8   u16   subject
+//     10  u16   position, low 16 bits; a jump means events were lost
+//     12  u32   arg
+//
+// Times restart at 0 on each boot, which TRACE_BOOT marks. TRACE_TIME_SYNC
+// pairs a boot's esp_timer time with UTC.
+
+#define TRACE_FORMAT_VERSION 1
+#define TRACE_MAGIC 0x54504d57      // "WMPT"
+
+#ifdef TRACE_IN_RTC_MEMORY
+#define TRACE_STORAGE RTC_NOINIT_ATTR
+#else
+#define TRACE_STORAGE __NOINIT_ATTR
+#endif
+
+static_assert((TRACE_EVENTS & (TRACE_EVENTS - 1)) == 0, "TRACE_EVENTS must be a power of two");
+
+struct TraceSlot {
+    uint32_t microsLow;
+    uint16_t microsHigh;
+    uint8_t type;
+    uint8_t detail;
+    uint16_t subject;
+    std::atomic<uint16_t> check;
+    uint32_t arg;
+};
+static_assert(sizeof(TraceSlot) == TRACE_EVENT_SIZE, "trace events are 16 bytes");
+
+// Not initialized at boot: traceBegin() keeps whatever a valid magic
+// number vouches for
+struct TraceRing {
+    uint32_t magic;
+    uint32_t magicComplement;
+    uint32_t bootCount;
+    std::atomic<uint32_t> head;         // next position to record
+    TraceSlot slots[TRACE_EVENTS];
+};
+
+static TRACE_STORAGE TraceRing recorder;
+
+// What a slot's check word holds once the event at position is complete.
+// The invalid marker, its complement, can't match any position sharing
+// the slot, since those agree in their low bits.
+static uint16_t traceCheck(uint32_t position) {
+    return (uint16_t)position ^ 0xA55A;
+}
+
+// Keeps the events from before a soft reset, or starts empty after power-on
+void traceBegin() {
+    if (recorder.magic != TRACE_MAGIC || recorder.magicComplement != ~(uint32_t)TRACE_MAGIC) {
+        recorder.bootCount = 0;
+        recorder.head.store(0);
+        for (uint32_t i = 0; i < TRACE_EVENTS; i++) recorder.slots[i].check.store((uint16_t)~traceCheck(i));
+        recorder.magic = TRACE_MAGIC;
+        recorder.magicComplement = ~(uint32_t)TRACE_MAGIC;
+    }
+    recorder.bootCount++;
+    traceRecord(TRACE_BOOT, 0, (uint8_t)esp_reset_reason(), recorder.bootCount);
+}
+
+void traceRecord(TraceType type, uint16_t subject, uint8_t detail, uint32_t arg) {
+    uint64_t micros = (uint64_t)esp_timer_get_time();
+    uint32_t position = recorder.head.fetch_add(1, std::memory_order_relaxed);
+    TraceSlot& slot = recorder.slots[position & (TRACE_EVENTS - 1)];
+    slot.check.store((uint16_t)~traceCheck(position), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.microsLow = (uint32_t)micros;
+    slot.microsHigh = (uint16_t)(micros >> 32);
+    slot.type = type;
+    slot.detail = detail;
+    slot.subject = subject;
+    slot.arg = arg;
+    slot.check.store(traceCheck(position), std::memory_order_release);
+}
+
+uint32_t traceBootCount() {
+    return recorder.bootCount;
+}
+
+static void putLe16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void putLe32(uint8_t* out, uint32_t value) {
+    putLe16(out, (uint16_t)value);
+    putLe16(out + 2, (uint16_t)(value >> 16));
+}
+
+// Starts a download at the oldest event kept; events recorded after this
+// aren't included
+void traceCursorBegin(TraceCursor& cursor) {
+    cursor.end = recorder.head.load(std::memory_order_acquire);
+    cursor.next = cursor.end >= TRACE_EVENTS ? cursor.end - TRACE_EVENTS : 0;
+
+    uint8_t* out = cursor.record;
+    memset(out, 0, TRACE_HEADER_SIZE);
+    memcpy(out, "WMPT", 4);
+    putLe16(out + 4, TRACE_FORMAT_VERSION);
+    putLe16(out + 6, TRACE_EVENT_SIZE);
+    putLe32(out + 8, recorder.bootCount);
+    putLe32(out + 12, cursor.next);
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    putLe32(out + 16, (uint32_t)now);
+    putLe32(out + 20, (uint32_t)(now >> 32));
+    int64_t utcMicros = timeNowMicros();
+    putLe32(out + 24, (uint32_t)(utcMicros / 1000000));
+    putLe16(out + 28, (uint16_t)(utcMicros % 1000000 / 1000));
+    cursor.offset = 0;
+    cursor.length = TRACE_HEADER_SIZE;
+}
+
+// Copies the event at position into out if it is intact; false if it was
+// cut short, or is being overwritten by a newer one
+static bool readEvent(uint32_t position, uint8_t* out) {
+    const TraceSlot& slot = recorder.slots[position & (TRACE_EVENTS - 1)];
+    uint16_t before = slot.check.load(std::memory_order_acquire);
+    putLe32(out, slot.microsLow);
+    putLe16(out + 4, slot.microsHigh);
+    out[6] = slot.type;
+    out[7] = slot.detail;
+    putLe16(out + 8, slot.subject);
+    putLe16(out + 10, (uint16_t)position);
+    putLe32(out + 12, slot.arg);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return before == traceCheck(position) && slot.check.load(std::memory_order_relaxed) == before;
+}
+
+size_t fillTrace(TraceCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.offset == cursor.length) {
+            if (cursor.next == cursor.end) break;
+            cursor.offset = 0;
+            cursor.length = readEvent(cursor.next++, cursor.record) ? TRACE_EVENT_SIZE : 0;
+            continue;
+        }
+        size_t n = min(cursor.length - cursor.offset, maxLen - written);
+        memcpy(buffer + written, cursor.record + cursor.offset, n);
+        cursor.offset += n;
+        written += n;
+    }
+    return written;
+}
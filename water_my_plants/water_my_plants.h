@@ -3,17 +3,42 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <time.h>
+#include <esp_timer.h>
 #include <EEPROM.h>
+#include <Wire.h>
 #include "ESPAsyncWebServer.h"
 #include "SPIFFS.h"
 #include <ArduinoJson.h>
 #include <AsyncJson.h>
+#include <atomic>
+#include <initializer_list>
+#include <type_traits>
 
 
 // Constants
 #define WATERING_HISTORY_SIZE 5
 #define OZ_PER_MINUTE (12.0 / 4.0)
 #define MILLIS_PER_OZ ((4L * 60L * 1000L) / 12L)
+// Largest dose a plant can be set to, a little over half an hour of
+// pumping; recorded doses above it are treated as corrupt
+#define MAX_OZ_PER_WATERING 100
+
+// Pumps that may run at once, in units of a standard pump (see
+// Pump::weight). Due plants beyond that wait their turn, longest overdue
+// first, and starts are spaced PUMP_START_STAGGER_MS apart so inrush
+// currents don't overlap.
+#ifndef MAX_CONCURRENT_PUMPS
+#define MAX_CONCURRENT_PUMPS 2
+#endif
+#ifndef PUMP_START_STAGGER_MS
+#define PUMP_START_STAGGER_MS 500
+#endif
+
+// Settings changes are written to flash together once the oldest is this
+// old; a finished watering is committed right away
+#ifndef EEPROM_COMMIT_WINDOW_MS
+#define EEPROM_COMMIT_WINDOW_MS 30000
+#endif
 
 // Structures
 struct WateringEvent {
@@ -21,13 +46,334 @@ struct WateringEvent {
     float amount;
 };
 
+// Rolling usage windows kept per plant: the last 24 h in hourly slots,
+// the last 7 and 30 days in daily slots
+#define ROLLUP_HOURS 24
+#define ROLLUP_DAYS 30
+
+// Waterings and hundredths of an ounce in one hour or day
+struct RollupSlot {
+    uint16_t waterings;
+    uint16_t centiOz;
+};
+
+// Usage totals of one plant, kept current as each watering completes and
+// stored with the plant record. The window sums are as of the newest slot;
+// rollupWindow() drops whatever has aged out since.
+struct PlantRollup {
+    uint32_t hour;              // UTC hour of hourSlots' newest slot
+    uint32_t day;               // UTC day of daySlots' newest slot
+    RollupSlot hourSlots[ROLLUP_HOURS];
+    RollupSlot daySlots[ROLLUP_DAYS];
+    uint32_t dayWaterings;      // last 24 h
+    uint32_t dayCentiOz;
+    uint32_t weekWaterings;     // last 7 days
+    uint32_t weekCentiOz;
+    uint32_t monthWaterings;    // last 30 days
+    uint32_t monthCentiOz;
+    uint32_t lifetimeWaterings;
+    uint32_t lifetimeCentiOz;
+    uint32_t firstWatered;      // UTC seconds, 0 if never
+};
+
+enum RollupWindow {
+    ROLLUP_24H,
+    ROLLUP_7D,
+    ROLLUP_30D,
+    ROLLUP_LIFETIME
+};
+
+struct UsageTotals {
+    uint32_t waterings;
+    float oz;
+    uint32_t meanIntervalMinutes;   // time covered per watering; 0 if none
+};
+
 struct Plant {
     char name[32];  // Fixed size array instead of const char*
     float ozPerWatering;     
     int intervalMinutes;     
     WateringEvent wateringHistory[WATERING_HISTORY_SIZE];
     int currentHistoryIndex;  
-    bool needsWatering;      
+    PlantRollup rollup;
+};
+
+// Largest single /api/plants record (separators included) or /api/events payload
+#define PLANT_JSON_RECORD_MAX 1024
+
+// Resumable position in the /api/plants body; zero-initialize to start
+struct PlantJsonCursor {
+    int next;
+    size_t offset;
+    size_t length;
+    char record[PLANT_JSON_RECORD_MAX];
+};
+
+// Layout version of the CBOR /api/plants body (see plant_cbor.cpp), and
+// the largest single record in it, envelope included
+#define PLANT_CBOR_SCHEMA 1
+#define PLANT_CBOR_RECORD_MAX 256
+
+// Resumable position in the CBOR /api/plants body; zero-initialize to start
+struct PlantCborCursor {
+    int next;
+    size_t offset;
+    size_t length;
+    uint8_t record[PLANT_CBOR_RECORD_MAX];
+};
+
+// Latency histograms and counters behind GET /metrics (see metrics.cpp)
+#define HISTOGRAM_BUCKETS 20
+#define METRICS_MAX_ROUTES 24
+#define METRICS_RECORD_MAX 3072
+
+enum MetricHistogram {
+    HISTOGRAM_CONTROL_PASS,     // one pass of the control loop
+    HISTOGRAM_SERVICE_PASS,     // one pass of the service loop
+    HISTOGRAM_EEPROM_COMMIT,
+    HISTOGRAM_NTP_SYNC,         // SNTP start to first sync
+    HISTOGRAM_DOSE_ERROR,       // |measured - intended| pump on-time
+    HISTOGRAM_COUNT
+};
+
+enum MetricCounter {
+    COUNTER_WIFI_CONNECTS,
+    COUNTER_WIFI_DISCONNECTS,
+    COUNTER_WIFI_CONNECT_FAILURES,
+    COUNTER_NTP_RESTARTS,
+    COUNTER_EEPROM_COMMIT_FAILURES,
+    COUNTER_COUNT
+};
+
+// Resumable position in the /metrics body; zero-initialize to start
+struct MetricsCursor {
+    int family;
+    int item;
+    size_t offset;
+    size_t length;
+    char record[METRICS_RECORD_MAX];
+};
+
+// Flight recorder events, kept across soft resets and served binary at
+// GET /api/trace (layout in trace.cpp). The numbers are part of that
+// format: only ever append.
+enum TraceType : uint8_t {
+    TRACE_BOOT = 1,             // detail: esp_reset_reason(), arg: boot count
+    TRACE_PUMP_ON = 2,          // subject: pump index, arg: run duration, ms
+    TRACE_PUMP_OFF = 3,         // subject: pump index
+    TRACE_NEEDS_WATERING = 4,   // subject: plant, detail: new value, arg: WateringSource if set
+    TRACE_WATERED = 5,          // subject: plant, detail: WateringSource, arg: run duration, ms
+    TRACE_EEPROM_COMMIT = 6,    // detail: 1 if it succeeded, arg: duration, us
+    TRACE_WIFI = 7,             // detail: TraceWifi, arg: RSSI (signed) once connected
+    TRACE_NTP_START = 8,        // detail: 1 if restarted after going quiet
+    TRACE_TIME_SYNC = 9,        // subject: milliseconds, arg: UTC seconds
+    TRACE_COMMAND_QUEUED = 10,  // subject: plant (a batch: its size), detail: CommandType, arg: id
+    TRACE_COMMAND_APPLIED = 11  // as queued
+};
+
+enum TraceWifi : uint8_t {
+    TRACE_WIFI_CONNECTED,
+    TRACE_WIFI_DISCONNECTED,
+    TRACE_WIFI_CONNECT_FAILED,
+    TRACE_WIFI_TIMED_OUT
+};
+
+// Events kept; a power of two. 16 bytes each in RAM that a soft reset
+// leaves alone, or in RTC memory with TRACE_IN_RTC_MEMORY, where 8 KB is
+// all there is: 256 at most there.
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS 512
+#endif
+#define TRACE_HEADER_SIZE 32
+#define TRACE_EVENT_SIZE 16
+
+// Resumable position in the /api/trace body; set up with traceCursorBegin()
+struct TraceCursor {
+    uint32_t next;
+    uint32_t end;
+    size_t offset;
+    size_t length;
+    uint8_t record[TRACE_HEADER_SIZE];
+};
+
+// Why a pump ran
+enum WateringSource : uint8_t {
+    WATERING_SCHEDULED = 0,
+    WATERING_MANUAL = 1     // POST /api/plants/water-now
+};
+
+// One completed watering in the journal, as stored on flash
+struct JournalRecord {
+    uint32_t timestamp;     // UTC seconds when the pump stopped
+    uint16_t plant;
+    uint8_t source;         // WateringSource
+    uint8_t crc;            // CRC-8 of the record with this byte zeroed
+    float amount;           // oz
+    uint32_t durationMs;
+};
+
+// Position in the journal; default-construct, then journalSeek()
+struct JournalReader {
+    uint32_t segment = 0;
+    uint32_t record = 0;
+    uint32_t end = 0;
+    File file;
+};
+
+// Consistent copy of one plant as readers outside the control loop see it
+struct PlantSnapshot {
+    char name[32];
+    float ozPerWatering;
+    int intervalMinutes;
+    bool needsWatering;
+    bool pumpRunning;
+    time_t waitingSince;                            // 0 unless queued to start
+    WateringEvent history[WATERING_HISTORY_SIZE];   // newest first
+    PlantRollup rollup;
+};
+
+// Summing mode of GET /api/plants/{i}/history
+enum HistoryBucket : uint8_t {
+    HISTORY_BUCKET_NONE = 0,    // every watering
+    HISTORY_BUCKET_DAY = 1,     // totals per local calendar day
+    HISTORY_BUCKET_WEEK = 2     // totals per local week, starting Monday
+};
+
+// Largest single history record or bucket, separators and closing included
+#define HISTORY_JSON_RECORD_MAX 192
+
+// Resumable state of one /api/plants/{i}/history body. Fixed size however
+// wide the range: records are read one at a time and buckets summed as
+// they pass. Set up with historyBegin().
+struct HistoryCursor {
+    int plant = 0;
+    uint32_t to = 0;
+    uint32_t limit = 0;         // records, or buckets
+    uint32_t emitted = 0;
+    uint8_t bucket = HISTORY_BUCKET_NONE;
+    bool started = false;
+    bool done = false;
+    JournalReader reader;
+
+    // Bucket being summed
+    uint32_t bucketStart = 0;
+    uint32_t bucketEnd = 0;
+    uint32_t bucketCount = 0;
+    float bucketAmount = 0;
+    uint32_t bucketDurationMs = 0;
+
+    size_t offset = 0;
+    size_t length = 0;
+    char record[HISTORY_JSON_RECORD_MAX];
+};
+
+// Changes requested over HTTP, applied by the control loop
+enum CommandType : uint8_t {
+    COMMAND_WATER_NOW,
+    COMMAND_SET_AMOUNT,
+    COMMAND_SET_INTERVAL,
+    COMMAND_SET_NAME,
+    COMMAND_BATCH
+};
+
+// Fields set in a PlantUpdate
+enum PlantUpdateField : uint8_t {
+    UPDATE_NAME = 1,
+    UPDATE_AMOUNT = 2,
+    UPDATE_INTERVAL = 4,
+    UPDATE_WATER_NOW = 8
+};
+
+// Most entries in one PUT /api/plants/batch; a client with more plants
+// to change splits them over several
+#define BATCH_MAX_UPDATES 32
+
+// One plant's part of a PUT /api/plants/batch, already validated
+struct PlantUpdate {
+    uint16_t plant;
+    uint8_t fields;                 // PlantUpdateField bits
+    float amount;                   // oz
+    int intervalMinutes;
+    char name[32];
+};
+
+struct Command {
+    uint32_t id;                    // assigned by enqueueCommand()
+    uint8_t type;                   // CommandType
+    uint16_t plant;
+    union {
+        float amount;               // COMMAND_SET_AMOUNT, oz
+        int intervalMinutes;        // COMMAND_SET_INTERVAL
+        char name[32];              // COMMAND_SET_NAME
+        struct {
+            PlantUpdate* updates;   // from claimBatchUpdates(); released once applied
+            uint16_t count;
+        } batch;                    // COMMAND_BATCH
+    };
+};
+
+enum CommandStatus {
+    COMMAND_UNKNOWN,
+    COMMAND_QUEUED,
+    COMMAND_APPLIED
+};
+
+// Pump inputs are GPIO numbers, or EXPANDER_PIN(e, p) for pin p of
+// pumpExpanders[e]: GPA0-7 are 0-7, GPB0-7 are 8-15
+#define EXPANDER_PIN_FLAG 0x1000
+#define EXPANDER_PIN(expander, pin) (EXPANDER_PIN_FLAG | (expander) << 4 | (pin))
+
+// MCP23017 GPIO expander carrying pump inputs
+struct PumpExpander {
+    TwoWire* bus;
+    uint8_t address;    // 0x20-0x27 set by A0-A2
+};
+
+// How a pump is wired, as config.cpp's defaults and /pumps.cfg give it
+struct PumpWiring {
+    int in1;
+    int in2;
+    uint8_t weight;     // share of MAX_CONCURRENT_PUMPS while running; 0 counts as 1
+};
+
+// Settings a plant starts with until they are changed and saved
+struct PlantDefaults {
+    const char* name;
+    float ozPerWatering;
+    int intervalMinutes;
+};
+
+// Zone table on SPIFFS, read once at boot by pumpRegistryBegin(); see
+// registry.cpp for the format. Without it the defaults in config.cpp apply.
+#define PUMP_CONFIG_PATH "/pumps.cfg"
+#define MAX_PUMP_EXPANDERS 16   // eight addresses on each of Wire and Wire1
+
+// What a zone table may take of the device; maxPumps() is the most pumps
+// that fit both. The EEPROM image is one NVS blob, and NVS writes the new
+// copy before erasing the old, so the default 20 KB nvs partition commits
+// about two of its pages; raise this for a board with a bigger one. The
+// heap budget leaves the rest to Wi-Fi, TCP and the web server.
+#ifndef ZONE_EEPROM_BUDGET
+#define ZONE_EEPROM_BUDGET 8000
+#endif
+#ifndef ZONE_HEAP_BUDGET
+#define ZONE_HEAP_BUDGET (64 * 1024)
+#endif
+
+// Outcome of reading a zone table
+struct PumpConfigCheck {
+    int pumps;
+    int expanders;
+    int line;               // of the first problem
+    const char* error;      // nullptr if the table is usable
+};
+
+// Resumable position in the GET /api/config/pumps body; zero-initialize to start
+struct PumpConfigCursor {
+    int next;
+    size_t offset;
+    size_t length;
+    char record[64];
 };
 
 struct Pump {
@@ -35,25 +381,267 @@ struct Pump {
     int in2;
     int number;
     Plant* plant;  
-    bool isRunning;
     unsigned long startTime;
-    unsigned long runDuration;
+    unsigned long runDuration;     // of the current run, set as it starts
+    uint8_t weight;                // share of MAX_CONCURRENT_PUMPS while running; 0 counts as 1
+    esp_timer_handle_t stopTimer;  // created on first use
+    uint8_t source;                // WateringSource of the current run
+    float doseAmount;              // oz the current run dispenses, set as it starts
+    bool waterAgain;               // "water now" arrived mid-run; queued once it stops
+};
+
+// What the control loop looks at for every zone on every pass, kept out
+// of Plant and Pump in arrays indexed like pumps[], so a pass over many
+// zones reads a few dense bytes each rather than whole records with names
+// and history. Due times live the same way, in the scheduler's heap.
+// Written only by the control loop, and at boot.
+struct ZoneState {
+    bool* running;          // the pump is on
+    bool* needsWatering;
+    time_t* waitingSince;   // when it was queued to start, 0 if not queued
+};
+
+// Log levels. Messages above LOG_LEVEL compile out, arguments and all.
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Messages waiting for the log task; posts beyond that are dropped
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS 64
+#endif
+#define LOG_MAX_ARGS 6
+#define LOG_TEXT_MAX 48
+
+// One message as posted: the format literal identifies it, and arguments
+// are kept as raw bits until the log task formats them. Strings are copied
+// into text, since a plant's name may change before the line is printed.
+struct LogRecord {
+    const char* format;
+    uint32_t timestamp;             // UTC seconds, 0 before the first sync
+    uint8_t argCount;
+    uint8_t textUsed;
+    uint64_t args[LOG_MAX_ARGS];    // int64, uint64 or double; offset into text for %s
+    char text[LOG_TEXT_MAX];
 };
 
 // Function declarations
 void setupWiFi();
-bool syncTime();
+unsigned long checkNetwork();
 void checkWateringNeeds();
 void waterPlants();
+unsigned long millisUntilNextWatering();
+int runningPumpWeight();
 void printPlantSchedules();
 void saveWateringTimes();
+void markPlantDirty(int plantIndex);
+unsigned long commitDirtyPlants(bool force);
+void requestCommit();
 void loadWateringTimes();
+void journalBegin();
+bool journalAppend(int plant, time_t timestamp, float amount, uint32_t durationMs, uint8_t source);
+bool journalPost(int plant, time_t timestamp, float amount, uint32_t durationMs, uint8_t source);
+void journalFlush();
+void journalSeek(JournalReader& reader, time_t from);
+bool journalNext(JournalReader& reader, JournalRecord& record);
+size_t journalRecordCount();
+size_t journalSegmentCount();
+void rollupAdd(PlantRollup& rollup, time_t timestamp, float oz);
+void rollupReset(PlantRollup& rollup);
+bool rollupValid(const PlantRollup& rollup);
+time_t rollupAsOf(time_t now);
+UsageTotals rollupWindow(const PlantRollup& rollup, RollupWindow window, time_t now);
+void rebuildRollups();
+void snapshotsBegin();
+void publishPlantSnapshot(int plantIndex);
+bool readPlantSnapshot(int plantIndex, PlantSnapshot& out);
+void commandsBegin();
+PlantUpdate* claimBatchUpdates();
+void releaseBatchUpdates();
+uint32_t enqueueCommand(Command& command);
+void applyCommands();
+CommandStatus commandStatus(uint32_t id, uint32_t& appliedAt);
 void resetEEPROM();
 void resetPlantHistory(int plantIndex);
+
+// Zone registry: sizes plants[], pumps[], zones and the EEPROM image from
+// /pumps.cfg or the defaults, before anything else allocates per pump.
+// False only if even the defaults don't fit.
+bool pumpRegistryBegin();
+int maxPumps();
+PumpConfigCheck checkPumpConfig(const char* path);
+size_t fillPumpConfig(PumpConfigCursor& cursor, uint8_t* buffer, size_t maxLen);
+
+// Pump outputs: pumpOn() and pumpOff() only stage expander pins, and
+// flushPumpOutputs() sends every expander that changed in one write each.
+// Callable from any task.
+bool pumpsBegin();
 void pumpOn(Pump& pump);
 void pumpOff(Pump& pump);
+void flushPumpOutputs();
+
 void setupWebServer();
-String getPlantDataJson();
+void markStateChanged();
+void markPlantChanged(int plantIndex);
+void publishPlantEvent(int plantIndex);
+void sendPlantEvents();
+
+// Time base: UTC from the last NTP sync plus esp_timer time since, corrected
+// for measured drift. Readable from any task; keeps time through NTP outages.
+void timeBaseBegin();
+bool timeValid();
+time_t timeNow();
+int64_t timeNowMicros();
+uint32_t timeSyncCount();
+int32_t timeDriftPpb();
+int32_t timeLastSyncErrorMicros();
+
+// Scheduler: plant due times and stopped pumps for the control task.
+// reschedulePlant() and markPumpStopped() may be called from any task; the
+// rest only from the control task.
+void schedulerBegin();
+void reschedulePlant(int plantIndex);
+void rescheduleAllPlants();
+int takeRescheduledPlant();
+void setPlantDue(int plantIndex, time_t due);
+void clearPlantDue(int plantIndex);
+int takeDuePlant(time_t now, time_t& due);
+void queuePumpStart(int pumpIndex, time_t since);
+void removeWaitingPump(int pumpIndex);
+bool pumpWaiting(int pumpIndex);
+int nextWaitingPump();
+size_t waitingPumpCount();
+void markPumpStopped(int pumpIndex);
+int takeStoppedPump();
+unsigned long millisUntilNextDeadline(time_t now);
+
+// Tasks: watering control pinned to APP_CPU at high priority, network and
+// flash upkeep on PRO_CPU below it. The wake functions may be called from
+// any task; waitForWork() blocks whichever task calls it.
+bool startTasks(TaskFunction_t controlLoop, TaskFunction_t serviceLoop);
+void wakeControlTask();
+void wakeServiceTask();
+void waitForWork(unsigned long maxMillis);
+void reportTaskStacks();
+UBaseType_t controlTaskStackFree();
+UBaseType_t serviceTaskStackFree();
+
+
+// JSON request bodies, collected across TCP segments into pooled buffers.
+// Register routes with onJsonBody() first, then call requestBodyBegin().
+typedef std::function<void(AsyncWebServerRequest* request, JsonDocument& doc)> JsonBodyHandler;
+void onJsonBody(const char* uri, WebRequestMethod method, size_t maxBody, JsonBodyHandler handler);
+void requestBodyBegin();
+size_t requestBodyBuffersFree();
+
+// Deferred logging: LOG_ERROR() etc. only copy the format and arguments
+// into a lock-free ring, from any task; a low-priority log task formats
+// them and writes Serial. One line per message, no trailing newline.
+void logBegin();
+void logPush(const LogRecord& record);
+void logDrain();
+uint32_t logDroppedCount();
+
+inline void logPut(LogRecord& record, const char* value) {
+    size_t room = LOG_TEXT_MAX - record.textUsed;
+    if (room == 0) {
+        record.args[record.argCount++] = LOG_TEXT_MAX - 1;      // the last byte, always '\0'
+        return;
+    }
+    // Copied as it is measured: a separate memcpy of the measured length
+    // reads, as far as GCC can tell, past the end of short literals
+    char* out = record.text + record.textUsed;
+    size_t len = 0;
+    for (; value && len + 1 < room && value[len]; len++) out[len] = value[len];
+    out[len] = '\0';
+    record.args[record.argCount++] = record.textUsed;
+    record.textUsed += len + 1;
+}
+
+inline void logPut(LogRecord& record, double value) {
+    memcpy(&record.args[record.argCount++], &value, sizeof(value));
+}
+
+inline void logPut(LogRecord& record, const void* value) {
+    record.args[record.argCount++] = (uintptr_t)value;
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+logPut(LogRecord& record, T value) {
+    record.args[record.argCount++] = std::is_signed<T>::value ? (uint64_t)(int64_t)value : (uint64_t)value;
+}
+
+template <typename... Args>
+void logPost(const char* format, Args... args) {
+    static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+    LogRecord record;
+    record.format = format;
+    record.timestamp = (uint32_t)timeNow();
+    record.argCount = 0;
+    record.textUsed = 0;
+    record.text[LOG_TEXT_MAX - 1] = '\0';
+    (void)std::initializer_list<int>{(logPut(record, args), 0)...};
+    logPush(record);
+}
+
+// Never called; lets the compiler check the format against the arguments
+inline void logCheckFormat(const char*, ...) __attribute__((format(printf, 1, 2)));
+inline void logCheckFormat(const char*, ...) {}
+
+#define LOG_POST(...) do { if (false) logCheckFormat(__VA_ARGS__); logPost(__VA_ARGS__); } while (0)
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_POST(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) do { if (false) logCheckFormat(__VA_ARGS__); } while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_POST(__VA_ARGS__)
+#else
+#define LOG_WARN(...) do { if (false) logCheckFormat(__VA_ARGS__); } while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_POST(__VA_ARGS__)
+#else
+#define LOG_INFO(...) do { if (false) logCheckFormat(__VA_ARGS__); } while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_POST(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do { if (false) logCheckFormat(__VA_ARGS__); } while (0)
+#endif
+
+// Flight recorder: traceRecord() is lock-free, callable from any task and
+// costs well under a microsecond. traceBegin() before anything records.
+void traceBegin();
+void traceRecord(TraceType type, uint16_t subject, uint8_t detail, uint32_t arg);
+uint32_t traceBootCount();
+void traceCursorBegin(TraceCursor& cursor);
+size_t fillTrace(TraceCursor& cursor, uint8_t* buffer, size_t maxLen);
+
+// Metrics: recording is lock-free and callable from any task. Routes are
+// registered with metricsRoute() while the server is set up.
+void metricsBegin();
+void metricsCount(MetricCounter counter);
+void metricsObserve(MetricHistogram histogram, int64_t micros);
+int metricsRoute(const char* uri, WebRequestMethod method);
+void metricsRequest(int route, int64_t micros);
+void metricsSntpStarted();
+void metricsTimeSynced();
+void metricsPumpStarted(int pumpIndex, int64_t targetMicros);
+void metricsPumpStopped(int pumpIndex);
+size_t fillMetrics(MetricsCursor& cursor, uint8_t* buffer, size_t maxLen);
+
+size_t fillPlantDataJson(PlantJsonCursor& cursor, uint8_t* buffer, size_t maxLen);
+size_t fillPlantDataCbor(PlantCborCursor& cursor, uint8_t* buffer, size_t maxLen);
+void historyBegin(HistoryCursor& cursor, int plant, time_t from, time_t to, uint32_t limit, HistoryBucket bucket);
+bool historyResume(HistoryCursor& cursor, const char* token);
+size_t fillHistoryJson(HistoryCursor& cursor, uint8_t* buffer, size_t maxLen);
 
 // External variable declarations
 extern const char* ssid;
@@ -63,10 +651,22 @@ extern const char* ntpServer1;
 extern const char* ntpServer2;
 extern const long gmtOffset_sec;
 extern const int daylightOffset_sec;
-extern Plant plants[];
-extern Pump pumps[];
-extern const int NUM_PUMPS;
-extern const int EEPROM_SIZE;
+extern const PlantDefaults* const defaultPlants;
+extern const int NUM_DEFAULT_PLANTS;
+extern const PumpWiring* const defaultPumps;
+extern const int NUM_DEFAULT_PUMPS;
+extern const PumpExpander* const defaultPumpExpanders;
+extern const int NUM_DEFAULT_PUMP_EXPANDERS;
+// Set by pumpRegistryBegin()
+extern Plant* plants;
+extern Pump* pumps;
+extern ZoneState zones;
+extern int numPumps;
+extern const PumpExpander* pumpExpanders;
+extern int numPumpExpanders;
+extern int eepromSize;
 extern const int SIZE_PER_PLANT;
 extern AsyncWebServer server;
+extern AsyncEventSource events;
+extern std::atomic<uint32_t> stateVersion;
 
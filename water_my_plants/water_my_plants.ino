@@ -1,16 +1,53 @@
 // plant_watering_system.ino
 #include "water_my_plants.h"
 
+// Starts due waterings and records finished ones. Runs on APP_CPU above
+// the web server, and never touches the network or flash itself.
+static void controlLoop(void*) {
+    for (;;) {
+        int64_t start = esp_timer_get_time();
+        applyCommands();
+        checkWateringNeeds();
+        waterPlants();
+        metricsObserve(HISTOGRAM_CONTROL_PASS, esp_timer_get_time() - start);
+
+        // Sleep until the next watering or pump stop, or until a web
+        // request changes a plant, whichever comes first
+        waitForWork(millisUntilNextWatering());
+    }
+}
+
+// Keeps Wi-Fi and NTP up, pushes plant changes to /api/events and writes
+// finished waterings and settings to flash, at low priority on PRO_CPU
+static void serviceLoop(void*) {
+    for (;;) {
+        int64_t start = esp_timer_get_time();
+        unsigned long networkMillis = checkNetwork();
+        journalFlush();
+        sendPlantEvents();
+        unsigned long storageMillis = commitDirtyPlants(false);
+        metricsObserve(HISTOGRAM_SERVICE_PASS, esp_timer_get_time() - start);
+        waitForWork(min(networkMillis, storageMillis));
+    }
+}
+
 void setup() {
     Serial.begin(115200);
+    // First, so the boot is recorded before anything else
+    traceBegin();
+    // Log lines are printed by their own task from here on
+    logBegin();
+    // Before anything kept per pump is allocated; opens the EEPROM image too
+    if (!pumpRegistryBegin()) {
+        LOG_ERROR("No room for the built-in zone table");
+        return;
+    }
+    metricsBegin();
     
-    // Initialize pump pins and ensure they're OFF
-    for (int i = 0; i < NUM_PUMPS; i++) {
-        pinMode(pumps[i].in1, OUTPUT);
-        pinMode(pumps[i].in2, OUTPUT);
-        digitalWrite(pumps[i].in1, LOW);
-        digitalWrite(pumps[i].in2, LOW);
-        pumpOff(pumps[i]);
+    // Initialize pump pins and expanders and ensure every pump is OFF
+    if (!pumpsBegin()) {
+        LOG_ERROR("Pump outputs failed to initialize - check the zone table");
+        return;
     }
     
     delay(1000);  // Give the system time to stabilize
@@ -23,58 +60,35 @@ void setup() {
     // Increase WiFi power
     WiFi.setTxPower(WIFI_POWER_19_5dBm);
     
+    // Connects in the background; watering starts once NTP has synced
+    timeBaseBegin();
     setupWiFi();
     
-    if (WiFi.status() != WL_CONNECTED || !syncTime()) {
-        Serial.println("Initial setup failed - restarting...");
-        delay(1000);
-        ESP.restart();
-    }
-    
-    // Initialize EEPROM
-    if (!EEPROM.begin(EEPROM_SIZE)) {
-        Serial.println("Failed to initialize EEPROM");
-        return;
-    }
-    
     if(!SPIFFS.begin(true)){
-        Serial.println("An Error has occurred while mounting SPIFFS");
+        LOG_ERROR("An Error has occurred while mounting SPIFFS");
         return;
     }
 
+    schedulerBegin();
+    commandsBegin();
+    // Before the plant records: old records get their usage totals from it
+    journalBegin();
     loadWateringTimes();
+    snapshotsBegin();
 
     // Set up the web server
     setupWebServer();
     
-    Serial.println("Plant Watering System Initialized");
+    LOG_INFO("Plant Watering System Initialized");
     printPlantSchedules();
+
+    if (!startTasks(controlLoop, serviceLoop)) {
+        LOG_ERROR("Failed to start the control and service tasks");
+    }
 }
 
+// The Arduino loop task only reports stack headroom now and then
 void loop() {
-    static unsigned long lastWiFiCheck = 0;
-    static unsigned long lastTimeSync = 0;
-    unsigned long currentMillis = millis();
-    
-    // Check WiFi every 5 minutes
-    if (currentMillis - lastWiFiCheck >= 300000) {
-        if (WiFi.status() != WL_CONNECTED) {
-            Serial.println("WiFi disconnected - reconnecting...");
-            setupWiFi();
-        }
-        lastWiFiCheck = currentMillis;
-    }
-    
-    // Sync time every hour
-    if (currentMillis - lastTimeSync >= 3600000) {
-        if (!syncTime()) {
-            Serial.println("Time sync failed - resetting...");
-            ESP.restart();
-        }
-        lastTimeSync = currentMillis;
-    }
-    
-    checkWateringNeeds();
-    waterPlants();
-    delay(1000);
-}
\ No newline at end of file
+    reportTaskStacks();
+    vTaskDelay(pdMS_TO_TICKS(3600000));
+}
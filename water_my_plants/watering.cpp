@@ -1,109 +1,292 @@
 // watering.cpp
 #include "water_my_plants.h"
 
-void checkWateringNeeds() {
-    struct tm timeinfo;
-    if(!getLocalTime(&timeinfo)) {
-        Serial.println("Failed to obtain time - skipping watering check");
+// Bumped after every change visible through /api/plants; the ETag of that
+// route is derived from it.
+std::atomic<uint32_t> stateVersion(0);
+
+void markStateChanged() {
+    stateVersion.fetch_add(1);
+}
+
+// Republishes a plant's snapshot and queues it for /api/events
+// subscribers. The snapshot goes first so a reader never pairs the new
+// version with the old state.
+static void publishPlantChange(int plantIndex) {
+    publishPlantSnapshot(plantIndex);
+    markStateChanged();
+    publishPlantEvent(plantIndex);
+}
+
+// For changes to a single plant: publishes it and has the control loop
+// re-read its schedule
+void markPlantChanged(int plantIndex) {
+    publishPlantChange(plantIndex);
+    reschedulePlant(plantIndex);
+}
+
+// Power budget in use by running pumps, and when the last one started;
+// only touched by the control loop
+static int runningWeight = 0;
+static unsigned long lastStartMillis = 0;
+static bool startedAny = false;
+
+// How much of the MAX_CONCURRENT_PUMPS budget pump i takes while running.
+// A pump heavier than the whole budget runs on its own.
+static int pumpWeight(int i) {
+    int weight = pumps[i].weight ? pumps[i].weight : 1;
+    return weight < MAX_CONCURRENT_PUMPS ? weight : MAX_CONCURRENT_PUMPS;
+}
+
+// Puts pump i in the start queue, ordered by since. Only the control loop
+// moves pumps in and out of the queue, so it publishes the change itself,
+// without the reschedule markPlantChanged() would add.
+static void queueStart(int i, time_t since) {
+    if (pumpWaiting(i)) return;
+    zones.waitingSince[i] = since;
+    queuePumpStart(i, since);
+}
+
+static void dequeueStart(int i) {
+    removeWaitingPump(i);
+    zones.waitingSince[i] = 0;
+}
+
+// Puts pump i back at the end of the queue after it failed to start. The
+// retry waits out the start stagger like any other start, so a failure
+// that persists doesn't spin the control loop.
+static void retryStart(int i, time_t now) {
+    lastStartMillis = millis();
+    startedAny = true;
+    queueStart(i, now);
+    publishPlantChange(i);
+}
+
+// Puts plant i's next watering on the schedule, or takes it off if the
+// plant has no interval
+static void schedulePlant(int i, time_t now) {
+    Plant* plant = pumps[i].plant;
+    if (plant->intervalMinutes == 0) {
+        clearPlantDue(i);
         return;
     }
-    
-    time_t now = mktime(&timeinfo);
-    
-    for (int i = 0; i < NUM_PUMPS; i++) {
-        Plant* plant = pumps[i].plant;
-        if (plant->intervalMinutes == 0) continue;
-        
-        int lastIndex = (plant->currentHistoryIndex - 1 + WATERING_HISTORY_SIZE) % WATERING_HISTORY_SIZE;
-        time_t lastWatered = plant->wateringHistory[lastIndex].timestamp;
-        
-        if (lastWatered == 0 || (now - lastWatered) >= (plant->intervalMinutes * 60)) {
-            plant->needsWatering = true;
-            pumps[i].runDuration = (unsigned long)(plant->ozPerWatering * MILLIS_PER_OZ);
+    int lastIndex = (plant->currentHistoryIndex - 1 + WATERING_HISTORY_SIZE) % WATERING_HISTORY_SIZE;
+    time_t lastWatered = plant->wateringHistory[lastIndex].timestamp;
+    setPlantDue(i, lastWatered == 0 ? now : lastWatered + plant->intervalMinutes * 60);
+}
+
+void checkWateringNeeds() {
+    // Nothing can be scheduled before the first NTP sync; the time base
+    // reschedules every plant once it has one
+    if (!timeValid()) return;
+    time_t now = timeNow();
+
+    // Plants changed since the last pass: new settings or history, or a
+    // "water now" request
+    for (int i; (i = takeRescheduledPlant()) >= 0; ) {
+        if (zones.running[i]) continue;  // rescheduled when it stops
+        if (zones.needsWatering[i]) {
+            clearPlantDue(i);
+            if (!pumpWaiting(i)) {
+                queueStart(i, now);
+                publishPlantChange(i);
+            }
+        } else {
+            if (pumpWaiting(i)) {
+                dequeueStart(i);
+                publishPlantChange(i);
+            }
+            schedulePlant(i, now);
+        }
+    }
+
+    // Plants whose interval has run out, queued by how long they have been
+    // due: after a reboot with no history, all of them at once
+    time_t due;
+    for (int i; (i = takeDuePlant(now, due)) >= 0; ) {
+        pumps[i].source = WATERING_SCHEDULED;
+        queueStart(i, due);
+        if (!zones.needsWatering[i]) {
+            zones.needsWatering[i] = true;
+            traceRecord(TRACE_NEEDS_WATERING, i, 1, WATERING_SCHEDULED);
         }
+        markPlantChanged(i);
     }
 }
 
-void waterPlants() {
+// Formats now as local time for the log
+static void formatTime(time_t now, char* out, size_t len) {
     struct tm timeinfo;
-    if(!getLocalTime(&timeinfo)) {
-        Serial.println("Failed to obtain time - skipping watering check");
-        return;
+    localtime_r(&now, &timeinfo);
+    strftime(out, len, "%Y-%m-%d %H:%M:%S", &timeinfo);
+}
+
+// Runs in the esp_timer task at the end of a dose, however busy the
+// control loop is; the loop records the watering once it wakes
+static void stopPumpTimer(void* arg) {
+    int i = (int)(intptr_t)arg;
+    pumpOff(pumps[i]);
+    flushPumpOutputs();
+    metricsPumpStopped(i);
+    markPumpStopped(i);
+}
+
+static bool createStopTimer(int i) {
+    if (pumps[i].stopTimer) return true;
+    esp_timer_create_args_t args = {};
+    args.callback = stopPumpTimer;
+    args.arg = (void*)(intptr_t)i;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "pump_stop";
+    return esp_timer_create(&args, &pumps[i].stopTimer) == ESP_OK;
+}
+
+// Arms pump i's one-shot timer to switch it off after runDuration
+static bool armStopTimer(int i) {
+    // esp_timer runs off the same crystal the time base measured drift on
+    int64_t us = (int64_t)pumps[i].runDuration * 1000;
+    us += us * timeDriftPpb() / 1000000000;
+    // Called right after the outputs switched on, so this times the dose
+    metricsPumpStarted(i, us);
+    return esp_timer_start_once(pumps[i].stopTimer, (uint64_t)us) == ESP_OK;
+}
+
+void waterPlants() {
+    time_t now = timeNow();
+    bool watered = false;
+
+    // Pumps their stop timer has already switched off; their share of the
+    // budget is free for the queue below
+    for (int i; (i = takeStoppedPump()) >= 0; ) {
+        zones.running[i] = false;
+        runningWeight -= pumpWeight(i);
+        
+        // What was dispensed, not the setting, which may have changed since
+        float amount = pumps[i].doseAmount;
+        int currentIndex = pumps[i].plant->currentHistoryIndex;
+        pumps[i].plant->wateringHistory[currentIndex].timestamp = now;
+        pumps[i].plant->wateringHistory[currentIndex].amount = amount;
+        
+        pumps[i].plant->currentHistoryIndex = (currentIndex + 1) % WATERING_HISTORY_SIZE;
+        zones.needsWatering[i] = false;
+        traceRecord(TRACE_NEEDS_WATERING, i, 0, 0);
+        traceRecord(TRACE_WATERED, i, pumps[i].source, pumps[i].runDuration);
+        journalPost(i, now, amount, pumps[i].runDuration, pumps[i].source);
+        rollupAdd(pumps[i].plant->rollup, now, amount);
+        pumps[i].source = WATERING_SCHEDULED;
+        if (pumps[i].waterAgain) {
+            // "Water now" that arrived during this dose
+            pumps[i].waterAgain = false;
+            zones.needsWatering[i] = true;
+            pumps[i].source = WATERING_MANUAL;
+            traceRecord(TRACE_NEEDS_WATERING, i, 1, WATERING_MANUAL);
+        }
+        watered = true;
+        markPlantChanged(i);
+        markPlantDirty(i);
+
+        LOG_INFO("Finished watering %s (%.1f oz)", pumps[i].plant->name, amount);
     }
     
-    time_t now = mktime(&timeinfo);
-    unsigned long currentMillis = millis();
-    bool needToSave = false;
-    
-    for (int i = 0; i < NUM_PUMPS; i++) {
-        if (!pumps[i].isRunning && pumps[i].plant->needsWatering) {
-            pumpOn(pumps[i]);
-            pumps[i].isRunning = true;
-            pumps[i].startTime = currentMillis;
-            
-            char timeStr[30];
-            strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-            Serial.printf("%s Starting to water %s\n", timeStr, pumps[i].plant->name);
+    // Watering history goes to flash on the service task's next pass, with
+    // any pending settings
+    if (watered) {
+        requestCommit();
+    }
+
+    // Start queued pumps in order while the budget allows, one per stagger
+    // interval. The head of the queue is never skipped for a lighter pump
+    // behind it, so a heavy pump can't be starved.
+    int started[MAX_CONCURRENT_PUMPS];
+    int startedCount = 0;
+    for (int i; (i = nextWaitingPump()) >= 0; ) {
+        if (zones.running[i] || !zones.needsWatering[i]) {
+            dequeueStart(i);
+            publishPlantChange(i);
+            continue;
         }
-        else if (pumps[i].isRunning) {
-            if (currentMillis - pumps[i].startTime >= pumps[i].runDuration) {
-                pumpOff(pumps[i]);
-                pumps[i].isRunning = false;
-                
-                int currentIndex = pumps[i].plant->currentHistoryIndex;
-                pumps[i].plant->wateringHistory[currentIndex].timestamp = now;
-                pumps[i].plant->wateringHistory[currentIndex].amount = pumps[i].plant->ozPerWatering;
-                
-                pumps[i].plant->currentHistoryIndex = (currentIndex + 1) % WATERING_HISTORY_SIZE;
-                pumps[i].plant->needsWatering = false;
-                needToSave = true;
-                
-                if(getLocalTime(&timeinfo)) {
-                    char timeStr[30];
-                    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-                    Serial.printf("%s Finished watering %s (%.1f oz)\n", 
-                                timeStr, pumps[i].plant->name, 
-                                pumps[i].plant->ozPerWatering);
-                }
-            }
+        if (runningWeight + pumpWeight(i) > MAX_CONCURRENT_PUMPS) break;
+        if (startedAny && millis() - lastStartMillis < PUMP_START_STAGGER_MS) break;
+
+        dequeueStart(i);
+        if (!createStopTimer(i)) {
+            LOG_ERROR("Failed to create the stop timer for %s - retrying", pumps[i].plant->name);
+            retryStart(i, now);
+            break;
         }
+        // Sized now, so a change queued meanwhile applies to this dose
+        pumps[i].doseAmount = pumps[i].plant->ozPerWatering;
+        pumps[i].runDuration = (unsigned long)(pumps[i].doseAmount * MILLIS_PER_OZ);
+        pumpOn(pumps[i]);
+        zones.running[i] = true;
+        pumps[i].startTime = millis();
+        runningWeight += pumpWeight(i);
+        lastStartMillis = pumps[i].startTime;
+        startedAny = true;
+        started[startedCount++] = i;
     }
-    
-    if (needToSave) {
-        saveWateringTimes();
+    if (startedCount == 0) return;
+
+    // Everything started this pass switches on together, one write per
+    // expander, and the doses are timed from there
+    flushPumpOutputs();
+    for (int n = 0; n < startedCount; n++) {
+        int i = started[n];
+        if (!armStopTimer(i)) {
+            pumpOff(pumps[i]);
+            flushPumpOutputs();
+            zones.running[i] = false;
+            runningWeight -= pumpWeight(i);
+            LOG_ERROR("Failed to arm the stop timer for %s - retrying", pumps[i].plant->name);
+            retryStart(i, now);
+            continue;
+        }
+        markPlantChanged(i);
+        LOG_INFO("Starting to water %s", pumps[i].plant->name);
     }
 }
 
-void printPlantSchedules() {
-    struct tm timeinfo;
-    if(!getLocalTime(&timeinfo)) {
-        Serial.println("Failed to obtain time");
-        return;
+// How long the control loop may sleep before the next watering is due or
+// the next queued pump may start; pump stops wake it themselves
+unsigned long millisUntilNextWatering() {
+    unsigned long wait = millisUntilNextDeadline(timeNow());
+    int next = nextWaitingPump();
+    if (next >= 0 && runningWeight + pumpWeight(next) <= MAX_CONCURRENT_PUMPS) {
+        unsigned long since = millis() - lastStartMillis;
+        unsigned long stagger = startedAny && since < PUMP_START_STAGGER_MS ? PUMP_START_STAGGER_MS - since : 0;
+        if (stagger < wait) wait = stagger;
     }
-    
-    char timeStr[30];
-    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
+    return wait;
+}
+
+// Power budget in use by running pumps, in units of a standard pump
+int runningPumpWeight() {
+    return runningWeight;
+}
+
+// Boot-time listing, printed directly: a line per plant would overrun the
+// log ring on a large system
+void printPlantSchedules() {
+    char timeStr[30] = "not synced yet";
+    if (timeValid()) formatTime(timeNow(), timeStr, sizeof(timeStr));
     
     Serial.println("\nCurrent Watering Schedules:");
     Serial.printf("Current time: %s\n", timeStr);
     
-    for (int i = 0; i < NUM_PUMPS; i++) {
+    time_t now = timeNow();
+    for (int i = 0; i < numPumps; i++) {
         if (pumps[i].plant->intervalMinutes > 0) {
             Serial.printf("Pump %d - %s: %.1foz every %d minutes\n",
                 pumps[i].number,
                 pumps[i].plant->name,
                 pumps[i].plant->ozPerWatering,
                 pumps[i].plant->intervalMinutes);
+            UsageTotals day = rollupWindow(pumps[i].plant->rollup, ROLLUP_24H, now);
+            UsageTotals week = rollupWindow(pumps[i].plant->rollup, ROLLUP_7D, now);
+            UsageTotals month = rollupWindow(pumps[i].plant->rollup, ROLLUP_30D, now);
+            UsageTotals lifetime = rollupWindow(pumps[i].plant->rollup, ROLLUP_LIFETIME, now);
+            Serial.printf("    used %.1foz in 24 h, %.1foz in 7 d, %.1foz in 30 d, %.1foz in %u waterings overall\n",
+                day.oz, week.oz, month.oz, lifetime.oz, (unsigned)lifetime.waterings);
         }
     }
 }
-
-void pumpOn(Pump& pump) {
-    digitalWrite(pump.in1, HIGH);
-    digitalWrite(pump.in2, LOW);
-}
-
-void pumpOff(Pump& pump) {
-    digitalWrite(pump.in1, LOW);
-    digitalWrite(pump.in2, LOW);
-}
\ No newline at end of file
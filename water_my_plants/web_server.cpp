@@ -2,50 +2,770 @@
 #include "homepage.h"
 
 AsyncWebServer server(80);
+AsyncEventSource events("/api/events");
 
-// Convert plant data to JSON
-String getPlantDataJson() {
-    String json = "[";
-    for (int i = 0; i < NUM_PUMPS; i++) {
-        if (i > 0) json += ",";
-        json += "{";
-        json += "\"name\":\"" + String(plants[i].name) + "\",";
-        json += "\"ozPerWatering\":" + String(plants[i].ozPerWatering) + ",";
-        json += "\"intervalMinutes\":" + String(plants[i].intervalMinutes) + ",";
-        json += "\"needsWatering\":" + String(plants[i].needsWatering ? "true" : "false") + ",";
-        
-        // Add watering history
-        json += "\"wateringHistory\":[";
-        int currentIndex = plants[i].currentHistoryIndex;
-        for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
-            if (j > 0) json += ",";
-            // Calculate the index going backwards from current
-            int historyIndex = (currentIndex - 1 - j + WATERING_HISTORY_SIZE) % WATERING_HISTORY_SIZE;
-            json += "{";
-            json += "\"timestamp\":" + String(plants[i].wateringHistory[historyIndex].timestamp) + ",";
-            json += "\"amount\":" + String(plants[i].wateringHistory[historyIndex].amount);
-            json += "}";
-        }
-        json += "]";
-        
-        json += "}";
-    }
-    json += "]";
-    return json;
+// Subscribers beyond this are dropped; each one holds a TCP connection
+#define MAX_EVENT_CLIENTS 4
+
+// Records (or buckets) per history page
+#define HISTORY_DEFAULT_LIMIT 100
+#define HISTORY_MAX_LIMIT 1000
+
+// Largest body of a single-field change, and of PUT /api/plants/batch:
+// room for a full batch with all fields and full-length names. Fixed, so
+// the body pool stays the same size however many zones there are.
+#define SETTING_BODY_MAX 256
+#define BATCH_BODY_MAX (BATCH_MAX_UPDATES * 128 + 256)
+
+// Distinguishes ETags across reboots, when stateVersion starts over
+static uint32_t etagBootId = 0;
+
+// ETag for the current plant state and usage hour, e.g.
+// "1a2b3c4d-42-493812", or "1a2b3c4d-42-493812-cbor" for the CBOR body
+static void formatStateEtag(char* buf, size_t size, bool cbor) {
+    unsigned hour = (unsigned)(rollupAsOf(timeNow()) / 3600);
+    snprintf(buf, size, "\"%08x-%u-%u%s\"", (unsigned)etagBootId, (unsigned)stateVersion.load(), hour,
+             cbor ? "-cbor" : "");
+}
+
+// Bounded writer used to render one /api/plants record at a time
+struct JsonOut {
+    char* p;
+    char* end;
+
+    void ch(char c) {
+        if (p < end) *p++ = c;
+    }
+
+    void raw(const char* s) {
+        while (*s) ch(*s++);
+    }
+
+    void integer(long long value) {
+        char digits[20];
+        int n = 0;
+        unsigned long long v = value < 0 ? -(unsigned long long)value : value;
+        do {
+            digits[n++] = '0' + v % 10;
+            v /= 10;
+        } while (v);
+        if (value < 0) ch('-');
+        while (n) ch(digits[--n]);
+    }
+
+    // Same text as String(float): two decimals, e.g. 3.00
+    void fixed2(float value) {
+        if (isnan(value) || isinf(value)) {
+            raw("null");
+            return;
+        }
+        if (fabsf(value) >= 1e15f) {
+            char buf[16];
+            snprintf(buf, sizeof(buf), "%.2e", value);
+            raw(buf);
+            return;
+        }
+        long long cents = llround((double)value * 100.0);
+        if (cents < 0) {
+            ch('-');
+            cents = -cents;
+        }
+        integer(cents / 100);
+        ch('.');
+        ch('0' + (cents / 10) % 10);
+        ch('0' + cents % 10);
+    }
+
+    void string(const char* s) {
+        static const char hex[] = "0123456789abcdef";
+        ch('"');
+        for (; *s; s++) {
+            unsigned char c = *s;
+            if (c == '"' || c == '\\') {
+                ch('\\');
+                ch(c);
+            } else if (c < 0x20) {
+                raw("\\u00");
+                ch(hex[c >> 4]);
+                ch(hex[c & 0xF]);
+            } else {
+                ch(c);
+            }
+        }
+        ch('"');
+    }
+};
+
+// {"waterings":3,"oz":4.50,"meanIntervalMinutes":480}; the interval is
+// null until there is a watering to share the time out over
+static void writeUsage(JsonOut& out, const UsageTotals& totals) {
+    out.raw("{\"waterings\":");
+    out.integer(totals.waterings);
+    out.raw(",\"oz\":");
+    out.fixed2(totals.oz);
+    out.raw(",\"meanIntervalMinutes\":");
+    if (totals.waterings) {
+        out.integer(totals.meanIntervalMinutes);
+    } else {
+        out.raw("null");
+    }
+    out.ch('}');
+}
+
+// Writes the members of plant i's JSON object, without the braces
+static void writePlantFields(JsonOut& out, int i) {
+    PlantSnapshot plant;
+    if (!readPlantSnapshot(i, plant)) return;
+    out.raw("\"name\":");
+    out.string(plant.name);
+    out.raw(",\"ozPerWatering\":");
+    out.fixed2(plant.ozPerWatering);
+    out.raw(",\"intervalMinutes\":");
+    out.integer(plant.intervalMinutes);
+    out.raw(plant.needsWatering ? ",\"needsWatering\":true" : ",\"needsWatering\":false");
+    out.raw(plant.pumpRunning ? ",\"pumpRunning\":true" : ",\"pumpRunning\":false");
+
+    // Place in the power-budgeted start queue: waiting pumps start in
+    // waitingSince order, ties by index
+    if (plant.pumpRunning) {
+        out.raw(",\"pumpState\":\"running\",\"waitingSince\":null");
+    } else if (plant.waitingSince) {
+        out.raw(",\"pumpState\":\"waiting\",\"waitingSince\":");
+        out.integer(plant.waitingSince);
+    } else {
+        out.raw(",\"pumpState\":\"idle\",\"waitingSince\":null");
+    }
+
+    // Watering history, newest first
+    out.raw(",\"wateringHistory\":[");
+    for (int j = 0; j < WATERING_HISTORY_SIZE; j++) {
+        if (j > 0) out.ch(',');
+        out.raw("{\"timestamp\":");
+        out.integer(plant.history[j].timestamp);
+        out.raw(",\"amount\":");
+        out.fixed2(plant.history[j].amount);
+        out.ch('}');
+    }
+    out.ch(']');
+
+    // Rolling usage, read from the running totals rather than the history
+    time_t now = rollupAsOf(timeNow());
+    out.raw(",\"usage\":{\"24h\":");
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_24H, now));
+    out.raw(",\"7d\":");
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_7D, now));
+    out.raw(",\"30d\":");
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_30D, now));
+    out.raw(",\"lifetime\":");
+    writeUsage(out, rollupWindow(plant.rollup, ROLLUP_LIFETIME, now));
+    out.ch('}');
+}
+
+// Renders plant i, including the array bracket or separator around it
+static size_t renderPlantRecord(int i, char* buf, size_t size) {
+    JsonOut out = {buf, buf + size};
+    out.ch(i == 0 ? '[' : ',');
+    if (i < numPumps) {
+        out.ch('{');
+        writePlantFields(out, i);
+        out.ch('}');
+    }
+    if (i >= numPumps - 1) out.ch(']');
+    return out.p - buf;
+}
+
+// Plants changed since their last /api/events push; set from any task,
+// sent by the service task
+static std::atomic<bool>* pendingEvents = nullptr;
+static std::atomic<bool> anyEventPending(false);
+
+// Queues plant i for /api/events subscribers. Only flags it: the control
+// loop calls this on every dose and mustn't wait on the network, so the
+// service task renders and sends it in sendPlantEvents().
+void publishPlantEvent(int plantIndex) {
+    if (!pendingEvents || plantIndex < 0 || plantIndex >= numPumps) return;
+    pendingEvents[plantIndex] = true;
+    if (!anyEventPending.exchange(true)) wakeServiceTask();
+}
+
+// Sends each queued plant as one "plant" event, e.g.
+// {"index":2,"name":"Basil",...}, rendered from its latest snapshot; the
+// event id is the state version. Several changes to a plant since the
+// last pass go out as one event.
+void sendPlantEvents() {
+    if (!anyEventPending.exchange(false)) return;
+    bool subscribed = events.count() > 0;
+    for (int i = 0; i < numPumps; i++) {
+        if (!pendingEvents[i].exchange(false) || !subscribed) continue;
+        char data[PLANT_JSON_RECORD_MAX];
+        JsonOut out = {data, data + sizeof(data) - 1};
+        out.raw("{\"index\":");
+        out.integer(i);
+        out.ch(',');
+        writePlantFields(out, i);
+        out.ch('}');
+        *out.p = '\0';
+        events.send(data, "plant", stateVersion.load());
+    }
+}
+
+size_t fillPlantDataJson(PlantJsonCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    int records = numPumps > 0 ? numPumps : 1;
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.offset == cursor.length) {
+            if (cursor.next >= records) break;
+            cursor.length = renderPlantRecord(cursor.next++, cursor.record, sizeof(cursor.record));
+            cursor.offset = 0;
+        }
+        size_t n = min(cursor.length - cursor.offset, maxLen - written);
+        memcpy(buffer + written, cursor.record + cursor.offset, n);
+        cursor.offset += n;
+        written += n;
+    }
+    return written;
+}
+
+// Local calendar day or week (from Monday) containing timestamp
+static void bucketBounds(uint32_t timestamp, uint8_t bucket, uint32_t& start, uint32_t& end) {
+    time_t t = timestamp;
+    struct tm tm;
+    localtime_r(&t, &tm);
+    tm.tm_hour = 0;
+    tm.tm_min = 0;
+    tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    if (bucket == HISTORY_BUCKET_WEEK) tm.tm_mday -= (tm.tm_wday + 6) % 7;
+    start = (uint32_t)mktime(&tm);
+    tm.tm_mday += bucket == HISTORY_BUCKET_WEEK ? 7 : 1;
+    tm.tm_isdst = -1;
+    end = (uint32_t)mktime(&tm);
+}
+
+static void writeBucket(JsonOut& out, const HistoryCursor& cursor) {
+    out.raw("{\"start\":");
+    out.integer(cursor.bucketStart);
+    out.raw(",\"count\":");
+    out.integer(cursor.bucketCount);
+    out.raw(",\"amount\":");
+    out.fixed2(cursor.bucketAmount);
+    out.raw(",\"durationMs\":");
+    out.integer(cursor.bucketDurationMs);
+    out.ch('}');
+}
+
+// Closes the body; a resume token is given when the limit cut it short
+static void writeHistoryEnd(JsonOut& out, const JournalReader* resumeAt) {
+    out.raw("],\"next\":");
+    if (resumeAt) {
+        // The record just read sits one before the reader's position
+        char token[20];
+        snprintf(token, sizeof(token), "%lx-%lx", (unsigned long)resumeAt->segment,
+                 (unsigned long)(resumeAt->record - 1));
+        out.string(token);
+    } else {
+        out.raw("null");
+    }
+    out.ch('}');
+}
+
+void historyBegin(HistoryCursor& cursor, int plant, time_t from, time_t to, uint32_t limit, HistoryBucket bucket) {
+    cursor = HistoryCursor();
+    cursor.plant = plant;
+    cursor.to = to < 0 ? 0 : (uint64_t)to > UINT32_MAX ? UINT32_MAX : (uint32_t)to;
+    cursor.limit = limit;
+    cursor.bucket = bucket;
+    journalSeek(cursor.reader, from);
+}
+
+// Continues from the "next" token of an earlier page, e.g. "3-a0"
+bool historyResume(HistoryCursor& cursor, const char* token) {
+    char* end;
+    unsigned long segment = strtoul(token, &end, 16);
+    if (end == token || *end != '-') return false;
+    const char* recordText = end + 1;
+    unsigned long record = strtoul(recordText, &end, 16);
+    if (end == recordText || *end) return false;
+    cursor.reader.file.close();
+    cursor.reader.segment = segment;
+    cursor.reader.record = record;
+    return true;
+}
+
+// Renders the next piece of the history body into cursor.record: the
+// opening, one record or finished bucket, or the closing. Returns 0 once
+// the body is complete.
+static size_t renderHistoryPiece(HistoryCursor& cursor) {
+    JsonOut out = {cursor.record, cursor.record + sizeof(cursor.record)};
+    if (cursor.done) return 0;
+    if (!cursor.started) {
+        cursor.started = true;
+        out.raw("{\"plant\":");
+        out.integer(cursor.plant);
+        if (cursor.bucket == HISTORY_BUCKET_NONE) {
+            out.raw(",\"records\":[");
+        } else {
+            out.raw(cursor.bucket == HISTORY_BUCKET_DAY ? ",\"bucket\":\"day\"" : ",\"bucket\":\"week\"");
+            out.raw(",\"buckets\":[");
+        }
+        return out.p - cursor.record;
+    }
+
+    JournalRecord record;
+    for (;;) {
+        if (!journalNext(cursor.reader, record) || record.timestamp > cursor.to) {
+            // End of range; the bucket being summed is the last one
+            if (cursor.bucketCount > 0) {
+                if (cursor.emitted > 0) out.ch(',');
+                writeBucket(out, cursor);
+            }
+            writeHistoryEnd(out, nullptr);
+            cursor.done = true;
+            return out.p - cursor.record;
+        }
+        if (record.plant != cursor.plant) continue;
+
+        if (cursor.bucket == HISTORY_BUCKET_NONE) {
+            if (cursor.emitted == cursor.limit) break;
+            if (cursor.emitted++ > 0) out.ch(',');
+            out.raw("{\"timestamp\":");
+            out.integer(record.timestamp);
+            out.raw(",\"amount\":");
+            out.fixed2(record.amount);
+            out.raw(",\"durationMs\":");
+            out.integer(record.durationMs);
+            out.raw(record.source == WATERING_MANUAL ? ",\"source\":\"manual\"}" : ",\"source\":\"scheduled\"}");
+            return out.p - cursor.record;
+        }
+
+        if (cursor.bucketCount > 0 && record.timestamp >= cursor.bucketStart && record.timestamp < cursor.bucketEnd) {
+            cursor.bucketCount++;
+            cursor.bucketAmount += record.amount;
+            cursor.bucketDurationMs += record.durationMs;
+            continue;
+        }
+        // This record opens a new bucket: the one before it is complete
+        bool flushed = cursor.bucketCount > 0;
+        if (flushed) {
+            if (cursor.emitted++ > 0) out.ch(',');
+            writeBucket(out, cursor);
+        }
+        if (cursor.emitted == cursor.limit) break;
+        bucketBounds(record.timestamp, cursor.bucket, cursor.bucketStart, cursor.bucketEnd);
+        cursor.bucketCount = 1;
+        cursor.bucketAmount = record.amount;
+        cursor.bucketDurationMs = record.durationMs;
+        if (flushed) return out.p - cursor.record;
+    }
+
+    // Limit reached with more to come: the next page starts at this record
+    writeHistoryEnd(out, &cursor.reader);
+    cursor.done = true;
+    return out.p - cursor.record;
+}
+
+size_t fillHistoryJson(HistoryCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.offset == cursor.length) {
+            cursor.length = renderHistoryPiece(cursor);
+            cursor.offset = 0;
+            if (cursor.length == 0) break;
+        }
+        size_t n = min(cursor.length - cursor.offset, maxLen - written);
+        memcpy(buffer + written, cursor.record + cursor.offset, n);
+        cursor.offset += n;
+        written += n;
+    }
+    return written;
+}
+
+// Reads an optional unsigned query parameter; false if it is malformed
+static bool queryUnsigned(AsyncWebServerRequest* request, const char* name, unsigned long long& value) {
+    AsyncWebParameter* param = request->getParam(name);
+    if (!param) return true;
+    const char* text = param->value().c_str();
+    char* end;
+    value = strtoull(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+// GET /api/plants/{i}/history?from=&to=&limit=&cursor=&bucket=
+static void handleHistoryRequest(AsyncWebServerRequest* request) {
+    int plantIndex;
+    int consumed = 0;
+    if (sscanf(request->url().c_str(), "/api/plants/%d/history%n", &plantIndex, &consumed) != 1 ||
+        request->url().c_str()[consumed] != '\0' || plantIndex < 0 || plantIndex >= numPumps) {
+        request->send(404);
+        return;
+    }
+
+    unsigned long long from = 0, to = UINT32_MAX, limit = HISTORY_DEFAULT_LIMIT;
+    if (!queryUnsigned(request, "from", from) || !queryUnsigned(request, "to", to) ||
+        !queryUnsigned(request, "limit", limit) || limit == 0 || limit > HISTORY_MAX_LIMIT) {
+        request->send(400, "application/json", "{\"error\":\"Invalid from, to or limit\"}");
+        return;
+    }
+    HistoryBucket bucket = HISTORY_BUCKET_NONE;
+    if (AsyncWebParameter* param = request->getParam("bucket")) {
+        if (param->value() == "day") {
+            bucket = HISTORY_BUCKET_DAY;
+        } else if (param->value() == "week") {
+            bucket = HISTORY_BUCKET_WEEK;
+        } else {
+            request->send(400, "application/json", "{\"error\":\"bucket must be day or week\"}");
+            return;
+        }
+    }
+
+    HistoryCursor cursor;
+    historyBegin(cursor, plantIndex, (time_t)min(from, (unsigned long long)UINT32_MAX), (time_t)min(to, (unsigned long long)UINT32_MAX),
+                 (uint32_t)limit, bucket);
+    AsyncWebParameter* token = request->getParam("cursor");
+    if (token && !historyResume(cursor, token->value().c_str())) {
+        request->send(400, "application/json", "{\"error\":\"Invalid cursor\"}");
+        return;
+    }
+
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+        [cursor](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            return fillHistoryJson(cursor, buffer, maxLen);
+        });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+// Queues command for the control loop and answers 202 with its id, or
+// 503 while the queue is full; returns whether it was queued
+static bool sendQueued(AsyncWebServerRequest* request, Command& command) {
+    uint32_t id = enqueueCommand(command);
+    if (id == 0) {
+        AsyncWebServerResponse* response = request->beginResponse(503, "application/json", "{\"error\":\"Too many pending changes\"}");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return false;
+    }
+    char body[48], location[32];
+    snprintf(body, sizeof(body), "{\"id\":%lu,\"status\":\"queued\"}", (unsigned long)id);
+    snprintf(location, sizeof(location), "/api/commands/%lu", (unsigned long)id);
+    AsyncWebServerResponse* response = request->beginResponse(202, "application/json", body);
+    response->addHeader("Location", location);
+    request->send(response);
+    return true;
+}
+
+// GET /api/commands/{id}
+static void handleCommandStatusRequest(AsyncWebServerRequest* request) {
+    unsigned long id;
+    int consumed = 0;
+    if (sscanf(request->url().c_str(), "/api/commands/%lu%n", &id, &consumed) != 1 ||
+        request->url().c_str()[consumed] != '\0' || id > UINT32_MAX) {
+        request->send(404);
+        return;
+    }
+    uint32_t appliedAt;
+    CommandStatus status = commandStatus(id, appliedAt);
+    if (status == COMMAND_UNKNOWN) {
+        request->send(404, "application/json", "{\"error\":\"Unknown command\"}");
+        return;
+    }
+    char body[80];
+    JsonOut out = {body, body + sizeof(body) - 1};
+    out.raw("{\"id\":");
+    out.integer(id);
+    out.raw(status == COMMAND_QUEUED ? ",\"status\":\"queued\"" : ",\"status\":\"applied\"");
+    if (appliedAt) {
+        out.raw(",\"appliedAt\":");
+        out.integer(appliedAt);
+    }
+    out.ch('}');
+    *out.p = '\0';
+    AsyncWebServerResponse* response = request->beginResponse(200, "application/json", body);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+static void sendBatchError(AsyncWebServerRequest* request, int status, const char* error, int index) {
+    char body[96];
+    JsonOut out = {body, body + sizeof(body) - 1};
+    out.raw("{\"error\":\"");
+    out.raw(error);
+    out.ch('"');
+    if (index >= 0) {
+        out.raw(",\"index\":");
+        out.integer(index);
+    }
+    out.ch('}');
+    *out.p = '\0';
+    request->send(status, "application/json", body);
+}
+
+// Validates one entry of a batch into update; returns the problem, or
+// nullptr if there is none
+static const char* parsePlantUpdate(JsonObjectConst entry, PlantUpdate& update) {
+    if (entry.isNull()) return "Entry must be an object";
+    if (!entry["plantIndex"].is<int>()) return "Missing plantIndex";
+    int plantIndex = entry["plantIndex"].as<int>();
+    if (plantIndex < 0 || plantIndex >= numPumps) return "Invalid plant index";
+    update = PlantUpdate();
+    update.plant = plantIndex;
+
+    if (entry.containsKey("name")) {
+        const char* name = entry["name"].as<const char*>();
+        if (!name || !*name) return "Invalid name";
+        size_t nameLength = strlen(name);
+        if (nameLength >= sizeof(update.name)) return "Name too long";
+        memcpy(update.name, name, nameLength + 1);
+        update.fields |= UPDATE_NAME;
+    }
+    if (entry.containsKey("ozPerWatering")) {
+        if (!entry["ozPerWatering"].is<float>()) return "Invalid ozPerWatering";
+        update.amount = entry["ozPerWatering"].as<float>();
+        if (!(update.amount > 0)) return "Amount must be greater than 0";
+        if (update.amount > MAX_OZ_PER_WATERING) return "Amount must be at most 100 oz";
+        update.fields |= UPDATE_AMOUNT;
+    }
+    if (entry.containsKey("intervalDays")) {
+        if (!entry["intervalDays"].is<float>()) return "Invalid intervalDays";
+        float days = entry["intervalDays"].as<float>();
+        if (!(days > 0)) return "Interval must be greater than 0";
+        update.intervalMinutes = days * 24 * 60;
+        update.fields |= UPDATE_INTERVAL;
+    }
+    if (entry.containsKey("waterNow")) {
+        if (!entry["waterNow"].is<bool>()) return "Invalid waterNow";
+        if (entry["waterNow"].as<bool>()) update.fields |= UPDATE_WATER_NOW;
+    }
+    if (!update.fields) return "Nothing to change";
+    return nullptr;
+}
+
+// PUT /api/plants/batch: every entry is checked before any is queued, and
+// the control loop applies the lot in one pass and one EEPROM commit
+static void handleBatchRequest(AsyncWebServerRequest* request, JsonDocument& doc) {
+    if (!doc.is<JsonArrayConst>() || doc.size() == 0) {
+        sendBatchError(request, 400, "Expected a non-empty array of plant updates", -1);
+        return;
+    }
+    // Bigger batches are split by the client, as are bodies over
+    // BATCH_BODY_MAX
+    if (doc.size() > BATCH_MAX_UPDATES) {
+        sendBatchError(request, 413, "Too many updates", -1);
+        return;
+    }
+
+    size_t count = doc.size();
+    PlantUpdate* updates = claimBatchUpdates();
+    if (!updates) {
+        AsyncWebServerResponse* response = request->beginResponse(503, "application/json", "{\"error\":\"Another batch is pending\"}");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
+    }
+    JsonArrayConst entries = doc.as<JsonArrayConst>();
+    for (size_t k = 0; k < count; k++) {
+        const char* problem = parsePlantUpdate(entries[k].as<JsonObjectConst>(), updates[k]);
+        for (size_t j = 0; !problem && j < k; j++) {
+            if (updates[j].plant == updates[k].plant) problem = "Duplicate plantIndex";
+        }
+        if (problem) {
+            releaseBatchUpdates();
+            sendBatchError(request, 400, problem, k);
+            return;
+        }
+    }
+
+    Command command = {};
+    command.type = COMMAND_BATCH;
+    command.batch.updates = updates;
+    command.batch.count = count;
+    if (!sendQueued(request, command)) releaseBatchUpdates();
+}
+
+// Answers GET /api/plants in either format. Each has its own ETag, since
+// the bodies differ.
+static void sendPlantData(AsyncWebServerRequest* request, bool cbor) {
+    // Read the version before rendering so a change made mid-response
+    // can only make the ETag older than the body, never newer.
+    char etag[48];
+    formatStateEtag(etag, sizeof(etag), cbor);
+
+    AsyncWebHeader* ifNoneMatch = request->getHeader("If-None-Match");
+    if (ifNoneMatch && strstr(ifNoneMatch->value().c_str(), etag)) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", etag);
+        response->addHeader("Vary", "Accept");
+        request->send(response);
+        return;
+    }
+
+    // Records are rendered straight into the TCP send buffer as it
+    // drains; the cursor is the only per-request state.
+    AsyncWebServerResponse* response;
+    if (cbor) {
+        PlantCborCursor cursor = {};
+        response = request->beginChunkedResponse("application/cbor",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+                return fillPlantDataCbor(cursor, buffer, maxLen);
+            });
+    } else {
+        PlantJsonCursor cursor = {};
+        response = request->beginChunkedResponse("application/json",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+                return fillPlantDataJson(cursor, buffer, maxLen);
+            });
+    }
+    response->addHeader("ETag", etag);
+    response->addHeader("Vary", "Accept");
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+// server.on() with the handler timed for /metrics
+static void onTimed(const char* uri, WebRequestMethod method, ArRequestHandlerFunction handler) {
+    int route = metricsRoute(uri, method);
+    server.on(uri, method, [route, handler](AsyncWebServerRequest* request) {
+        int64_t start = esp_timer_get_time();
+        handler(request);
+        metricsRequest(route, esp_timer_get_time() - start);
+    });
+}
+
+// Prometheus text format, rendered family by family as the socket drains
+static void sendMetrics(AsyncWebServerRequest* request) {
+    MetricsCursor cursor = {};
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain; version=0.0.4",
+        [cursor](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            return fillMetrics(cursor, buffer, maxLen);
+        });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+// The flight recorder, binary; client/wmp_trace.cpp decodes it
+static void sendTrace(AsyncWebServerRequest* request) {
+    TraceCursor cursor;
+    traceCursorBegin(cursor);
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/octet-stream",
+        [cursor](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            return fillTrace(cursor, buffer, maxLen);
+        });
+    response->addHeader("Content-Disposition", "attachment; filename=\"trace.bin\"");
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+// GET /api/config/pumps: the zone table in effect, as /pumps.cfg text
+static void sendPumpConfig(AsyncWebServerRequest* request) {
+    PumpConfigCursor cursor = {};
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain",
+        [cursor](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            return fillPumpConfig(cursor, buffer, maxLen);
+        });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+// PUT /api/config/pumps streams its body to flash rather than a pool
+// buffer, one upload at a time; it is only put in place once it parses
+#define PUMP_CONFIG_UPLOAD PUMP_CONFIG_PATH ".new"
+#define PUMP_CONFIG_BODY_MAX 16384
+static AsyncWebServerRequest* configUploader = nullptr;
+static File configUpload;
+static size_t configUploaded = 0;
+
+static void endPumpConfigUpload() {
+    configUpload.close();
+    configUploader = nullptr;
+}
+
+static void receivePumpConfig(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+    if (total > PUMP_CONFIG_BODY_MAX) return;
+    if (index == 0) {
+        if (configUploader) return;
+        configUpload = SPIFFS.open(PUMP_CONFIG_UPLOAD, "w");
+        if (!configUpload) return;
+        configUploader = request;
+        configUploaded = 0;
+        request->onDisconnect([request]() {
+            if (configUploader == request) endPumpConfigUpload();
+        });
+    }
+    if (configUploader != request || index != configUploaded) return;
+    configUploaded += configUpload.write(data, len);
+}
+
+// Answers the upload once the body is in: 400 with the line at fault, or
+// 200 with what the table lists. It applies from the next restart.
+static void handlePumpConfigUpload(AsyncWebServerRequest* request) {
+    size_t total = request->contentLength();
+    if (total > PUMP_CONFIG_BODY_MAX) {
+        request->send(413, "application/json", "{\"error\":\"Request body too large\"}");
+        return;
+    }
+    if (configUploader && configUploader != request) {
+        AsyncWebServerResponse* response = request->beginResponse(503, "application/json", "{\"error\":\"Another upload is in progress\"}");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
+    }
+    if (!configUploader) {
+        request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
+        return;
+    }
+    endPumpConfigUpload();
+
+    char body[160];
+    if (configUploaded != total) {
+        SPIFFS.remove(PUMP_CONFIG_UPLOAD);
+        request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
+        return;
+    }
+    PumpConfigCheck check = checkPumpConfig(PUMP_CONFIG_UPLOAD);
+    if (check.error) {
+        SPIFFS.remove(PUMP_CONFIG_UPLOAD);
+        snprintf(body, sizeof(body), "{\"error\":\"%s\",\"line\":%d}", check.error, check.line);
+        request->send(400, "application/json", body);
+        return;
+    }
+    SPIFFS.remove(PUMP_CONFIG_PATH);
+    if (!SPIFFS.rename(PUMP_CONFIG_UPLOAD, PUMP_CONFIG_PATH)) {
+        request->send(500, "application/json", "{\"error\":\"Failed to save the table\"}");
+        return;
+    }
+    LOG_INFO("Saved a zone table of %d pumps; it applies after a restart", check.pumps);
+    snprintf(body, sizeof(body), "{\"pumps\":%d,\"expanders\":%d,\"status\":\"saved\",\"restartRequired\":true}",
+             check.pumps, check.expanders);
+    request->send(200, "application/json", body);
 }
 
 void setupWebServer() {
-    Serial.println("\n=== Setting up web server ===");
-    Serial.println("Registering routes:");
-    Serial.println(" - GET /");
-    Serial.println(" - GET /api/plants");
-    Serial.println(" - POST /api/plants/water-now");
-    Serial.println(" - PUT /api/plants/amount");
-    Serial.println(" - PUT /api/plants/interval");
-    Serial.println(" - PUT /api/plants/name");
+    if (!pendingEvents) {
+        pendingEvents = new std::atomic<bool>[numPumps];
+        for (int i = 0; i < numPumps; i++) pendingEvents[i] = false;
+    }
+
+    LOG_INFO("Setting up web server, routes:");
+    LOG_INFO(" - GET /");
+    LOG_INFO(" - GET /api/plants");
+    LOG_INFO(" - GET /api/plants.bin");
+    LOG_INFO(" - GET /api/plants/{i}/history");
+    LOG_INFO(" - GET /api/events");
+    LOG_INFO(" - POST /api/plants/water-now");
+    LOG_INFO(" - PUT /api/plants/amount");
+    LOG_INFO(" - PUT /api/plants/interval");
+    LOG_INFO(" - PUT /api/plants/name");
+    LOG_INFO(" - PUT /api/plants/batch");
+    LOG_INFO(" - GET /api/commands/{id}");
+    LOG_INFO(" - GET /metrics");
+    LOG_INFO(" - GET /api/trace");
+    LOG_INFO(" - GET /api/config/pumps");
+    LOG_INFO(" - PUT /api/config/pumps");
+
+    etagBootId = esp_random();
 
     if (!SPIFFS.begin(true)) {
-        Serial.println("An error occurred while mounting SPIFFS");
+        LOG_ERROR("An error occurred while mounting SPIFFS");
         return;
     }
 
@@ -57,45 +777,71 @@ void setupWebServer() {
     // Set CORS headers
     DefaultHeaders::Instance().addHeader("Access-Control-Allow-Origin", "*");
     DefaultHeaders::Instance().addHeader("Access-Control-Allow-Methods", "GET, POST, PUT, OPTIONS");
-    DefaultHeaders::Instance().addHeader("Access-Control-Allow-Headers", "Content-Type, Accept, Origin");
+    DefaultHeaders::Instance().addHeader("Access-Control-Allow-Headers", "Content-Type, Accept, Origin, If-None-Match");
+    DefaultHeaders::Instance().addHeader("Access-Control-Expose-Headers", "ETag, Location");
 
     // Handle CORS pre-flight requests
     server.on("/*", HTTP_OPTIONS, [](AsyncWebServerRequest *request) {
         request->send(200);
     });
 
-    // Serve homepage.html
+    // The page lives at a URL named after its content hash so browsers can
+    // cache it for good; "/" just points at the current build.
     server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
-        request->send(200, "text/html", HOMEPAGE_HTML);
+        request->redirect("/ui/" HOMEPAGE_HASH);
     });
 
-    // Get all plants data
-    server.on("/api/plants", HTTP_GET, [](AsyncWebServerRequest *request) {
-        AsyncResponseStream *response = request->beginResponseStream("application/json");
-        response->print(getPlantDataJson());
+    // Serve the gzipped homepage from flash; stale hashes get redirected
+    server.on("/ui", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->url() != "/ui/" HOMEPAGE_HASH) {
+            request->redirect("/ui/" HOMEPAGE_HASH);
+            return;
+        }
+        AsyncWebServerResponse* response = request->beginResponse_P(200, "text/html", HOMEPAGE_GZ, HOMEPAGE_GZ_LEN);
+        response->addHeader("Content-Encoding", "gzip");
+        response->addHeader("Cache-Control", "public, max-age=31536000, immutable");
         request->send(response);
     });
 
+    // Watering history of one plant, paged and optionally summed per day
+    // or week; registered first so /api/plants doesn't claim its URLs
+    onTimed("/api/plants/*", HTTP_GET, handleHistoryRequest);
+
+    // Get all plants data: JSON, or CBOR for machine clients that send
+    // "Accept: application/cbor" or fetch /api/plants.bin
+    onTimed("/api/plants", HTTP_GET, [](AsyncWebServerRequest *request) {
+        AsyncWebHeader* accept = request->getHeader("Accept");
+        sendPlantData(request, accept && strstr(accept->value().c_str(), "application/cbor"));
+    });
+    onTimed("/api/plants.bin", HTTP_GET, [](AsyncWebServerRequest *request) {
+        sendPlantData(request, true);
+    });
+
+    // Push plant changes to dashboards instead of having them poll
+    events.onConnect([](AsyncEventSourceClient *client) {
+        if (events.count() > MAX_EVENT_CLIENTS) {
+            client->close();
+            return;
+        }
+        // Tells the browser to retry after 5 s if the connection drops
+        client->send("{}", "hello", stateVersion.load(), 5000);
+    });
+    server.addHandler(&events);
+
     // Handle water now request
-    server.on(
-        "/api/plants/water-now", 
-        HTTP_POST,
-        [](AsyncWebServerRequest *request) {},
-        nullptr,
-        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
-            StaticJsonDocument<200> doc;
-            DeserializationError error = deserializeJson(doc, (char*)data);
-
-            if (error || !doc.containsKey("plantIndex")) {
+    onJsonBody("/api/plants/water-now", HTTP_POST, SETTING_BODY_MAX,
+        [](AsyncWebServerRequest *request, JsonDocument& doc) {
+            if (!doc.containsKey("plantIndex")) {
                 request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
                 return;
             }
 
             int plantIndex = doc["plantIndex"].as<int>();
-            if (plantIndex >= 0 && plantIndex < NUM_PUMPS) {
-                pumps[plantIndex].plant->needsWatering = true;
-                pumps[plantIndex].runDuration = (unsigned long)(pumps[plantIndex].plant->ozPerWatering * MILLIS_PER_OZ);
-                request->send(200, "application/json", "{\"success\":true}");
+            if (plantIndex >= 0 && plantIndex < numPumps) {
+                Command command = {};
+                command.type = COMMAND_WATER_NOW;
+                command.plant = plantIndex;
+                sendQueued(request, command);
             } else {
                 request->send(400, "application/json", "{\"error\":\"Invalid plant index\"}");
             }
@@ -103,16 +849,9 @@ void setupWebServer() {
     );
 
     // Handle amount update
-    server.on(
-        "/api/plants/amount",
-        HTTP_PUT,
-        [](AsyncWebServerRequest *request) {},
-        nullptr,
-        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
-            StaticJsonDocument<200> doc;
-            DeserializationError error = deserializeJson(doc, (char*)data);
-
-            if (error || !doc.containsKey("plantIndex") || !doc.containsKey("ozPerWatering")) {
+    onJsonBody("/api/plants/amount", HTTP_PUT, SETTING_BODY_MAX,
+        [](AsyncWebServerRequest *request, JsonDocument& doc) {
+            if (!doc.containsKey("plantIndex") || !doc.containsKey("ozPerWatering")) {
                 request->send(400, "application/json", "{\"error\":\"Missing required fields\"}");
                 return;
             }
@@ -120,7 +859,7 @@ void setupWebServer() {
             int plantIndex = doc["plantIndex"].as<int>();
             float amount = doc["ozPerWatering"].as<float>();
 
-            if (plantIndex < 0 || plantIndex >= NUM_PUMPS) {
+            if (plantIndex < 0 || plantIndex >= numPumps) {
                 request->send(400, "application/json", "{\"error\":\"Invalid plant index\"}");
                 return;
             }
@@ -130,23 +869,23 @@ void setupWebServer() {
                 return;
             }
 
-            plants[plantIndex].ozPerWatering = amount;
-            saveWateringTimes();
-            request->send(200, "application/json", "{\"success\":true}");
+            if (amount > MAX_OZ_PER_WATERING) {
+                request->send(400, "application/json", "{\"error\":\"Amount must be at most 100 oz\"}");
+                return;
+            }
+
+            Command command = {};
+            command.type = COMMAND_SET_AMOUNT;
+            command.plant = plantIndex;
+            command.amount = amount;
+            sendQueued(request, command);
         }
     );
 
     // Handle interval update
-    server.on(
-        "/api/plants/interval",
-        HTTP_PUT,
-        [](AsyncWebServerRequest *request) {},
-        nullptr,
-        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
-            StaticJsonDocument<200> doc;
-            DeserializationError error = deserializeJson(doc, (char*)data);
-
-            if (error || !doc.containsKey("plantIndex") || !doc.containsKey("intervalDays")) {
+    onJsonBody("/api/plants/interval", HTTP_PUT, SETTING_BODY_MAX,
+        [](AsyncWebServerRequest *request, JsonDocument& doc) {
+            if (!doc.containsKey("plantIndex") || !doc.containsKey("intervalDays")) {
                 request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
                 return;
             }
@@ -154,7 +893,7 @@ void setupWebServer() {
             int plantIndex = doc["plantIndex"].as<int>();
             float days = doc["intervalDays"].as<float>();
 
-            if (plantIndex < 0 || plantIndex >= NUM_PUMPS) {
+            if (plantIndex < 0 || plantIndex >= numPumps) {
                 request->send(400, "application/json", "{\"error\":\"Invalid plant index\"}");
                 return;
             }
@@ -164,23 +903,18 @@ void setupWebServer() {
                 return;
             }
 
-            plants[plantIndex].intervalMinutes = days * 24 * 60;
-            saveWateringTimes();
-            request->send(200, "application/json", "{\"success\":true}");
+            Command command = {};
+            command.type = COMMAND_SET_INTERVAL;
+            command.plant = plantIndex;
+            command.intervalMinutes = days * 24 * 60;
+            sendQueued(request, command);
         }
     );
 
     // Handle name update
-    server.on(
-        "/api/plants/name",
-        HTTP_PUT,
-        [](AsyncWebServerRequest *request) {},
-        nullptr,
-        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
-            StaticJsonDocument<200> doc;
-            DeserializationError error = deserializeJson(doc, (char*)data);
-
-            if (error || !doc.containsKey("plantIndex") || !doc.containsKey("name")) {
+    onJsonBody("/api/plants/name", HTTP_PUT, SETTING_BODY_MAX,
+        [](AsyncWebServerRequest *request, JsonDocument& doc) {
+            if (!doc.containsKey("plantIndex") || !doc.containsKey("name")) {
                 request->send(400, "application/json", "{\"error\":\"Invalid request body\"}");
                 return;
             }
@@ -188,18 +922,19 @@ void setupWebServer() {
             int plantIndex = doc["plantIndex"].as<int>();
             const char* newName = doc["name"].as<const char*>();
 
-            if (plantIndex < 0 || plantIndex >= NUM_PUMPS) {
+            if (plantIndex < 0 || plantIndex >= numPumps) {
                 request->send(400, "application/json", "{\"error\":\"Invalid plant index\"}");
                 return;
             }
 
             if (newName && strlen(newName) > 0) {
                 size_t nameLength = strlen(newName);
-                if (nameLength < sizeof(plants[plantIndex].name)) {
-                    strncpy(plants[plantIndex].name, newName, sizeof(plants[plantIndex].name) - 1);
-                    plants[plantIndex].name[sizeof(plants[plantIndex].name) - 1] = '\0';
-                    saveWateringTimes();
-                    request->send(200, "application/json", "{\"success\":true}");
+                Command command = {};
+                if (nameLength < sizeof(command.name)) {
+                    command.type = COMMAND_SET_NAME;
+                    command.plant = plantIndex;
+                    memcpy(command.name, newName, nameLength + 1);
+                    sendQueued(request, command);
                     return;
                 }
                 request->send(400, "application/json", "{\"error\":\"Name too long\"}");
@@ -209,6 +944,32 @@ void setupWebServer() {
         }
     );
 
+    // Several plants' settings at once, all or nothing
+    onJsonBody("/api/plants/batch", HTTP_PUT, BATCH_BODY_MAX, handleBatchRequest);
+
+    // Whether a queued change has been applied yet
+    onTimed("/api/commands/*", HTTP_GET, handleCommandStatusRequest);
+
+    // Counters and latencies for a Prometheus scraper
+    server.on("/metrics", HTTP_GET, sendMetrics);
+
+    // Recent pump, network, storage and command events, across soft resets
+    onTimed("/api/trace", HTTP_GET, sendTrace);
+
+    // The zone table, to read back or replace; see registry.cpp
+    onTimed("/api/config/pumps", HTTP_GET, sendPumpConfig);
+    int configRoute = metricsRoute("/api/config/pumps", HTTP_PUT);
+    server.on("/api/config/pumps", HTTP_PUT,
+        [configRoute](AsyncWebServerRequest* request) {
+            int64_t start = esp_timer_get_time();
+            handlePumpConfigUpload(request);
+            metricsRequest(configRoute, esp_timer_get_time() - start);
+        },
+        nullptr, receivePumpConfig);
+
+    // Body buffers, now that every route has said how big its bodies get
+    requestBodyBegin();
+
     server.begin();
-    Serial.println("Web server started");
+    LOG_INFO("Web server started");
 }
\ No newline at end of file